@@ -1,42 +1,15 @@
-QT       += core gui network
-
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
-
-CONFIG += c++11
-
-# You can make your code fail to compile if it uses deprecated APIs.
-# In order to do so, uncomment the following line.
-#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
-
-SOURCES += \
-    connectdialog.cpp \
-    main.cpp \
-    mainwindow.cpp \
-    scriptwidget.cpp \
-    sqlprocesshandler.cpp \
-    tabledata.cpp \
-    findtablewidget.cpp \
-    socketmanager.cpp
-
-HEADERS += \
-    connectdialog.h \
-    funcid.h \
-    mainwindow.h \
-    scriptwidget.h \
-    sqlprocesshandler.h \
-    tabledata.h \
-    findtablewidget.h \
-    socketmanager.h
-
-FORMS += \
-    connectdialog.ui \
-    mainwindow.ui \
-    scriptwidget.ui
-
-# Default rules for deployment.
-qnx: target.path = /tmp/$${TARGET}/bin
-else: unix:!android: target.path = /opt/$${TARGET}/bin
-!isEmpty(target.path): INSTALLS += target
-
-RESOURCES += \
-    pics.qrc
+TEMPLATE = subdirs
+
+# core: 协议层(SocketManager/SqlProcessHandler/TableData)，不依赖QtWidgets
+# app : 图形界面客户端
+# cli : 命令行客户端，无需显示服务器即可运行
+# netproxy: 网络损伤代理与基准测试工具
+SUBDIRS += \
+    core \
+    app \
+    cli \
+    netproxy
+
+app.depends = core
+cli.depends = core
+netproxy.depends = core
@@ -0,0 +1,106 @@
+#include "actionbuttondelegate.h"
+#include "resulttablemodel.h"
+#include <QApplication>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QStyle>
+
+namespace {
+
+// 按钮与单元格边缘的间距
+const int buttonMargin = 2;
+
+} // namespace
+
+ActionButtonDelegate::ActionButtonDelegate(const QString& text, QObject *parent)
+    : QStyledItemDelegate(parent), text(text)
+{
+}
+
+bool ActionButtonDelegate::isAction(const QModelIndex& index)
+{
+    return index.data(ResultTableModel::ActionRole).toBool();
+}
+
+QRect ActionButtonDelegate::buttonRect(const QStyleOptionViewItem& option) const
+{
+    return option.rect.adjusted(buttonMargin, buttonMargin, -buttonMargin, -buttonMargin);
+}
+
+void ActionButtonDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    if (!isAction(index)) {
+        QStyledItemDelegate::paint(painter, option, index);
+        return;
+    }
+
+    QStyleOptionButton button;
+    button.rect = buttonRect(option);
+    button.text = text;
+    button.fontMetrics = option.fontMetrics;
+    button.state = QStyle::State_Enabled;
+    if (index == pressedIndex) {
+        button.state |= QStyle::State_Sunken;
+    } else {
+        button.state |= QStyle::State_Raised;
+    }
+    if (option.state & QStyle::State_MouseOver) {
+        button.state |= QStyle::State_MouseOver;
+    }
+
+    const QWidget* widget = option.widget;
+    QStyle* style = widget ? widget->style() : QApplication::style();
+    style->drawControl(QStyle::CE_PushButton, &button, painter, widget);
+}
+
+QSize ActionButtonDelegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    if (!isAction(index)) {
+        return QStyledItemDelegate::sizeHint(option, index);
+    }
+    QStyleOptionButton button;
+    button.text = text;
+    button.fontMetrics = option.fontMetrics;
+    QSize textSize = option.fontMetrics.size(Qt::TextShowMnemonic, text);
+    const QWidget* widget = option.widget;
+    QStyle* style = widget ? widget->style() : QApplication::style();
+    return style->sizeFromContents(QStyle::CT_PushButton, &button, textSize, widget)
+            + QSize(2 * buttonMargin, 2 * buttonMargin);
+}
+
+bool ActionButtonDelegate::editorEvent(QEvent* event, QAbstractItemModel* model,
+                                       const QStyleOptionViewItem& option, const QModelIndex& index)
+{
+    if (!isAction(index)) {
+        // 在按钮上按下后拖到其他单元格松开，不算点击
+        if (event->type() == QEvent::MouseButtonRelease) {
+            pressedIndex = QPersistentModelIndex();
+        }
+        return QStyledItemDelegate::editorEvent(event, model, option, index);
+    }
+
+    switch (event->type()) {
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonDblClick: {
+        QMouseEvent* mouse = static_cast<QMouseEvent*>(event);
+        if (mouse->button() == Qt::LeftButton && buttonRect(option).contains(mouse->pos())) {
+            pressedIndex = index;
+            return true;
+        }
+        break;
+    }
+    case QEvent::MouseButtonRelease: {
+        // 与QPushButton一致：在同一个按钮上按下并松开才算点击
+        QMouseEvent* mouse = static_cast<QMouseEvent*>(event);
+        bool hit = index == pressedIndex && buttonRect(option).contains(mouse->pos());
+        pressedIndex = QPersistentModelIndex();
+        if (hit) {
+            emit clicked(index);
+        }
+        return true;
+    }
+    default:
+        break;
+    }
+    return false;
+}
@@ -0,0 +1,42 @@
+#ifndef ACTIONBUTTONDELEGATE_H
+#define ACTIONBUTTONDELEGATE_H
+
+#include <QStyledItemDelegate>
+#include <QPersistentModelIndex>
+
+/**
+ * @brief 操作列的按钮委托
+ * 不为每行创建QPushButton，而是在绘制可见单元格时画出按钮外观，按索引处理点击，
+ * 开销只与可见行数有关。模型的ResultTableModel::ActionRole为true的单元格按按钮绘制，
+ * 其他单元格按默认方式处理。
+ */
+class ActionButtonDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    ActionButtonDelegate(const QString& text, QObject *parent = nullptr);
+
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+
+signals:
+    /**
+     * @brief 点击了某行的按钮
+     * @param index 被点击的单元格(视图所用模型的索引)
+     */
+    void clicked(const QModelIndex& index);
+
+protected:
+    bool editorEvent(QEvent* event, QAbstractItemModel* model,
+                     const QStyleOptionViewItem& option, const QModelIndex& index) override;
+
+private:
+    QString text;
+    QPersistentModelIndex pressedIndex;     // 按下但尚未松开的按钮，绘制为按下状态
+
+    static bool isAction(const QModelIndex& index);
+    QRect buttonRect(const QStyleOptionViewItem& option) const;
+};
+
+#endif // ACTIONBUTTONDELEGATE_H
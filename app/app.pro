@@ -0,0 +1,66 @@
+QT       += core gui network sql
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+CONFIG += c++11
+TARGET = Remote_SQLite
+
+include(../core/core.pri)
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+SOURCES += \
+    connectdialog.cpp \
+    main.cpp \
+    mainwindow.cpp \
+    scriptwidget.cpp \
+    findtablewidget.cpp \
+    keepalivedialog.cpp \
+    resultviewsizer.cpp \
+    queryplandialog.cpp \
+    queryhistory.cpp \
+    queryhistorydialog.cpp \
+    sessionwidget.cpp \
+    snapshotdialog.cpp \
+    scriptfiledialog.cpp \
+    actionbuttondelegate.cpp \
+    tablestatsdialog.cpp \
+    globalsearchdialog.cpp \
+    scrollprefetcher.cpp \
+    recentconnections.cpp \
+    viewcache.cpp
+
+HEADERS += \
+    connectdialog.h \
+    mainwindow.h \
+    scriptwidget.h \
+    findtablewidget.h \
+    keepalivedialog.h \
+    resultviewsizer.h \
+    queryplandialog.h \
+    queryhistory.h \
+    queryhistorydialog.h \
+    sessionwidget.h \
+    snapshotdialog.h \
+    scriptfiledialog.h \
+    actionbuttondelegate.h \
+    tablestatsdialog.h \
+    globalsearchdialog.h \
+    scrollprefetcher.h \
+    recentconnections.h \
+    viewcache.h
+
+FORMS += \
+    connectdialog.ui \
+    mainwindow.ui \
+    scriptwidget.ui
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
+
+RESOURCES += \
+    pics.qrc
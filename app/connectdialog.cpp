@@ -18,6 +18,24 @@ void ConnectDialog::setupUI()
     mainLayout->setSpacing(30);  
     mainLayout->setContentsMargins(30, 40, 30, 40);  
     
+    // 最近连接，选择后填入下面的输入框
+    QHBoxLayout *recentLayout = new QHBoxLayout();
+    QLabel *recentLabel = new QLabel("最近连接:", this);
+    recentLabel->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
+    recentLabel->setMinimumWidth(80);
+    recentCombo = new QComboBox(this);
+    recentCombo->setMinimumHeight(40);
+    recentProfiles = RecentConnections::load();
+    for (const ConnectionProfile& profile : recentProfiles) {
+        recentCombo->addItem(RecentConnections::displayName(profile));
+        recentCombo->setItemData(recentCombo->count() - 1, profile.dbPath, Qt::ToolTipRole);
+    }
+    recentLayout->addWidget(recentLabel);
+    recentLayout->addWidget(recentCombo);
+    mainLayout->addLayout(recentLayout);
+    recentLabel->setVisible(!recentProfiles.isEmpty());
+    recentCombo->setVisible(!recentProfiles.isEmpty());
+    
     // IP地址输入组
     QHBoxLayout *ipLayout = new QHBoxLayout();
     QLabel *ipLabel = new QLabel("IP地址:", this);
@@ -89,6 +107,7 @@ void ConnectDialog::setupUI()
     
     // 设置标签字体
     QFont labelFont("Microsoft YaHei", 12);
+    recentLabel->setFont(labelFont);
     ipLabel->setFont(labelFont);
     portLabel->setFont(labelFont);
     dbLabel->setFont(labelFont);
@@ -102,9 +121,25 @@ void ConnectDialog::setupUI()
     // 连接信号和槽
     connect(connectButton, &QPushButton::clicked, this, &ConnectDialog::connBtnClicked);
     connect(cancelButton, &QPushButton::clicked, this, &ConnectDialog::cancelBtnClicked);
+    connect(recentCombo, static_cast<void(QComboBox::*)(int)>(&QComboBox::activated),
+            this, &ConnectDialog::onRecentSelected);
     
     // 在setupUI末尾添加验证器设置
     setupValidators();
+
+    // 默认填入最近一次的连接
+    onRecentSelected(0);
+}
+
+void ConnectDialog::onRecentSelected(int index)
+{
+    if (index < 0 || index >= recentProfiles.size()) {
+        return;
+    }
+    const ConnectionProfile& profile = recentProfiles[index];
+    ipLineEdit->setText(profile.ip);
+    portLineEdit->setText(QString::number(profile.port));
+    dbLineEdit->setText(profile.dbPath);
 }
 
 void ConnectDialog::setupValidators()
@@ -148,59 +183,32 @@ void ConnectDialog::connBtnClicked()
     connectButton->setEnabled(false);
     connectButton->setText("连接中...");
     
-    // 创建新的socket
-    QTcpSocket* socket = new QTcpSocket();
-    
-    // 连接到服务器
-    socket->connectToHost(ip, port);
-    
-    // 等待连接成功
-    if(socket->waitForConnected(3000)) {  // 3秒超时
-        // TCP连接成功，发送数据库连接请求
-        QJsonObject msgObj;
-        msgObj["dbpath"] = db;
-        
-        QJsonObject root;
-        root["funcid"] = "100000";
-        root["appid"] = 10086;
-        root["appkey"] = APPKEY;
-        root["msg"] = msgObj;
-        
-        QByteArray data = QJsonDocument(root).toJson();
-        socket->write(data);
-        
-        // 等待响应
-        if(socket->waitForReadyRead(3000)) {
-            QByteArray response = socket->readAll();
-            QJsonDocument doc = QJsonDocument::fromJson(response);
-            if(doc.isObject()) {
-                QJsonObject respObj = doc.object();
-                int status = respObj["status"].toInt();
-                QString msg = respObj["msg"].toString();
-                
-                if(status == 0) {
-                    // 数据库连接成功
-                    socket->setParent(nullptr);
-                    emit connectionEstablished(socket);
-                    accept();
-                    return;
-                } else {
-                    // 数据库连接失败
-                    QMessageBox::critical(this, "错误", "连接数据库失败：" + msg);
-                }
-            } else {
-                QMessageBox::critical(this, "错误", "服务器响应格式错误");
-            }
-        } else {
-            QMessageBox::critical(this, "错误", "等待服务器响应超时");
-        }
-        
-        // 如果到这里，说明数据库连接失败，关闭socket
-        socket->disconnectFromHost();
-        delete socket;
-    } else {
-        QMessageBox::critical(this, "错误", "连接服务器失败！");
-        delete socket;
+    // 建立连接并完成数据库握手
+    ConnectError error = ConnectError::None;
+    QString errorMsg;
+    QTcpSocket* socket = SocketManager::openConnection(ip, port, db, 3000, &error, &errorMsg);  // 3秒超时
+    if (socket) {
+        // 数据库连接成功
+        ConnectionProfile profile;
+        profile.ip = ip;
+        profile.port = static_cast<quint16>(port);
+        profile.dbPath = db;
+        RecentConnections::remember(profile);
+        emit connectionEstablished(socket, profile);
+        accept();
+        return;
+    }
+
+    switch (error) {
+        case ConnectError::HostUnreachable:
+            QMessageBox::critical(this, "错误", "连接服务器失败！");
+            break;
+        case ConnectError::DatabaseRejected:
+            QMessageBox::critical(this, "错误", "连接数据库失败：" + errorMsg);
+            break;
+        default:
+            QMessageBox::critical(this, "错误", errorMsg);
+            break;
     }
     
     connectButton->setEnabled(true);
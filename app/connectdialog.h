@@ -7,6 +7,7 @@
 #include <QLabel>
 #include <QLineEdit>
 #include <QPushButton>
+#include <QComboBox>
 #include <QRegularExpressionValidator>
 #include <QTcpSocket>
 #include <QMessageBox>
@@ -14,6 +15,8 @@
 #include <QJsonDocument>
 #include "socketmanager.h"
 #include "funcid.h"
+#include "connectionprofile.h"
+#include "recentconnections.h"
 
 class ConnectDialog : public QDialog
 {
@@ -25,14 +28,17 @@ public:
     QTcpSocket* getSocket() { return tcpSocket; }
 
 signals:
-    void connectionEstablished(QTcpSocket* socket);
+    void connectionEstablished(QTcpSocket* socket, const ConnectionProfile& profile);
 
 private slots:
     void connBtnClicked();
     void cancelBtnClicked();
     void handleSocketError(QAbstractSocket::SocketError error);
+    void onRecentSelected(int index);
 
 private:
+    QComboBox *recentCombo;
+    QVector<ConnectionProfile> recentProfiles;
     QLineEdit *ipLineEdit;
     QLineEdit *portLineEdit;
     QLineEdit *dbLineEdit;
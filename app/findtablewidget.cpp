@@ -0,0 +1,1072 @@
+#include "findtablewidget.h"
+#include "tablestatsdialog.h"
+#include "keepalivedialog.h"
+#include "indexadvisor.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QHash>
+#include <QSettings>
+#include <QInputDialog>
+#include <QItemSelectionModel>
+#include <QSignalBlocker>
+#include <QShowEvent>
+#include <algorithm>
+
+namespace {
+
+// 推送变更的合并窗口
+const int changeCoalesceMs = 100;
+// 切换表的防抖时间，键盘连续切换时只加载停下来的那张表
+const int selectDebounceMs = 150;
+// 表加载完成后空闲多久开始预取相邻表
+const int prefetchIdleMs = 300;
+// 一次合并的变更超过该数量时直接重新加载整表
+const int maxIncrementalChanges = 2000;
+// 批量操作每条语句的IN列表长度，避免单条语句过长
+const int bulkChunkSize = 500;
+// 连续ID达到该长度时改用BETWEEN区间
+const int bulkMinRange = 3;
+// 批量设置后逐行刷新的上限，超过时重新加载整表
+const int maxBulkRowRefresh = 50;
+
+// 规范的整数ID(无前导零、无空白)才能按数值区间合并
+bool integerId(const QString& id, qlonglong* value)
+{
+    bool ok = false;
+    *value = id.toLongLong(&ok);
+    return ok && QString::number(*value) == id;
+}
+
+// 单个ID的SQL写法：整数原样写入，其他(文本、UUID等)作为字符串字面量
+QString idLiteral(const QString& id)
+{
+    qlonglong value;
+    return integerId(id, &value) ? id : TableData::sqlLiteral(id);
+}
+
+} // namespace
+
+FindTableWidget::FindTableWidget(SqlProcessHandler* handler, SchemaCache* schema, QWidget *parent)
+    : QWidget(parent), sqlHandler(handler), schemaCache(schema), tableLoadId(0)
+{
+    tableModel = new ResultTableModel(this);
+    tableModel->setEditable(true);
+    tableModel->setActionColumnTitle("操作");  // 添加操作列
+    proxyModel = new ResultProxyModel(this);
+    proxyModel->setSourceModel(tableModel);
+    tablePrefetcher = new TablePrefetcher(sqlHandler, this);
+    tablePrefetcher->setByteBudget(QSettings().value("prefetch/budgetKB", 4096).toLongLong() * 1024);
+    rowCounter = new RowCountEstimator(sqlHandler, this);
+    rowCounter->setExactCountDelay(QSettings().value("rowcount/exactDelayMs", 1000).toInt());
+    rowCounter->setServerCancelEnabled(KeepAliveDialog::serverCancelEnabled());
+    setupUI();
+    initConnections();
+    loadTableList();
+}
+
+FindTableWidget::~FindTableWidget()
+{
+    if (!subscribedTable.isEmpty()) {
+        sqlHandler->unsubscribeTable(subscribedTable);
+    }
+}
+
+void FindTableWidget::releaseResults()
+{
+    // 数据不在模型中时推送的变更无处应用，重新加载后以新数据为准
+    if (tableLoadId != 0) {
+        sqlHandler->cancelRequest(tableLoadId);
+        pendingQueries.remove(tableLoadId);
+        tableLoadId = 0;
+    }
+    tableModel->clear();
+    loadedTable.clear();
+    previewTable.clear();
+    pendingChanges.clear();
+    changeTimer->stop();
+}
+
+void FindTableWidget::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+    if (!currentTable.isEmpty() && loadedTable != currentTable && tableLoadId == 0) {
+        onTableSelected(currentTable);
+    }
+}
+
+void FindTableWidget::setupUI()
+{
+    // 创建主垂直布局
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+    mainLayout->setSpacing(20);
+    mainLayout->setContentsMargins(20, 20, 20, 20);
+
+    // 创建下拉框
+    tableComboBox = new QComboBox(this);
+    tableComboBox->setMinimumSize(150, 50);
+    tableComboBox->setFont(QFont("Microsoft YaHei", 11));
+    
+    // 创建水平布局来居中显示下拉框
+    statsButton = new QPushButton("列统计", this);
+    statsButton->setToolTip("抽样估算当前表各列的空值比例、不同值、最小/最大值与高频值");
+    QHBoxLayout* comboLayout = new QHBoxLayout();
+    comboLayout->addStretch();
+    comboLayout->addWidget(tableComboBox);
+    comboLayout->addWidget(statsButton);
+    comboLayout->addStretch();
+    
+    mainLayout->addLayout(comboLayout);
+
+    // 创建结果筛选栏
+    QHBoxLayout* filterLayout = new QHBoxLayout();
+    filterEdit = new QLineEdit(this);
+    filterEdit->setPlaceholderText("筛选已加载的数据(不区分大小写的子串)...");
+    filterEdit->setClearButtonEnabled(true);
+    regexCheck = new QCheckBox("正则", this);
+    statusLabel = new QLabel(this);
+    deleteSelectedButton = new QPushButton("删除选中", this);
+    bulkUpdateButton = new QPushButton("批量设置", this);
+    bulkUpdateButton->setToolTip("将选中行(未选中时为筛选结果)的某一列设置为同一个值");
+    deleteSelectedButton->setEnabled(false);
+    filterLayout->addWidget(filterEdit);
+    filterLayout->addWidget(regexCheck);
+    filterLayout->addWidget(deleteSelectedButton);
+    filterLayout->addWidget(bulkUpdateButton);
+    filterLayout->addStretch();
+    filterLayout->addWidget(statusLabel);
+    mainLayout->addLayout(filterLayout);
+
+    // 输入停顿后再筛选
+    filterTimer = new QTimer(this);
+    filterTimer->setSingleShot(true);
+    filterTimer->setInterval(200);
+
+    changeTimer = new QTimer(this);
+    changeTimer->setSingleShot(true);
+    changeTimer->setInterval(changeCoalesceMs);
+
+    selectTimer = new QTimer(this);
+    selectTimer->setSingleShot(true);
+    selectTimer->setInterval(selectDebounceMs);
+
+    prefetchTimer = new QTimer(this);
+    prefetchTimer->setSingleShot(true);
+    prefetchTimer->setInterval(prefetchIdleMs);
+
+    // 创建表格视图
+    resultView = new QTableView(this);
+    resultView->setModel(proxyModel);
+    resultView->setMinimumWidth(800);
+    resultView->setHorizontalScrollMode(QAbstractItemView::ScrollPerPixel);  // 水平滚动
+    resultView->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);    // 垂直滚动
+    resultView->horizontalHeader()->setStretchLastSection(false);            // 不拉伸最后一列
+    resultView->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive); // 允许调整列宽
+    resultView->verticalHeader()->setSectionResizeMode(QHeaderView::Interactive);   // 允许调整行高
+    resultView->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);          // 需要时显示垂直滚动条
+    resultView->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);        // 需要时显示水平滚动条
+    resultView->setEditTriggers(QAbstractItemView::DoubleClicked | 
+                               QAbstractItemView::EditKeyPressed);
+    resultView->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
+    resultView->setSortingEnabled(true);                                     // 点击表头在客户端排序
+    resultView->setSelectionBehavior(QAbstractItemView::SelectRows);        // 按行选择
+    resultView->setSelectionMode(QAbstractItemView::ExtendedSelection);     // Ctrl/Shift多选
+    actionDelegate = new ActionButtonDelegate("删除", resultView);
+    resultView->setItemDelegate(actionDelegate);                            // 绘制操作列的删除按钮
+    resultView->setMouseTracking(true);                                     // 按钮的悬停效果
+    mainLayout->addWidget(resultView);
+    viewSizer = new ResultViewSizer(resultView, this);
+    scrollPrefetcher = new ScrollPrefetcher(resultView, proxyModel, this);
+
+    setWindowTitle("查找表");
+    setMinimumWidth(1000);
+}
+
+void FindTableWidget::initConnections()
+{
+    // 选择停顿后才加载
+    connect(tableComboBox, &QComboBox::currentTextChanged,
+            selectTimer, static_cast<void(QTimer::*)()>(&QTimer::start));
+    connect(selectTimer, &QTimer::timeout, this, [this]() {
+        if (tableComboBox->currentText() != currentTable) {
+            onTableSelected(tableComboBox->currentText());
+        }
+    });
+    connect(sqlHandler, &SqlProcessHandler::responseReceived,
+            this, &FindTableWidget::onResponseReceived);
+    connect(tableModel, &ResultTableModel::cellEdited,
+            this, &FindTableWidget::onCellEdited);
+    // 操作列由委托绘制，点击时按索引找到对应行
+    connect(actionDelegate, &ActionButtonDelegate::clicked,
+            this, &FindTableWidget::onDeleteButtonClicked);
+    connect(proxyModel, &ResultProxyModel::mappingApplied,
+            this, &FindTableWidget::onMappingApplied);
+    connect(filterEdit, &QLineEdit::textChanged, filterTimer, static_cast<void(QTimer::*)()>(&QTimer::start));
+    connect(regexCheck, &QCheckBox::toggled, this, &FindTableWidget::onFilterChanged);
+    connect(filterTimer, &QTimer::timeout, this, &FindTableWidget::onFilterChanged);
+    // 其他客户端的写入由服务端推送，合并后增量应用
+    connect(sqlHandler, &SqlProcessHandler::changeNotified,
+            this, &FindTableWidget::onChangeNotified);
+    connect(changeTimer, &QTimer::timeout, this, &FindTableWidget::applyPendingChanges);
+    connect(resultView->selectionModel(), &QItemSelectionModel::selectionChanged,
+            this, &FindTableWidget::updateBulkButtons);
+    connect(proxyModel, &QAbstractItemModel::modelReset,
+            this, &FindTableWidget::updateBulkButtons);
+    connect(deleteSelectedButton, &QPushButton::clicked,
+            this, &FindTableWidget::onDeleteSelectedClicked);
+    connect(bulkUpdateButton, &QPushButton::clicked,
+            this, &FindTableWidget::onBulkUpdateClicked);
+    connect(statsButton, &QPushButton::clicked, this, &FindTableWidget::onStatsClicked);
+    connect(prefetchTimer, &QTimer::timeout, this, &FindTableWidget::prefetchAdjacentTables);
+    // 正在打开的表的预取先于完整数据到达时，先显示首屏
+    connect(tablePrefetcher, &TablePrefetcher::pageReady, this, [this](const QString& table) {
+        if (table == currentTable && tableLoadId != 0 && loadedTable != currentTable) {
+            showPrefetchedPage(table);
+        }
+    });
+    connect(rowCounter, &RowCountEstimator::estimated, this, &FindTableWidget::onRowCountEstimated);
+    // 视图切走后仍然保留，执行DDL后结构缓存重新加载时同步表列表
+    if (schemaCache) {
+        connect(schemaCache, &SchemaCache::schemaLoaded, this, &FindTableWidget::loadTableList);
+    }
+}
+
+void FindTableWidget::loadTableList()
+{
+    // 会话的结构缓存已加载(启动时预连接的会话在窗口显示期间就已加载)时直接取用，省去一次往返
+    if (schemaCache && schemaCache->isLoaded()) {
+        QStringList names;
+        for (const QString& key : schemaCache->tableNames()) {
+            TableSchema schema = schemaCache->table(key);
+            if (!schema.isView && !schema.name.isEmpty()) {
+                names << schema.name;
+            }
+        }
+        setTableList(names);
+        return;
+    }
+
+    // 获取表列表
+    PendingQuery query;
+    query.type = QueryType::TableList;
+    pendingQueries[sqlHandler->execSql("SELECT name FROM sqlite_master WHERE type='table';")] = query;
+}
+
+void FindTableWidget::setTableList(const QStringList& names)
+{
+    // 重新填充时保持当前表不变，当前表已不存在时才按新的当前项加载
+    const QString previous = tableComboBox->currentText();
+    {
+        QSignalBlocker blocker(tableComboBox);
+        tableComboBox->clear();
+        tableComboBox->addItems(names);
+        tableComboBox->setCurrentIndex(qMax(0, tableComboBox->findText(previous)));
+    }
+    if (tableComboBox->currentText() != currentTable) {
+        selectTimer->start();
+    }
+}
+
+void FindTableWidget::onResponseReceived(quint64 requestId, const QByteArray& data)
+{
+    // 只处理本窗口发出的请求，并按请求ID找回查询类型
+    if (!pendingQueries.contains(requestId)) {
+        return;
+    }
+    PendingQuery query = pendingQueries.take(requestId);
+    if (requestId == tableLoadId) {
+        tableLoadId = 0;
+    }
+
+    bool ok = false;
+    QJsonObject jsonObj;
+    ResultStore store;
+    if (query.type == QueryType::TableData) {
+        // 整表数据可能很大，流式解码，超出内存预算的行溢出到磁盘
+        store = ResultStore::fromResponse(data, &jsonObj, &ok);
+    } else {
+        jsonObj = TableData::parseResponse(data, &ok);
+    }
+    if (query.type == QueryType::Subscribe) {
+        // 服务端不支持或拒绝订阅时不会推送变更，不再按已订阅处理
+        if ((!ok || jsonObj["status"].toInt() != 0) && query.table == subscribedTable) {
+            subscribedTable.clear();
+            pendingChanges.clear();
+        }
+        return;
+    }
+    if (!ok) {
+        QMessageBox::warning(this, "错误", "返回数据格式错误\n" + QString::fromUtf8(data));
+        return;
+    }
+
+    TableData tableData;
+    
+    tableData.setStatus(jsonObj["status"].toInt());
+    tableData.setMsg(jsonObj["msg"].toString());
+
+    // 切换表之后才到达的结果与当前模型无关
+    bool staleTable = query.type != QueryType::TableList && query.table != currentTable;
+
+    if (tableData.getStatus() != 0) {
+        if (query.type == QueryType::TableData) {
+            tableModel->setEditable(true);
+        }
+        if (query.type == QueryType::UpdateData) {
+            QMessageBox::warning(this, "更新失败", tableData.getMsg());
+            // 只回滚被编辑的单元格，不重新加载整表
+            int row = findRowById(query.id);
+            if (!staleTable && row >= 0) {
+                tableModel->setValue(row, query.column, query.oldValue);
+            }
+        } else if (query.type == QueryType::DeleteData) {
+            QMessageBox::warning(this, "删除失败", tableData.getMsg());
+        } else if (query.type == QueryType::BulkUpdate || query.type == QueryType::BulkDelete) {
+            // 出错的语句之后服务端不再执行，COMMIT未执行，事务仍然打开
+            sqlHandler->execSql("ROLLBACK;");
+            QMessageBox::warning(this, query.type == QueryType::BulkDelete ? "批量删除失败" : "批量设置失败",
+                                 tableData.getMsg() + "\n已回滚，数据未修改");
+        } else if (query.type != QueryType::RowRefresh) {
+            QMessageBox::warning(this, "错误", tableData.getMsg());
+        }
+        return;
+    }
+    if (staleTable) {
+        return;
+    }
+
+    // 根据查询类型处理不同的返回数据
+    switch (query.type) {
+        case QueryType::TableList:
+            // 处理表列表数据
+            {
+                QJsonArray rows = jsonObj["rows"].toArray();
+                QStringList names;
+                for (const auto& row : rows) {
+                    QJsonObject rowObj = row.toObject();
+                    QString tableName = rowObj["name"].toString();
+                    if (!tableName.isEmpty()) {
+                        names << tableName;
+                    }
+                }
+                setTableList(names);
+            }
+            break;
+
+        case QueryType::TableData:
+            // 处理表数据
+            {
+                // 获取列信息
+                QJsonObject columns = jsonObj["columns"].toObject();
+                if (columns.isEmpty()) {
+                    QMessageBox::warning(this, "错误", "未找到列信息");
+                    return;
+                }
+
+                // 交给模型，操作列的删除按钮由委托绘制；替换掉可能正在显示的预取首屏
+                tableModel->setStore(store);
+                tableModel->setEditable(true);
+                loadedTable = currentTable;
+                previewTable.clear();
+                rowCounter->setExactCount(currentTable, store.rowCount());
+                tablePrefetcher->invalidate(currentTable);
+                prefetchTimer->start();
+
+                // 加载期间到达的推送变更在整表数据之上补上
+                if (!pendingChanges.isEmpty()) {
+                    changeTimer->start();
+                }
+
+                // 按表头和抽样行估算列宽，可见行滚动到时再修正
+                viewSizer->fitToContents();
+            }
+            break;
+
+        case QueryType::UpdateData:
+            // 新值已在本地生效；触发器或类型亲和性可能改写服务端的值时，只重新读取这一行
+            if (needsRowRefresh(query.column)) {
+                refreshRow(query.id);
+            }
+            break;
+
+        case QueryType::DeleteData:
+            // 原地移除该行，保留滚动位置与选中状态
+            {
+                int row = findRowById(query.id);
+                if (row >= 0) {
+                    tableModel->removeStoreRow(row);
+                }
+            }
+            break;
+
+        case QueryType::RowRefresh:
+            applyRowRefresh(query.id, jsonObj);
+            break;
+
+        case QueryType::BulkUpdate:
+            applyBulkUpdate(query);
+            break;
+
+        case QueryType::BulkDelete:
+            applyBulkDelete(query.ids);
+            break;
+
+        case QueryType::Subscribe:
+            break;      // 已在上面处理
+    }
+}
+
+void FindTableWidget::onChangeNotified(const QString& table, const QJsonArray& events)
+{
+    if (table != subscribedTable) {
+        return;
+    }
+    rowCounter->invalidate(table);
+    // 数据已释放且没有在途的加载时不积累变更，再次显示时整表重新加载
+    if (loadedTable != currentTable && tableLoadId == 0) {
+        return;
+    }
+    for (const auto& event : events) {
+        pendingChanges << event.toObject();
+    }
+    // 定时器运行中不重新计时，持续高频写入时也能按固定间隔刷新
+    if (!changeTimer->isActive()) {
+        changeTimer->start();
+    }
+}
+
+void FindTableWidget::applyPendingChanges()
+{
+    // 整表数据尚未加载完成，加载后再应用
+    if (pendingChanges.isEmpty() || loadedTable != currentTable) {
+        return;
+    }
+
+    QVector<QJsonObject> events;
+    events.swap(pendingChanges);
+    if (events.size() > maxIncrementalChanges) {
+        onTableSelected(currentTable);
+        return;
+    }
+
+    // 没有ID列时无法定位变更的行，直接重新加载
+    int keyColumn = idColumn();
+    if (keyColumn < 0) {
+        onTableSelected(currentTable);
+        return;
+    }
+    const QStringList names = tableModel->store().columnNames();
+
+    // 同一行的多次变更只保留最后一次，事件中带有变更后的整行
+    QHash<QString, QJsonObject> latest;
+    QStringList order;
+    for (const QJsonObject& event : events) {
+        QJsonObject row = event["row"].toObject();
+        QString key = row.contains(names[keyColumn]) ? TableData::cellText(row[names[keyColumn]]) : TableData::cellText(event["rowid"]);
+        if (key.isEmpty()) {
+            continue;
+        }
+        if (!latest.contains(key)) {
+            order << key;
+        }
+        latest[key] = event;
+    }
+
+    QVector<int> removedRows;
+    QVector<QStringList> insertedRows;
+    for (const QString& key : order) {
+        const QJsonObject& event = latest[key];
+        const QJsonObject values = event["row"].toObject();
+        int row = tableModel->findRow(keyColumn, key);
+
+        if (event["op"].toString() == "delete") {
+            if (row >= 0) {
+                removedRows << row;
+            }
+        } else if (row >= 0) {
+            // 只写回有差异的单元格
+            for (int column = 0; column < names.size(); ++column) {
+                if (values.contains(names[column])) {
+                    QString value = TableData::cellText(values[names[column]]);
+                    if (value != tableModel->value(row, column)) {
+                        tableModel->setValue(row, column, value);
+                    }
+                }
+            }
+        } else {
+            QStringList rowValues;
+            for (const QString& name : names) {
+                rowValues << (name == names[keyColumn] && !values.contains(name) ? key : TableData::cellText(values[name]));
+            }
+            insertedRows << rowValues;
+        }
+    }
+
+    tableModel->removeStoreRows(removedRows);
+    tableModel->appendStoreRows(insertedRows);
+}
+
+int FindTableWidget::idColumn() const
+{
+    const QStringList& headers = tableModel->store().columnNames();
+    for (int i = 0; i < headers.size(); ++i) {
+        if (headers[i].toLower() == "id") {  // 不区分大小写查找ID列
+            return i;
+        }
+    }
+    return -1;
+}
+
+int FindTableWidget::findRowById(const QString& id) const
+{
+    // 模型按ID列维护索引，不必每次扫描整个结果集
+    int column = idColumn();
+    if (column < 0 || id.isEmpty()) {
+        return -1;
+    }
+    return tableModel->findRow(column, id);
+}
+
+bool FindTableWidget::needsRowRefresh(int column) const
+{
+    // 没有结构信息时保守处理
+    if (!schemaCache || !schemaCache->isLoaded() || !schemaCache->hasTable(currentTable)) {
+        return true;
+    }
+    TableSchema schema = schemaCache->table(currentTable);
+    if (!schema.triggers.isEmpty()) {
+        return true;
+    }
+    int schemaColumn = schema.columnIndex(tableModel->store().columnNames().value(column));
+    return schemaColumn < 0 || !schema.isTextColumn(schemaColumn);
+}
+
+void FindTableWidget::refreshRow(const QString& id)
+{
+    PendingQuery query;
+    query.type = QueryType::RowRefresh;
+    query.table = currentTable;
+    query.id = id;
+    pendingQueries[sqlHandler->execSql(QString("SELECT * FROM %1 WHERE id = %2;")
+                                       .arg(IndexAdvisor::quoteIdentifier(currentTable), idLiteral(id)))] = query;
+}
+
+void FindTableWidget::applyRowRefresh(const QString& id, const QJsonObject& jsonObj)
+{
+    int row = findRowById(id);
+    if (row < 0) {
+        return;
+    }
+
+    ResultStore fresh = ResultStore::fromJsonObject(jsonObj);
+    if (fresh.rowCount() == 0) {
+        // 服务端已不存在该行(如被触发器删除)
+        tableModel->removeStoreRow(row);
+        return;
+    }
+
+    // 只写回有差异的单元格，未变化的单元格不发出dataChanged
+    const QStringList& names = tableModel->store().columnNames();
+    for (int column = 0; column < names.size(); ++column) {
+        int freshColumn = fresh.columnIndex(names[column]);
+        if (freshColumn < 0) {
+            continue;
+        }
+        QString value = fresh.value(0, freshColumn);
+        if (value != tableModel->value(row, column)) {
+            tableModel->setValue(row, column, value);
+        }
+    }
+}
+
+void FindTableWidget::onTableSelected(const QString& tableName)
+{
+    if (tableName.isEmpty()) {
+        return;
+    }
+
+    currentTable = tableName;  // 保存当前表名
+
+    // 先订阅再查询：服务端按顺序处理，查询结果之后的写入都会推送过来。
+    // 只在设置中声明服务端支持时订阅，应答失败时撤销
+    if (subscribedTable != tableName) {
+        if (!subscribedTable.isEmpty()) {
+            sqlHandler->unsubscribeTable(subscribedTable);
+            subscribedTable.clear();
+        }
+        pendingChanges.clear();
+        if (KeepAliveDialog::liveUpdatesEnabled()) {
+            PendingQuery subscribe;
+            subscribe.type = QueryType::Subscribe;
+            subscribe.table = tableName;
+            pendingQueries[sqlHandler->subscribeTable(tableName)] = subscribe;
+            subscribedTable = tableName;
+        }
+    }
+
+    // 被取代的整表加载不再需要，放弃其应答(服务端支持时中断执行)
+    if (tableLoadId != 0) {
+        sqlHandler->cancelRequest(tableLoadId);
+        pendingQueries.remove(tableLoadId);
+    }
+
+    // 与这张表无关的预取不再需要；已预取过首屏时先显示，完整数据到达后替换
+    prefetchTimer->stop();
+    tablePrefetcher->cancelExcept(tableName);
+    if (tableName != loadedTable) {
+        showPrefetchedPage(tableName);
+        // 先给出估算的总行数，后台精确计数完成后再修正
+        rowCounter->estimate(tableName);
+    }
+
+    // 构造查询整表的SQL语句
+    QString querySQL = QString("SELECT * FROM %1;").arg(tableName);
+    
+    // 发送查询命令
+    PendingQuery query;
+    query.type = QueryType::TableData;
+    query.table = tableName;
+    tableLoadId = sqlHandler->execSql(querySQL);
+    pendingQueries[tableLoadId] = query;
+}
+
+void FindTableWidget::showPrefetchedPage(const QString& tableName)
+{
+    ResultStore page;
+    if (!tablePrefetcher->cachedPage(tableName, &page)) {
+        return;
+    }
+    // 首屏只读，也不显示删除按钮：完整数据在其后发出，编辑会被完整数据覆盖
+    tableModel->setEditable(false);
+    tableModel->setStore(page);
+    previewTable = tableName;
+    if (rowEstimate.table == tableName) {
+        tableModel->setEstimatedRowCount(rowEstimate.rows);
+    }
+    viewSizer->fitToContents();
+    showLoadingStatus();
+}
+
+void FindTableWidget::onRowCountEstimated(const RowCountEstimate& estimate)
+{
+    // 完整数据已经到达时行数是准确的，不再需要估算
+    if (estimate.table != currentTable || loadedTable == currentTable) {
+        return;
+    }
+    rowEstimate = estimate;
+    if (previewTable == currentTable) {
+        tableModel->setEstimatedRowCount(estimate.rows);
+    }
+    showLoadingStatus();
+}
+
+void FindTableWidget::showLoadingStatus()
+{
+    QStringList parts;
+    if (previewTable == currentTable) {
+        parts << QString("预览前 %1 行").arg(tableModel->store().rowCount());
+    }
+    if (rowEstimate.table == currentTable && rowEstimate.rows >= 0) {
+        parts << (rowEstimate.exact ? QString("共 %1 行").arg(rowEstimate.rows)
+                                    : QString("约 %1 行(%2)").arg(rowEstimate.rows).arg(rowEstimate.source));
+    }
+    parts << "正在加载完整数据...";
+    statusLabel->setText(parts.join("，"));
+}
+
+void FindTableWidget::prefetchAdjacentTables()
+{
+    // 界面空闲时预取下拉框中前后相邻的表，键盘上下切换时最可能打开
+    int index = tableComboBox->findText(currentTable);
+    if (index < 0 || tableLoadId != 0) {
+        return;
+    }
+    QStringList tables;
+    for (int offset : {1, -1, 2}) {
+        QString name = tableComboBox->itemText(index + offset);
+        if (index + offset >= 0 && !name.isEmpty()) {
+            tables << name;
+        }
+    }
+    tablePrefetcher->prefetch(tables);
+}
+
+void FindTableWidget::onCellEdited(int row, int column, const QString& oldValue, const QString& newValue)
+{
+    if (currentTable.isEmpty()) {
+        return;
+    }
+
+    // 生成更新SQL语句
+    QString updateSql = generateUpdateSql(row, column, newValue);
+    if (updateSql.isEmpty()) {
+        return;
+    }
+
+    // 发送更新命令，记下行ID与旧值，失败时只回滚这个单元格
+    PendingQuery query;
+    query.type = QueryType::UpdateData;
+    query.table = currentTable;
+    query.id = tableModel->value(row, idColumn());
+    query.column = column;
+    query.oldValue = oldValue;
+    pendingQueries[sqlHandler->execSql(updateSql)] = query;
+}
+
+QString FindTableWidget::generateUpdateSql(int row, int column, const QString& newValue)
+{
+    // 获取表头（列名）
+    const QStringList& headers = tableModel->store().columnNames();
+
+    // 找到ID列的索引
+    int idColumnIndex = idColumn();
+
+    // 如果没有找到ID列，返回空
+    if (idColumnIndex == -1) {
+        QMessageBox::warning(this, "错误", "未找到ID列，无法更新数据");
+        return QString();
+    }
+
+    // 获取ID列的值
+    QString idValue = tableModel->value(row, idColumnIndex);
+    if (idValue.isEmpty()) {
+        QMessageBox::warning(this, "错误", "ID值为空，无法更新数据");
+        return QString();
+    }
+
+    // 构造UPDATE语句，文本ID(如UUID)与含引号的值都按字面量转义
+    QString updateSql = QString("UPDATE %1 SET %2 = %3 WHERE id = %4;")
+                           .arg(IndexAdvisor::quoteIdentifier(currentTable),
+                                IndexAdvisor::quoteIdentifier(headers[column]),
+                                TableData::sqlLiteral(newValue),
+                                idLiteral(idValue));
+
+    return updateSql;
+}
+
+void FindTableWidget::onFilterChanged()
+{
+    // 新的输入会取消尚未完成的筛选
+    proxyModel->setFilter(filterEdit->text(), regexCheck->isChecked());
+}
+
+void FindTableWidget::onMappingApplied(int visibleRows, qint64 elapsedMs)
+{
+    statusLabel->setText(QString("%1 / %2 行  (%3 ms)")
+                         .arg(visibleRows)
+                         .arg(tableModel->rowCount())
+                         .arg(elapsedMs));
+}
+
+void FindTableWidget::onDeleteButtonClicked(const QModelIndex& index)
+{
+    // 预览首屏会被随后到达的完整数据覆盖，不在其上删除
+    if (previewTable == currentTable) {
+        return;
+    }
+    int keyColumn = idColumn();
+    int row = proxyModel->mapToSource(index).row();
+    QString id = keyColumn < 0 || row < 0 ? QString() : tableModel->value(row, keyColumn);
+    if (id.isEmpty()) {
+        QMessageBox::warning(this, "错误", "未找到该行的ID，无法删除数据");
+        return;
+    }
+    
+    // 确认删除
+    QMessageBox::StandardButton reply = QMessageBox::question(
+        this, 
+        "确认删除", 
+        "确定要删除这条记录吗？",
+        QMessageBox::Yes | QMessageBox::No
+    );
+
+    // 确认期间推送的变更可能移动或删除了该行，按ID重新定位
+    row = findRowById(id);
+    if (reply != QMessageBox::Yes || row < 0) {
+        return;
+    }
+
+    // 生成删除SQL语句
+    QString deleteSql = generateDeleteSql(row);
+    if (deleteSql.isEmpty()) {
+        return;
+    }
+
+    // 发送删除命令
+    PendingQuery query;
+    query.type = QueryType::DeleteData;
+    query.table = currentTable;
+    query.id = id;
+    pendingQueries[sqlHandler->execSql(deleteSql)] = query;
+}
+
+QString FindTableWidget::generateDeleteSql(int row)
+{
+    // 找到ID列的索引
+    int idColumnIndex = idColumn();
+
+    // 如果没有找到ID列，返回空
+    if (idColumnIndex == -1) {
+        QMessageBox::warning(this, "错误", "未找到ID列，无法删除数据");
+        return QString();
+    }
+
+    // 获取ID列的值
+    QString idValue = tableModel->value(row, idColumnIndex);
+    if (idValue.isEmpty()) {
+        QMessageBox::warning(this, "错误", "ID值为空，无法删除数据");
+        return QString();
+    }
+
+    // 构造DELETE语句
+    return QString("DELETE FROM %1 WHERE id = %2;")
+        .arg(IndexAdvisor::quoteIdentifier(currentTable), idLiteral(idValue));
+}
+
+void FindTableWidget::onStatsClicked()
+{
+    if (currentTable.isEmpty()) {
+        return;
+    }
+    TableStatsDialog* dialog = new TableStatsDialog(sqlHandler, schemaCache, currentTable, this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    dialog->show();
+}
+
+void FindTableWidget::updateBulkButtons()
+{
+    deleteSelectedButton->setEnabled(resultView->selectionModel()->hasSelection());
+}
+
+QStringList FindTableWidget::selectedIds() const
+{
+    QStringList ids;
+    int column = idColumn();
+    if (column < 0) {
+        return ids;
+    }
+    for (const QModelIndex& index : resultView->selectionModel()->selectedRows()) {
+        int sourceRow = proxyModel->mapToSource(index).row();
+        QString id = tableModel->value(sourceRow, column);
+        if (!id.isEmpty()) {
+            ids << id;
+        }
+    }
+    return ids;
+}
+
+QStringList FindTableWidget::filteredIds() const
+{
+    QStringList ids;
+    int column = idColumn();
+    if (column < 0) {
+        return ids;
+    }
+    for (int row = 0; row < proxyModel->rowCount(); ++row) {
+        int sourceRow = proxyModel->mapToSource(proxyModel->index(row, 0)).row();
+        QString id = tableModel->value(sourceRow, column);
+        if (!id.isEmpty()) {
+            ids << id;
+        }
+    }
+    return ids;
+}
+
+QString FindTableWidget::bulkSql(const QString& statement, const QStringList& ids) const
+{
+    // 整数ID排序后，连续的一段用BETWEEN，其余按块放进IN列表
+    QVector<qlonglong> numbers;
+    QStringList others;
+    for (const QString& id : ids) {
+        qlonglong value;
+        if (integerId(id, &value)) {
+            numbers << value;
+        } else {
+            others << TableData::sqlLiteral(id);
+        }
+    }
+    std::sort(numbers.begin(), numbers.end());
+    numbers.erase(std::unique(numbers.begin(), numbers.end()), numbers.end());
+
+    QStringList predicates;
+    QStringList inList;
+    auto flushInList = [&]() {
+        if (!inList.isEmpty()) {
+            predicates << QString("id IN (%1)").arg(inList.join(','));
+            inList.clear();
+        }
+    };
+    for (int i = 0; i < numbers.size(); ) {
+        int end = i;
+        while (end + 1 < numbers.size() && numbers[end + 1] == numbers[end] + 1) {
+            ++end;
+        }
+        if (end - i + 1 >= bulkMinRange) {
+            predicates << QString("id BETWEEN %1 AND %2").arg(numbers[i]).arg(numbers[end]);
+        } else {
+            for (int k = i; k <= end; ++k) {
+                inList << QString::number(numbers[k]);
+                if (inList.size() >= bulkChunkSize) {
+                    flushInList();
+                }
+            }
+        }
+        i = end + 1;
+    }
+    flushInList();
+    for (const QString& literal : others) {
+        inList << literal;
+        if (inList.size() >= bulkChunkSize) {
+            flushInList();
+        }
+    }
+    flushInList();
+
+    // 所有语句放在一个事务里一次发送，要么全部生效要么全部回滚
+    QString sql = "BEGIN;\n";
+    for (const QString& predicate : predicates) {
+        sql += QString("%1 WHERE %2;\n").arg(statement, predicate);
+    }
+    sql += "COMMIT;";
+    return sql;
+}
+
+void FindTableWidget::onDeleteSelectedClicked()
+{
+    if (currentTable.isEmpty()) {
+        return;
+    }
+    if (idColumn() < 0) {
+        QMessageBox::warning(this, "错误", "未找到ID列，无法删除数据");
+        return;
+    }
+    QStringList ids = selectedIds();
+    if (ids.isEmpty()) {
+        return;
+    }
+
+    QMessageBox::StandardButton reply = QMessageBox::question(
+        this,
+        "确认删除",
+        QString("确定要删除选中的 %1 条记录吗？").arg(ids.size()),
+        QMessageBox::Yes | QMessageBox::No
+    );
+    if (reply != QMessageBox::Yes) {
+        return;
+    }
+
+    PendingQuery query;
+    query.type = QueryType::BulkDelete;
+    query.table = currentTable;
+    query.ids = ids;
+    pendingQueries[sqlHandler->execSql(bulkSql(QString("DELETE FROM %1").arg(IndexAdvisor::quoteIdentifier(currentTable)), ids))] = query;
+}
+
+void FindTableWidget::onBulkUpdateClicked()
+{
+    if (currentTable.isEmpty() || tableModel->rowCount() == 0) {
+        return;
+    }
+    int keyColumn = idColumn();
+    if (keyColumn < 0) {
+        QMessageBox::warning(this, "错误", "未找到ID列，无法更新数据");
+        return;
+    }
+
+    // 有选中行时作用于选中行，否则作用于当前筛选结果
+    bool useSelection = resultView->selectionModel()->hasSelection();
+    QStringList ids = useSelection ? selectedIds() : filteredIds();
+    if (ids.isEmpty()) {
+        return;
+    }
+
+    QStringList columns;
+    const QStringList& names = tableModel->store().columnNames();
+    for (int column = 0; column < names.size(); ++column) {
+        if (column != keyColumn) {
+            columns << names[column];
+        }
+    }
+    if (columns.isEmpty()) {
+        return;
+    }
+
+    bool ok = false;
+    QString columnName = QInputDialog::getItem(this, "批量设置", "列:", columns, 0, false, &ok);
+    if (!ok) {
+        return;
+    }
+    QString value = QInputDialog::getText(this, "批量设置", QString("%1 的新值:").arg(columnName),
+                                          QLineEdit::Normal, QString(), &ok);
+    if (!ok) {
+        return;
+    }
+
+    QMessageBox::StandardButton reply = QMessageBox::question(
+        this,
+        "确认修改",
+        QString("确定要将%1的 %2 条记录的 %3 设置为 '%4' 吗？")
+            .arg(useSelection ? "选中" : "筛选结果中")
+            .arg(ids.size())
+            .arg(columnName)
+            .arg(value),
+        QMessageBox::Yes | QMessageBox::No
+    );
+    if (reply != QMessageBox::Yes) {
+        return;
+    }
+
+    PendingQuery query;
+    query.type = QueryType::BulkUpdate;
+    query.table = currentTable;
+    query.ids = ids;
+    query.column = names.indexOf(columnName);
+    query.newValue = value;
+    QString statement = QString("UPDATE %1 SET %2 = %3").arg(IndexAdvisor::quoteIdentifier(currentTable),
+                                                            IndexAdvisor::quoteIdentifier(columnName),
+                                                            TableData::sqlLiteral(value));
+    pendingQueries[sqlHandler->execSql(bulkSql(statement, ids))] = query;
+}
+
+void FindTableWidget::applyBulkDelete(const QStringList& ids)
+{
+    int keyColumn = idColumn();
+    if (keyColumn < 0) {
+        return;
+    }
+    QVector<int> rows;
+    for (const QString& id : ids) {
+        int row = tableModel->findRow(keyColumn, id);
+        if (row >= 0) {
+            rows << row;
+        }
+    }
+    tableModel->removeStoreRows(rows);
+}
+
+void FindTableWidget::applyBulkUpdate(const PendingQuery& query)
+{
+    int keyColumn = idColumn();
+    if (keyColumn < 0 || query.column < 0) {
+        return;
+    }
+
+    // 触发器或类型亲和性可能改写服务端的值，行数多时直接重新加载整表
+    bool refresh = needsRowRefresh(query.column);
+    if (refresh && query.ids.size() > maxBulkRowRefresh) {
+        onTableSelected(currentTable);
+        return;
+    }
+
+    for (const QString& id : query.ids) {
+        int row = tableModel->findRow(keyColumn, id);
+        if (row >= 0 && tableModel->value(row, query.column) != query.newValue) {
+            tableModel->setValue(row, query.column, query.newValue);
+        }
+    }
+    if (refresh) {
+        for (const QString& id : query.ids) {
+            refreshRow(id);
+        }
+    }
+}
@@ -0,0 +1,134 @@
+#ifndef FINDTABLEWIDGET_H
+#define FINDTABLEWIDGET_H
+
+#include <QWidget>
+#include <QMap>
+#include <QVBoxLayout>
+#include <QComboBox>
+#include <QTableView>
+#include <QLineEdit>
+#include <QCheckBox>
+#include <QLabel>
+#include <QTimer>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QHeaderView>
+#include "tabledata.h"
+#include "resulttablemodel.h"
+#include "resultproxymodel.h"
+#include "resultviewsizer.h"
+#include "actionbuttondelegate.h"
+#include "scrollprefetcher.h"
+#include "tableprefetcher.h"
+#include "rowcountestimator.h"
+#include "sqlprocesshandler.h"
+#include "schemacache.h"
+
+// 修改查询类型枚举
+enum class QueryType {
+    TableList,
+    TableData,
+    UpdateData,
+    DeleteData,
+    RowRefresh,     // 按主键重新读取单行
+    BulkUpdate,     // 批量设置多行的同一列
+    BulkDelete,     // 批量删除多行
+    Subscribe       // 订阅表的变更通知
+};
+
+// 已发出、等待结果的请求
+struct PendingQuery {
+    QueryType type = QueryType::TableList;
+    QString table;          // 发出请求时的表
+    QString id;             // 涉及行的ID值
+    int column = -1;        // 更新的列
+    QString oldValue;       // 更新前的值，失败时回滚
+    QStringList ids;        // 批量操作涉及的行ID
+    QString newValue;       // 批量设置的新值
+};
+
+class FindTableWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    FindTableWidget(SqlProcessHandler* handler, SchemaCache* schema, QWidget *parent = nullptr);
+    ~FindTableWidget();
+
+    /**
+     * @brief 释放已加载的表数据以回收内存，再次显示时重新加载当前表
+     */
+    void releaseResults();
+
+protected:
+    void showEvent(QShowEvent* event) override;
+
+private slots:
+    void onTableSelected(const QString& tableName);
+    void onResponseReceived(quint64 requestId, const QByteArray& data);
+    void onCellEdited(int row, int column, const QString& oldValue, const QString& newValue);
+    void onDeleteButtonClicked(const QModelIndex& index);
+    void onFilterChanged();
+    void onMappingApplied(int visibleRows, qint64 elapsedMs);
+    void onChangeNotified(const QString& table, const QJsonArray& events);
+    void applyPendingChanges();
+    void onDeleteSelectedClicked();
+    void onBulkUpdateClicked();
+    void updateBulkButtons();
+    void onStatsClicked();
+    void prefetchAdjacentTables();
+    void onRowCountEstimated(const RowCountEstimate& estimate);
+
+private:
+    QComboBox* tableComboBox;
+    QTableView* resultView;
+    ActionButtonDelegate* actionDelegate;
+    ResultViewSizer* viewSizer;
+    ScrollPrefetcher* scrollPrefetcher;     // 预取下一屏的溢出行
+    TablePrefetcher* tablePrefetcher;       // 预取相邻表的首屏
+    RowCountEstimator* rowCounter;          // 完整数据到达前估算总行数
+    SqlProcessHandler* sqlHandler;
+    SchemaCache* schemaCache;
+    ResultTableModel* tableModel;
+    ResultProxyModel* proxyModel;
+    QLineEdit* filterEdit;
+    QCheckBox* regexCheck;
+    QLabel* statusLabel;
+    QPushButton* deleteSelectedButton;
+    QPushButton* bulkUpdateButton;
+    QPushButton* statsButton;
+    QTimer* filterTimer;
+    QMap<quint64, PendingQuery> pendingQueries;   // 请求ID -> 请求上下文
+    QString currentTable;
+    QString loadedTable;            // 模型中当前数据所属的表
+    QString previewTable;           // 模型中正在显示预取首屏的表
+    RowCountEstimate rowEstimate;   // 正在加载的表的估算行数
+    QString subscribedTable;        // 已订阅变更通知的表
+    QVector<QJsonObject> pendingChanges;    // 尚未应用的推送变更
+    QTimer* changeTimer;            // 合并短时间内的推送变更
+    QTimer* selectTimer;            // 切换表的防抖
+    QTimer* prefetchTimer;          // 表加载完成后空闲一段时间再预取
+    quint64 tableLoadId;            // 在途的整表加载请求，0表示没有
+
+    void setupUI();
+    void initConnections();
+    void loadTableList();
+    void setTableList(const QStringList& names);
+    void updateTableView(const TableData& data);
+    QString generateUpdateSql(int row, int column, const QString& newValue);
+    QString generateDeleteSql(int row);
+    int idColumn() const;
+    int findRowById(const QString& id) const;
+    bool needsRowRefresh(int column) const;
+    void refreshRow(const QString& id);
+    void applyRowRefresh(const QString& id, const QJsonObject& jsonObj);
+    void showPrefetchedPage(const QString& tableName);
+    void showLoadingStatus();
+    QStringList selectedIds() const;
+    QStringList filteredIds() const;
+    QString bulkSql(const QString& statement, const QStringList& ids) const;
+    void applyBulkDelete(const QStringList& ids);
+    void applyBulkUpdate(const PendingQuery& query);
+};
+
+#endif // FINDTABLEWIDGET_H 
\ No newline at end of file
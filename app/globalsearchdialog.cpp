@@ -0,0 +1,135 @@
+#include "globalsearchdialog.h"
+#include "keepalivedialog.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QSettings>
+
+namespace {
+
+enum HitColumn {
+    TableColumn,
+    ColumnColumn,
+    RowidColumn,
+    ValueColumn,
+    PreviewColumn,
+    HitColumnCount
+};
+
+} // namespace
+
+GlobalSearchDialog::GlobalSearchDialog(SqlProcessHandler* handler, SchemaCache* schema, const ConnectionProfile& profile,
+                                       QWidget *parent)
+    : QDialog(parent, Qt::Window | Qt::WindowCloseButtonHint)
+{
+    search = new GlobalSearch(handler, schema, profile, this);
+    // 并发连接数(含会话本身的连接)
+    search->setParallelism(QSettings().value("search/connections", 4).toInt());
+    search->setServerCancelEnabled(KeepAliveDialog::serverCancelEnabled());
+    setupUI();
+
+    connect(search, &GlobalSearch::hitFound, this, &GlobalSearchDialog::onHitFound);
+    connect(search, &GlobalSearch::progress, this, &GlobalSearchDialog::onProgress);
+    connect(search, &GlobalSearch::finished, this, &GlobalSearchDialog::onFinished);
+    connect(searchButton, &QPushButton::clicked, this, &GlobalSearchDialog::onSearchClicked);
+    connect(termEdit, &QLineEdit::returnPressed, this, &GlobalSearchDialog::onSearchClicked);
+}
+
+void GlobalSearchDialog::setupUI()
+{
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+    mainLayout->setSpacing(10);
+    mainLayout->setContentsMargins(20, 20, 20, 20);
+
+    // 1. 搜索栏
+    QHBoxLayout* searchLayout = new QHBoxLayout();
+    termEdit = new QLineEdit(this);
+    termEdit->setPlaceholderText("在所有表中查找的值，如客户ID或邮箱...");
+    termEdit->setClearButtonEnabled(true);
+    exactCheck = new QCheckBox("精确匹配", this);
+    exactCheck->setToolTip("整值相等，可以使用索引；不勾选时按子串匹配，需要扫描各列");
+    budgetSpin = new QSpinBox(this);
+    budgetSpin->setRange(0, 600);
+    budgetSpin->setValue(30);
+    budgetSpin->setSuffix(" 秒");
+    budgetSpin->setSpecialValueText("不限时");
+    budgetSpin->setToolTip("超出时间后停止尚未完成的查询");
+    searchButton = new QPushButton("搜索", this);
+    searchLayout->addWidget(termEdit);
+    searchLayout->addWidget(exactCheck);
+    searchLayout->addWidget(new QLabel("时间预算", this));
+    searchLayout->addWidget(budgetSpin);
+    searchLayout->addWidget(searchButton);
+    mainLayout->addLayout(searchLayout);
+
+    // 2. 命中列表
+    hitTable = new QTableWidget(0, HitColumnCount, this);
+    hitTable->setHorizontalHeaderLabels({"表", "列", "rowid", "值", "行预览"});
+    hitTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    hitTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    hitTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    hitTable->horizontalHeader()->setStretchLastSection(true);
+    hitTable->verticalHeader()->setVisible(false);
+    mainLayout->addWidget(hitTable);
+
+    // 3. 状态
+    statusLabel = new QLabel(this);
+    mainLayout->addWidget(statusLabel);
+
+    setWindowTitle("全库搜索");
+    resize(1200, 700);
+}
+
+void GlobalSearchDialog::setSearching(bool searching)
+{
+    searchButton->setText(searching ? "停止" : "搜索");
+    termEdit->setEnabled(!searching);
+    exactCheck->setEnabled(!searching);
+    budgetSpin->setEnabled(!searching);
+}
+
+void GlobalSearchDialog::onSearchClicked()
+{
+    if (search->isRunning()) {
+        search->cancel();
+        setSearching(false);
+        statusLabel->setText(QString("已停止，命中 %1 条").arg(hitTable->rowCount()));
+        return;
+    }
+
+    QString term = termEdit->text();
+    if (term.trimmed().isEmpty()) {
+        return;
+    }
+    hitTable->setRowCount(0);
+    statusLabel->setText("正在准备查询...");
+    setSearching(true);
+    search->start(term, exactCheck->isChecked(), budgetSpin->value() * 1000);
+}
+
+void GlobalSearchDialog::onHitFound(const SearchHit& hit)
+{
+    int row = hitTable->rowCount();
+    hitTable->insertRow(row);
+    QStringList cells;
+    cells << hit.table << hit.column << hit.rowid << hit.value << hit.preview;
+    for (int i = 0; i < cells.size(); ++i) {
+        hitTable->setItem(row, i, new QTableWidgetItem(cells[i]));
+    }
+    // 第一批命中到达时按内容调整一次列宽
+    if (row == 0) {
+        hitTable->resizeColumnsToContents();
+    }
+}
+
+void GlobalSearchDialog::onProgress(int done, int total)
+{
+    statusLabel->setText(QString("已完成 %1 / %2 条查询，命中 %3 条").arg(done).arg(total).arg(hitTable->rowCount()));
+}
+
+void GlobalSearchDialog::onFinished(bool complete, const QString& message)
+{
+    Q_UNUSED(complete);
+    setSearching(false);
+    statusLabel->setText(message);
+}
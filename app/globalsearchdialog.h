@@ -0,0 +1,44 @@
+#ifndef GLOBALSEARCHDIALOG_H
+#define GLOBALSEARCHDIALOG_H
+
+#include <QDialog>
+#include <QLineEdit>
+#include <QCheckBox>
+#include <QSpinBox>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QLabel>
+#include "globalsearch.h"
+
+/**
+ * @brief 全库搜索窗口
+ * 在所有表的文本列中查找一个值，命中随查询完成陆续加入列表，可随时停止
+ */
+class GlobalSearchDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    GlobalSearchDialog(SqlProcessHandler* handler, SchemaCache* schema, const ConnectionProfile& profile,
+                       QWidget *parent = nullptr);
+
+private slots:
+    void onSearchClicked();
+    void onHitFound(const SearchHit& hit);
+    void onProgress(int done, int total);
+    void onFinished(bool complete, const QString& message);
+
+private:
+    GlobalSearch* search;
+    QLineEdit* termEdit;
+    QCheckBox* exactCheck;
+    QSpinBox* budgetSpin;
+    QPushButton* searchButton;
+    QTableWidget* hitTable;
+    QLabel* statusLabel;
+
+    void setupUI();
+    void setSearching(bool searching);
+};
+
+#endif // GLOBALSEARCHDIALOG_H
@@ -0,0 +1,110 @@
+#include "keepalivedialog.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFormLayout>
+#include <QLabel>
+
+KeepAliveDialog::KeepAliveDialog(QWidget *parent)
+    : QDialog(parent, Qt::Window | Qt::WindowCloseButtonHint)
+{
+    setupUI();
+}
+
+int KeepAliveDialog::heartbeatIntervalMs()
+{
+    return QSettings().value("connection/heartbeatIntervalMs", 15000).toInt();
+}
+
+int KeepAliveDialog::heartbeatTimeoutMs()
+{
+    return QSettings().value("connection/heartbeatTimeoutMs", 5000).toInt();
+}
+
+int KeepAliveDialog::reconnectMaxAttempts()
+{
+    return QSettings().value("connection/reconnectMaxAttempts", 8).toInt();
+}
+
+bool KeepAliveDialog::serverCancelEnabled()
+{
+    return QSettings().value("connection/serverCancel", false).toBool();
+}
+
+bool KeepAliveDialog::liveUpdatesEnabled()
+{
+    return QSettings().value("connection/liveUpdates", false).toBool();
+}
+
+void KeepAliveDialog::setupUI()
+{
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->setSpacing(20);
+    mainLayout->setContentsMargins(30, 30, 30, 30);
+
+    QFormLayout *formLayout = new QFormLayout();
+    formLayout->setSpacing(15);
+
+    // 心跳间隔，0表示关闭心跳
+    intervalSpin = new QSpinBox(this);
+    intervalSpin->setRange(0, 3600);
+    intervalSpin->setSuffix(" 秒");
+    intervalSpin->setSpecialValueText("关闭");
+    intervalSpin->setValue(heartbeatIntervalMs() / 1000);
+    formLayout->addRow("空闲心跳间隔:", intervalSpin);
+
+    // 心跳超时
+    timeoutSpin = new QSpinBox(this);
+    timeoutSpin->setRange(1, 600);
+    timeoutSpin->setSuffix(" 秒");
+    timeoutSpin->setValue(heartbeatTimeoutMs() / 1000);
+    formLayout->addRow("心跳超时:", timeoutSpin);
+
+    // 最大重连次数，0表示不自动重连
+    attemptsSpin = new QSpinBox(this);
+    attemptsSpin->setRange(0, 100);
+    attemptsSpin->setSpecialValueText("不重连");
+    attemptsSpin->setValue(reconnectMaxAttempts());
+    formLayout->addRow("最大重连次数:", attemptsSpin);
+
+    // 服务端实现了CANCEL_SQL时，被取代的查询可以在服务端中断
+    serverCancelCheck = new QCheckBox("服务端支持取消执行", this);
+    serverCancelCheck->setChecked(serverCancelEnabled());
+    formLayout->addRow("", serverCancelCheck);
+
+    // 服务端实现了SUBSCRIBE_TABLE时才发送订阅，不认识的请求不应答会错开之后所有应答
+    liveUpdatesCheck = new QCheckBox("服务端支持变更推送(打开的表实时更新)", this);
+    liveUpdatesCheck->setChecked(liveUpdatesEnabled());
+    formLayout->addRow("", liveUpdatesCheck);
+
+    mainLayout->addLayout(formLayout);
+    mainLayout->addStretch(1);
+
+    // 按钮布局
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    buttonLayout->setSpacing(20);
+    saveButton = new QPushButton("保存", this);
+    cancelButton = new QPushButton("取消", this);
+    saveButton->setFixedSize(140, 45);
+    cancelButton->setFixedSize(140, 45);
+    buttonLayout->addStretch(1);
+    buttonLayout->addWidget(saveButton);
+    buttonLayout->addWidget(cancelButton);
+    mainLayout->addLayout(buttonLayout);
+
+    setWindowTitle("连接保活设置");
+    setMinimumSize(450, 300);
+
+    connect(saveButton, &QPushButton::clicked, this, &KeepAliveDialog::onSaveClicked);
+    connect(cancelButton, &QPushButton::clicked, this, &KeepAliveDialog::reject);
+}
+
+void KeepAliveDialog::onSaveClicked()
+{
+    QSettings settings;
+    settings.setValue("connection/heartbeatIntervalMs", intervalSpin->value() * 1000);
+    settings.setValue("connection/heartbeatTimeoutMs", timeoutSpin->value() * 1000);
+    settings.setValue("connection/reconnectMaxAttempts", attemptsSpin->value());
+    settings.setValue("connection/serverCancel", serverCancelCheck->isChecked());
+    settings.setValue("connection/liveUpdates", liveUpdatesCheck->isChecked());
+    accept();
+}
@@ -0,0 +1,43 @@
+#ifndef KEEPALIVEDIALOG_H
+#define KEEPALIVEDIALOG_H
+
+#include <QDialog>
+#include <QSpinBox>
+#include <QPushButton>
+#include <QCheckBox>
+#include <QSettings>
+
+/**
+ * @brief 连接保活设置对话框
+ * 配置心跳间隔、心跳超时、断线自动重连次数以及服务端是否支持取消执行与变更推送，保存在QSettings中
+ */
+class KeepAliveDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit KeepAliveDialog(QWidget *parent = nullptr);
+
+    // QSettings中的键与默认值
+    static int heartbeatIntervalMs();
+    static int heartbeatTimeoutMs();
+    static int reconnectMaxAttempts();
+    static bool serverCancelEnabled();
+    static bool liveUpdatesEnabled();
+
+private slots:
+    void onSaveClicked();
+
+private:
+    QSpinBox* intervalSpin;
+    QSpinBox* timeoutSpin;
+    QSpinBox* attemptsSpin;
+    QCheckBox* serverCancelCheck;
+    QCheckBox* liveUpdatesCheck;
+    QPushButton* saveButton;
+    QPushButton* cancelButton;
+
+    void setupUI();
+};
+
+#endif // KEEPALIVEDIALOG_H
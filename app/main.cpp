@@ -0,0 +1,26 @@
+#include "mainwindow.h"
+
+#include <QApplication>
+#include <QSettings>
+#include <QLoggingCategory>
+#include "resultstore.h"
+#include "messagelog.h"
+
+int main(int argc, char *argv[])
+{
+    QApplication a(argc, argv);
+    QCoreApplication::setOrganizationName("Remote_SQLite");
+    QCoreApplication::setApplicationName("Remote_SQLite");
+    // 单个结果集在内存中的上限，超出部分写入临时文件
+    ResultStore::setDefaultMemoryBudget(QSettings().value("result/memoryBudgetMB", 256).toLongLong() * 1024 * 1024);
+    // 日志分类的过滤规则，如"rsql.response.debug=true"，多条以分号分隔
+    QString logRules = QSettings().value("log/filterRules").toString();
+    if (!logRules.isEmpty()) {
+        QLoggingCategory::setFilterRules(logRules.replace(';', '\n'));
+    }
+    // 最近请求/应答摘要的保留条数，0为不记录
+    MessageLog::getInstance()->setCapacity(QSettings().value("log/ringSize", 256).toInt());
+    MainWindow w;
+    w.show();
+    return a.exec();
+}
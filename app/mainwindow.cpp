@@ -0,0 +1,487 @@
+#include "mainwindow.h"
+#include "ui_mainwindow.h"
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QTimer>
+#include <QThread>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include "messagelog.h"
+#include "recentconnections.h"
+
+namespace {
+
+// 超过该大小的脚本不载入编辑器
+const qint64 largeScriptBytes = 8 * 1024 * 1024;
+// 启动时预连接的握手超时
+const int warmStartTimeoutMs = 3000;
+
+} // namespace
+
+MainWindow::MainWindow(QWidget *parent)
+    : QMainWindow(parent)
+    , ui(new Ui::MainWindow)
+{
+    ui->setupUi(this);
+    setWindowIcon(QIcon(":/pics/icons/sqlite.png"));
+    setWindowTitle("SQLite远程连接器");
+    setMinimumSize(1600, 1200);
+
+    //会话标签页
+    sessionTabs = new QTabWidget(this);
+    sessionTabs->setTabsClosable(true);
+    sessionTabs->setMovable(true);
+    setCentralWidget(sessionTabs);
+
+    //展示控件
+    showAllWidget();
+
+    //绑定Action事件
+    connect(linkAct, &QAction::triggered, this, &MainWindow::showConnectDialog);
+    connect(selfQuery, &QAction::triggered, this, &MainWindow::onSelfQueryAction);
+    connect(disconnectAct, &QAction::triggered, this, &MainWindow::onDisconnectAction);
+    connect(execSript, &QAction::triggered, this, &MainWindow::onOpenScriptDialog);
+    connect(runScriptFile, &QAction::triggered, this, &MainWindow::onRunScriptFileAction);
+    connect(queryTable, &QAction::triggered, this, &MainWindow::onQueryTableAction);
+    connect(globalSearchAct, &QAction::triggered, this, &MainWindow::onGlobalSearchAction);
+    connect(keepAliveAct, &QAction::triggered, this, &MainWindow::onKeepAliveAction);
+    connect(historyAct, &QAction::triggered, this, &MainWindow::onHistoryAction);
+    connect(snapshotAct, &QAction::triggered, this, &MainWindow::onOpenSnapshotAction);
+    connect(messageLogAct, &QAction::triggered, this, &MainWindow::onExportMessageLogAction);
+    connect(sessionTabs, &QTabWidget::tabCloseRequested, this, &MainWindow::onTabCloseRequested);
+    connect(sessionTabs, &QTabWidget::currentChanged, this, &MainWindow::updateActions);
+
+    // 窗口显示后在后台连接上次的数据库
+    QTimer::singleShot(0, this, &MainWindow::warmStart);
+}
+
+void MainWindow::warmStart()
+{
+    QVector<ConnectionProfile> recent = RecentConnections::load();
+    if (!RecentConnections::warmStartEnabled() || recent.isEmpty()) {
+        return;
+    }
+    const ConnectionProfile profile = recent.first();
+    statusBar()->showMessage("正在连接上次的数据库 " + RecentConnections::displayName(profile) + " ...");
+
+    // 握手是阻塞的，放到线程池中进行，界面照常响应；完成后把socket移回主线程
+    QThread* home = thread();
+    auto* watcher = new QFutureWatcher<QTcpSocket*>(this);
+    connect(watcher, &QFutureWatcher<QTcpSocket*>::finished, this, [this, watcher, profile]() {
+        QTcpSocket* socket = watcher->result();
+        watcher->deleteLater();
+        if (!socket) {
+            statusBar()->showMessage("连接上次的数据库失败，请手动连接", 5000);
+            return;
+        }
+        // 等待期间用户已手动连上同一个库时不再重复打开
+        for (int i = 0; i < sessionTabs->count(); ++i) {
+            SessionWidget* session = qobject_cast<SessionWidget*>(sessionTabs->widget(i));
+            if (session && session->profile().ip == profile.ip && session->profile().port == profile.port
+                    && session->profile().dbPath == profile.dbPath) {
+                socket->abort();
+                delete socket;
+                statusBar()->clearMessage();
+                return;
+            }
+        }
+        // 会话创建时即在后台加载表结构，打开查找表时表列表直接取自结构缓存
+        openSession(socket, profile);
+        statusBar()->showMessage("已连接上次的数据库 " + RecentConnections::displayName(profile), 5000);
+    });
+    watcher->setFuture(QtConcurrent::run([profile, home]() -> QTcpSocket* {
+        QTcpSocket* socket = SocketManager::openConnection(profile.ip, profile.port, profile.dbPath, warmStartTimeoutMs);
+        if (socket) {
+            socket->moveToThread(home);
+        }
+        return socket;
+    }));
+}
+
+SessionWidget* MainWindow::openSession(QTcpSocket* socket, const ConnectionProfile& profile)
+{
+    // 每次连接新开一个会话标签页，已有会话保持不动
+    SessionWidget* session = new SessionWidget(socket, profile, sessionTabs);
+    connect(session, &SessionWidget::statusMessage, this, &MainWindow::onSessionMessage);
+    connect(session, &SessionWidget::sessionDisconnected, this, &MainWindow::onSessionDisconnected);
+    int index = sessionTabs->addTab(session, session->title());
+    sessionTabs->setTabToolTip(index, profile.dbPath);
+    sessionTabs->setCurrentIndex(index);
+    updateActions();
+    return session;
+}
+
+SessionWidget* MainWindow::currentSession() const
+{
+    return qobject_cast<SessionWidget*>(sessionTabs->currentWidget());
+}
+
+SessionWidget* MainWindow::connectedSession()
+{
+    SessionWidget* session = currentSession();
+    if (!session || !session->isConnected()) {
+        QMessageBox::warning(this, "警告", "请先连接到数据库服务器！");
+        return nullptr;
+    }
+    return session;
+}
+
+void MainWindow::onSelfQueryAction()
+{
+    if (SessionWidget* session = connectedSession()) {
+        session->showSelfQuery();
+    }
+}
+
+void MainWindow::showConnectDialog()
+{
+    ConnectDialog *dialog = new ConnectDialog(this);
+    connect(dialog, &ConnectDialog::connectionEstablished, 
+            this, [this](QTcpSocket* socket, const ConnectionProfile& profile) {
+        openSession(socket, profile);
+    });
+    
+    int res = dialog->exec();
+    if (res == QDialog::Accepted){
+        QMessageBox::information(this, "连接成功", "连接成功");
+    } else if (res == QDialog::Rejected){
+        QMessageBox::information(this, "连接失败", "连接失败");
+    }
+    dialog->deleteLater();
+    updateActions();
+}
+
+void MainWindow::onDisconnectAction()
+{
+    int index = sessionTabs->currentIndex();
+    if (index < 0) {
+        return;
+    }
+    closeSession(index);
+    QMessageBox::information(this, "断开连接", "已成功断开连接");
+}
+
+void MainWindow::onTabCloseRequested(int index)
+{
+    closeSession(index);
+}
+
+void MainWindow::closeSession(int index)
+{
+    QWidget* session = sessionTabs->widget(index);
+    sessionTabs->removeTab(index);
+    delete session;
+    updateActions();
+}
+
+void MainWindow::onSessionMessage(const QString& msg, int timeoutMs)
+{
+    if (msg.isEmpty()) {
+        statusBar()->clearMessage();
+    } else {
+        statusBar()->showMessage(msg, timeoutMs);
+    }
+}
+
+void MainWindow::onSessionDisconnected()
+{
+    // 断开的会话保留标签页，标题标出状态，由用户关闭
+    SessionWidget* session = qobject_cast<SessionWidget*>(sender());
+    int index = sessionTabs->indexOf(session);
+    if (index >= 0) {
+        sessionTabs->setTabText(index, session->title() + " (已断开)");
+    }
+    updateActions();
+}
+
+void MainWindow::updateActions()
+{
+    disconnectAct->setEnabled(sessionTabs->count() > 0);
+}
+
+void MainWindow::onOpenScriptDialog()
+{
+    SessionWidget* session = connectedSession();
+    if (!session) {
+        return;
+    }
+
+    // 打开文件对话框
+    QString fileName = QFileDialog::getOpenFileName(this,
+        tr("打开SQL脚本"),
+        "D:/",  // 设置根目录为D盘
+        tr("SQL Files (*.sql)"));  // 设置文件过滤器
+
+    if (fileName.isEmpty()) {
+        return;  // 用户取消了选择
+    }
+
+    // 大文件载入编辑器会卡住界面，改为直接执行
+    if (QFileInfo(fileName).size() > largeScriptBytes) {
+        QMessageBox::StandardButton reply = QMessageBox::question(
+            this, "文件较大", "脚本文件较大，载入编辑器会很慢。是否不载入编辑器，直接分批执行？",
+            QMessageBox::Yes | QMessageBox::No);
+        if (reply == QMessageBox::Yes) {
+            session->runScriptFile(fileName);
+        }
+        return;
+    }
+
+    // 读取文件内容
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        QMessageBox::warning(this, "错误", "无法打开文件：" + fileName);
+        return;
+    }
+
+    // 使用UTF-8编码读取文件内容
+    QTextStream in(&file);
+    in.setCodec("UTF-8");  // 设置UTF-8编码
+    QString scriptContent = in.readAll();
+    file.close();
+
+    session->showScript(scriptContent);
+}
+
+void MainWindow::onRunScriptFileAction()
+{
+    SessionWidget* session = connectedSession();
+    if (!session) {
+        return;
+    }
+    QString fileName = QFileDialog::getOpenFileName(this, "执行SQL文件", QString(), "SQL Files (*.sql);;All Files (*)");
+    if (!fileName.isEmpty()) {
+        session->runScriptFile(fileName);
+    }
+}
+
+void MainWindow::onHistoryAction()
+{
+    QueryHistoryDialog* dialog = new QueryHistoryDialog(this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    connect(dialog, &QueryHistoryDialog::statementChosen, this, [this](const QString& statement) {
+        if (SessionWidget* session = connectedSession()) {
+            session->showScript(statement);
+        }
+    });
+    dialog->show();
+}
+
+void MainWindow::onOpenSnapshotAction()
+{
+    QString fileName = QFileDialog::getOpenFileName(this, "打开结果快照", QString(), "结果快照 (*.rsnap)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    // 只映射文件并读取列目录，打开耗时与快照大小无关
+    QElapsedTimer timer;
+    timer.start();
+    QString error;
+    QSharedPointer<ResultSnapshot> snapshot = ResultSnapshot::open(fileName, &error);
+    if (!snapshot) {
+        QMessageBox::warning(this, "错误", "无法打开快照：" + error);
+        return;
+    }
+
+    SnapshotDialog* dialog = new SnapshotDialog(snapshot, timer.elapsed(), this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    dialog->show();
+}
+
+void MainWindow::onExportMessageLogAction()
+{
+    MessageLog* log = MessageLog::getInstance();
+    if (!log->isEnabled()) {
+        QMessageBox::information(this, "提示", "通信日志未开启(配置项log/ringSize为0)");
+        return;
+    }
+    QString fileName = QFileDialog::getSaveFileName(this, "导出通信日志", "rsqlite_messages.log", "日志文件 (*.log *.txt)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QMessageBox::warning(this, "错误", "无法写入文件：" + file.errorString());
+        return;
+    }
+    file.write(log->dump().toUtf8());
+}
+
+void MainWindow::onQueryTableAction()
+{
+    if (SessionWidget* session = connectedSession()) {
+        session->showFindTable();
+    }
+}
+
+void MainWindow::onGlobalSearchAction()
+{
+    if (SessionWidget* session = connectedSession()) {
+        session->showGlobalSearch();
+    }
+}
+
+void MainWindow::onKeepAliveAction()
+{
+    KeepAliveDialog dialog(this);
+    if (dialog.exec() == QDialog::Accepted) {
+        for (int i = 0; i < sessionTabs->count(); ++i) {
+            if (SessionWidget* session = qobject_cast<SessionWidget*>(sessionTabs->widget(i))) {
+                session->applyKeepAliveSettings();
+            }
+        }
+    }
+}
+
+MainWindow::~MainWindow()
+{
+    // 会话析构时关闭各自的连接
+    while (sessionTabs->count() > 0) {
+        closeSession(0);
+    }
+    delete ui;
+}
+
+void MainWindow::showAllWidget(){
+    //菜单
+    menu = new QMenuBar(this);
+    menu->setMinimumSize(1500, 25);
+    QFont menuFont;
+    menuFont.setPointSize(12);
+    menu->setFont(menuFont);
+
+    QFont actionFont;
+    menuFont.setPointSize(20);
+
+    //功能区
+    funcMenu = new QMenu(this);
+    funcMenu->setTitle("功能");
+    //funcMenu->setIcon(QIcon(":/pics/icons/functions.png"));
+    menu->addMenu(funcMenu);
+
+    //执行脚本
+    execSript = new QAction(this);
+    execSript->setIcon(QIcon(":/pics/icons/exec.png"));
+    execSript->setFont(actionFont);
+    execSript->setText("执行脚本");
+    execSript->setStatusTip("选择一个脚本执行");
+    funcMenu->addAction(execSript);
+
+    //执行SQL文件
+    runScriptFile = new QAction(this);
+    runScriptFile->setIcon(QIcon(":/pics/icons/exec.png"));
+    runScriptFile->setFont(actionFont);
+    runScriptFile->setText("执行SQL文件");
+    runScriptFile->setStatusTip("不载入编辑器，分批直接执行大型SQL文件");
+    funcMenu->addAction(runScriptFile);
+
+    //保存脚本
+    saveSript = new QAction(this);
+    saveSript->setIcon(QIcon(":/pics/icons/save.png"));
+    saveSript->setFont(actionFont);
+    saveSript->setText("保存");
+    saveSript->setStatusTip("保存当前编辑的脚本");
+    //funcMenu->addAction(saveSript);
+    
+
+
+    //查找表
+    queryTable = new QAction(this);
+    queryTable->setIcon(QIcon(":/pics/icons/query.png"));
+    queryTable->setFont(actionFont);
+    queryTable->setText("查找表");
+    queryTable->setStatusTip("查找数据库表数据");
+    funcMenu->addAction(queryTable);
+
+    //全库搜索
+    globalSearchAct = new QAction(this);
+    globalSearchAct->setIcon(QIcon(":/pics/icons/query.png"));
+    globalSearchAct->setFont(actionFont);
+    globalSearchAct->setText("全库搜索");
+    globalSearchAct->setStatusTip("在所有表中查找一个值");
+    funcMenu->addAction(globalSearchAct);
+
+    //自定义查询
+    selfQuery = new QAction(this);
+    selfQuery->setIcon(QIcon(":/pics/icons/selfdef.png"));
+    selfQuery->setFont(actionFont);
+    selfQuery->setText("自定义查询");
+    selfQuery->setStatusTip("自定义SQL语句查询");
+    funcMenu->addAction(selfQuery);
+
+    //查询历史
+    historyAct = new QAction(this);
+    historyAct->setIcon(QIcon(":/pics/icons/docs.png"));
+    historyAct->setFont(actionFont);
+    historyAct->setText("查询历史");
+    historyAct->setStatusTip("查看执行过的语句与慢查询统计");
+    funcMenu->addAction(historyAct);
+
+    //结果快照
+    snapshotAct = new QAction(this);
+    snapshotAct->setIcon(QIcon(":/pics/icons/docs.png"));
+    snapshotAct->setFont(actionFont);
+    snapshotAct->setText("打开结果快照");
+    snapshotAct->setStatusTip("不连接服务器，直接打开保存过的查询结果");
+    funcMenu->addAction(snapshotAct);
+
+    //设置
+    settingMenu = new QMenu(this);
+    settingMenu->setTitle("设置");
+    //settingMenu->setIcon(QIcon(":/pics/icons/setting.png"));
+    menu->addMenu(settingMenu);
+    //连接
+    linkAct = new QAction(this);
+    linkAct->setIcon(QIcon(":/pics/icons/link.png"));
+    linkAct->setText("连接到SQLite");
+    linkAct->setStatusTip("连接到SQLite数据库");
+    settingMenu->addAction(linkAct);
+
+    //断开连接
+    disconnectAct = new QAction(this);
+    disconnectAct->setIcon(QIcon(":/pics/icons/disconnect.png"));
+    disconnectAct->setText("断开连接");
+    disconnectAct->setStatusTip("断开当前的Sqlite连接");
+    settingMenu->addAction(disconnectAct);
+    //初始的时候不可点击
+    disconnectAct->setEnabled(false);
+
+    //连接保活
+    keepAliveAct = new QAction(this);
+    keepAliveAct->setIcon(QIcon(":/pics/icons/setting.png"));
+    keepAliveAct->setText("连接保活");
+    keepAliveAct->setStatusTip("设置心跳间隔与断线自动重连");
+    settingMenu->addAction(keepAliveAct);
+
+    //通信日志
+    messageLogAct = new QAction(this);
+    messageLogAct->setIcon(QIcon(":/pics/icons/docs.png"));
+    messageLogAct->setText("导出通信日志");
+    messageLogAct->setStatusTip("保存最近请求与应答的摘要(大小、耗时、开头内容)");
+    settingMenu->addAction(messageLogAct);
+
+    //帮助
+    helpMenu = new QMenu(this);
+    helpMenu->setTitle("帮助");
+    //helpMenu->setIcon(QIcon(":/pics/icons/help.png"));
+    menu->addMenu(helpMenu);
+
+    //使用文档
+    docsAct = new QAction(this);
+    docsAct->setIcon(QIcon(":/pics/icons/docs.png"));
+    docsAct->setText("使用文档");
+    docsAct->setStatusTip("查看使用说明");
+    helpMenu->addAction(docsAct);
+
+    //使用视频
+    vedioAct = new QAction(this);
+    vedioAct->setIcon(QIcon(":/pics/icons/vedio.png"));
+    vedioAct->setText("使用视频");
+    vedioAct->setStatusTip("查看使用案例视频");
+    helpMenu->addAction(vedioAct);
+    menu->addMenu(helpMenu);
+
+    setMenuBar(menu);
+    //
+}
@@ -13,10 +13,12 @@
 #include <QJsonObject>
 #include <QIcon>
 #include <QAction>
+#include <QTabWidget>
 #include "connectdialog.h"
-#include "scriptwidget.h"
-#include "findtablewidget.h"
-#include "socketmanager.h"
+#include "sessionwidget.h"
+#include "keepalivedialog.h"
+#include "queryhistorydialog.h"
+#include "snapshotdialog.h"
 #include <QTcpSocket>
 #include <QFile>
 #include <QFileDialog>
@@ -38,7 +40,18 @@ private slots:
     void onSelfQueryAction();
     void onDisconnectAction();
     void onOpenScriptDialog();
+    void onRunScriptFileAction();
     void onQueryTableAction();
+    void onGlobalSearchAction();
+    void onKeepAliveAction();
+    void onHistoryAction();
+    void onOpenSnapshotAction();
+    void onExportMessageLogAction();
+    void onTabCloseRequested(int index);
+    void onSessionMessage(const QString& msg, int timeoutMs);
+    void onSessionDisconnected();
+    void updateActions();
+    void warmStart();
 
 private:
     Ui::MainWindow *ui;
@@ -48,15 +61,23 @@ private:
     QMenu *helpMenu;
     QAction *execSript;
     QAction *saveSript;
+    QAction *runScriptFile;
     QAction *queryTable;
+    QAction *globalSearchAct;
     QAction *selfQuery;
     QAction *linkAct;
     QAction *disconnectAct;
+    QAction *keepAliveAct;
+    QAction *historyAct;
+    QAction *snapshotAct;
+    QAction *messageLogAct;
     QAction *docsAct;
     QAction *vedioAct;
-    ScriptWidget *scriptWidget;
-    FindTableWidget *findTableWidget;
+    QTabWidget *sessionTabs;    // 每个标签页是一个数据库会话
     void showAllWidget();
-    void clearWidgets();
+    SessionWidget* currentSession() const;
+    SessionWidget* connectedSession();
+    SessionWidget* openSession(QTcpSocket* socket, const ConnectionProfile& profile);
+    void closeSession(int index);
 };
 #endif // MAINWINDOW_H
@@ -0,0 +1,313 @@
+#include "queryhistory.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QStandardPaths>
+#include <QDir>
+#include <QCoreApplication>
+#include <QRegularExpression>
+#include <QDebug>
+
+QueryHistory* QueryHistory::instance = nullptr;
+const char* QueryHistory::connectionName = "query_history";
+
+QueryHistory* QueryHistory::getInstance()
+{
+    if (!instance) {
+        instance = new QueryHistory();
+    }
+    return instance;
+}
+
+QueryHistory::QueryHistory(QObject *parent)
+    : QObject(parent), opened(false), insertsSincePrune(0)
+{
+    opened = open();
+
+    // 逐条同步写入会在每个响应上阻塞界面线程，改为攒批后在一个事务中写入
+    flushTimer = new QTimer(this);
+    flushTimer->setSingleShot(true);
+    connect(flushTimer, &QTimer::timeout, this, &QueryHistory::flush);
+    if (QCoreApplication::instance()) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &QueryHistory::flush);
+    }
+}
+
+QString QueryHistory::databasePath()
+{
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(dir);
+    return dir + "/history.db";
+}
+
+QSqlDatabase QueryHistory::database() const
+{
+    return QSqlDatabase::database(connectionName);
+}
+
+bool QueryHistory::open()
+{
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+    db.setDatabaseName(databasePath());
+    if (!db.open()) {
+        qWarning() << "无法打开查询历史库:" << db.lastError().text();
+        return false;
+    }
+
+    QSqlQuery query(db);
+    // 历史只追加，WAL下写入不阻塞界面上的读取
+    query.exec("PRAGMA journal_mode=WAL;");
+    query.exec("PRAGMA synchronous=NORMAL;");
+    bool ok = query.exec(
+        "CREATE TABLE IF NOT EXISTS history ("
+        "id INTEGER PRIMARY KEY, "
+        "executed_at INTEGER NOT NULL, "
+        "server TEXT, "
+        "db_path TEXT, "
+        "statement TEXT NOT NULL, "
+        "fingerprint TEXT NOT NULL, "
+        "duration_ms INTEGER NOT NULL, "
+        "rows INTEGER NOT NULL, "
+        "bytes INTEGER NOT NULL, "
+        "ok INTEGER NOT NULL);");
+    ok = ok && query.exec("CREATE INDEX IF NOT EXISTS idx_history_fingerprint "
+                          "ON history(fingerprint, duration_ms);");
+    if (!ok) {
+        qWarning() << "无法初始化查询历史库:" << query.lastError().text();
+    }
+    return ok;
+}
+
+void QueryHistory::record(const QString& server, const QString& dbPath, const QString& statement,
+                          qint64 durationMs, int rows, qint64 bytes, bool ok)
+{
+    if (!opened) {
+        return;
+    }
+
+    HistoryEntry entry;
+    entry.executedAt = QDateTime::currentDateTime();
+    entry.server = server;
+    entry.dbPath = dbPath;
+    entry.statement = statement;
+    entry.durationMs = durationMs;
+    entry.rows = rows;
+    entry.bytes = bytes;
+    entry.ok = ok;
+    queued << entry;
+
+    if (queued.size() >= flushBatchSize) {
+        flush();
+    } else if (!flushTimer->isActive()) {
+        flushTimer->start(flushDelayMs);
+    }
+}
+
+void QueryHistory::flush()
+{
+    flushTimer->stop();
+    if (!opened || queued.isEmpty()) {
+        return;
+    }
+
+    QSqlDatabase db = database();
+    db.transaction();
+    QSqlQuery query(db);
+    query.prepare("INSERT INTO history(executed_at, server, db_path, statement, fingerprint, "
+                  "duration_ms, rows, bytes, ok) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?);");
+    for (const HistoryEntry& entry : queued) {
+        query.addBindValue(entry.executedAt.toMSecsSinceEpoch());
+        query.addBindValue(entry.server);
+        query.addBindValue(entry.dbPath);
+        query.addBindValue(entry.statement);
+        query.addBindValue(fingerprint(entry.statement));
+        query.addBindValue(entry.durationMs);
+        query.addBindValue(entry.rows);
+        query.addBindValue(entry.bytes);
+        query.addBindValue(entry.ok ? 1 : 0);
+        if (!query.exec()) {
+            qWarning() << "写入查询历史失败:" << query.lastError().text();
+        }
+    }
+    insertsSincePrune += queued.size();
+    queued.clear();
+
+    if (insertsSincePrune >= pruneInterval) {
+        insertsSincePrune = 0;
+        prune();
+    }
+    db.commit();
+}
+
+void QueryHistory::prune()
+{
+    QSqlQuery query(database());
+    query.prepare("DELETE FROM history WHERE id <= (SELECT max(id) FROM history) - ?;");
+    query.addBindValue(maxEntries);
+    query.exec();
+}
+
+QVector<HistoryEntry> QueryHistory::recent(int limit, const QString& filter)
+{
+    QVector<HistoryEntry> entries;
+    if (!opened) {
+        return entries;
+    }
+    flush();
+
+    QSqlQuery query(database());
+    query.prepare("SELECT id, executed_at, server, db_path, statement, fingerprint, duration_ms, rows, bytes, ok "
+                  "FROM history WHERE ? = '' OR instr(lower(statement), lower(?)) > 0 "
+                  "ORDER BY id DESC LIMIT ?;");
+    query.addBindValue(filter);
+    query.addBindValue(filter);
+    query.addBindValue(limit);
+    query.exec();
+    while (query.next()) {
+        HistoryEntry entry;
+        entry.id = query.value(0).toLongLong();
+        entry.executedAt = QDateTime::fromMSecsSinceEpoch(query.value(1).toLongLong());
+        entry.server = query.value(2).toString();
+        entry.dbPath = query.value(3).toString();
+        entry.statement = query.value(4).toString();
+        entry.fingerprint = query.value(5).toString();
+        entry.durationMs = query.value(6).toLongLong();
+        entry.rows = query.value(7).toInt();
+        entry.bytes = query.value(8).toLongLong();
+        entry.ok = query.value(9).toInt() != 0;
+        entries << entry;
+    }
+    return entries;
+}
+
+QVector<FingerprintStats> QueryHistory::slowQueries(int limit)
+{
+    QVector<FingerprintStats> stats;
+    if (!opened) {
+        return stats;
+    }
+    flush();
+
+    QSqlQuery query(database());
+    query.prepare("SELECT fingerprint, count(*), sum(duration_ms), avg(duration_ms), max(duration_ms), "
+                  "max(executed_at), (SELECT statement FROM history h2 WHERE h2.fingerprint = h.fingerprint "
+                  "ORDER BY id DESC LIMIT 1) "
+                  "FROM history h GROUP BY fingerprint ORDER BY sum(duration_ms) DESC LIMIT ?;");
+    query.addBindValue(limit);
+    query.exec();
+    while (query.next()) {
+        FingerprintStats item;
+        item.fingerprint = query.value(0).toString();
+        item.count = query.value(1).toInt();
+        item.totalMs = query.value(2).toLongLong();
+        item.meanMs = query.value(3).toDouble();
+        item.maxMs = query.value(4).toLongLong();
+        item.lastSeen = QDateTime::fromMSecsSinceEpoch(query.value(5).toLongLong());
+        item.sample = query.value(6).toString();
+        stats << item;
+    }
+
+    // SQLite没有分位数函数，借助(fingerprint, duration_ms)索引按偏移直接取第95百分位
+    QSqlQuery percentile(database());
+    percentile.prepare("SELECT duration_ms FROM history WHERE fingerprint = ? "
+                       "ORDER BY duration_ms LIMIT 1 OFFSET ?;");
+    for (FingerprintStats& item : stats) {
+        int rank = (item.count * 95 + 99) / 100;   // 向上取整
+        percentile.addBindValue(item.fingerprint);
+        percentile.addBindValue(qMax(0, rank - 1));
+        if (percentile.exec() && percentile.next()) {
+            item.p95Ms = percentile.value(0).toLongLong();
+        }
+    }
+    return stats;
+}
+
+void QueryHistory::clear()
+{
+    queued.clear();
+    flushTimer->stop();
+    if (!opened) {
+        return;
+    }
+    QSqlQuery query(database());
+    query.exec("DELETE FROM history;");
+}
+
+QString QueryHistory::fingerprint(const QString& sql)
+{
+    QString result;
+    result.reserve(sql.size());
+
+    auto isIdentChar = [](QChar c) { return c.isLetterOrNumber() || c == '_' || c == '$'; };
+    const int n = sql.size();
+    int i = 0;
+    while (i < n) {
+        QChar c = sql[i];
+        QChar next = i + 1 < n ? sql[i + 1] : QChar();
+        QChar prev = result.isEmpty() ? QChar() : result[result.size() - 1];
+
+        if (c == '-' && next == '-') {
+            // 行注释
+            while (i < n && sql[i] != '\n') {
+                ++i;
+            }
+        } else if (c == '/' && next == '*') {
+            // 块注释
+            int end = sql.indexOf("*/", i + 2);
+            i = end < 0 ? n : end + 2;
+            result += ' ';
+        } else if (c == '\'' || ((c == 'x' || c == 'X') && next == '\'' && !isIdentChar(prev))) {
+            // 字符串与BLOB字面量
+            i += (c == '\'') ? 1 : 2;
+            while (i < n) {
+                if (sql[i] == '\'') {
+                    if (i + 1 < n && sql[i + 1] == '\'') {
+                        i += 2;
+                        continue;
+                    }
+                    break;
+                }
+                ++i;
+            }
+            ++i;
+            result += '?';
+        } else if (c == '"' || c == '`' || c == '[') {
+            // 引号标识符原样保留
+            QChar close = (c == '[') ? QChar(']') : c;
+            int end = sql.indexOf(close, i + 1);
+            end = end < 0 ? n - 1 : end;
+            result += sql.mid(i, end - i + 1);
+            i = end + 1;
+        } else if ((c.isDigit() || (c == '.' && next.isDigit())) && !isIdentChar(prev)) {
+            // 数字字面量，含十六进制、小数与指数
+            ++i;
+            while (i < n && (isIdentChar(sql[i]) || sql[i] == '.'
+                             || ((sql[i] == '+' || sql[i] == '-') && (sql[i - 1] == 'e' || sql[i - 1] == 'E')))) {
+                ++i;
+            }
+            result += '?';
+        } else if (c.isSpace()) {
+            ++i;
+            if (!result.isEmpty() && prev != ' ') {
+                result += ' ';
+            }
+        } else {
+            result += c.toLower();
+            ++i;
+        }
+    }
+
+    // 负号与占位符合并，IN列表与多行VALUES折叠
+    static const QRegularExpression negative("([(,=<>]\\s*)-\\s*\\?");
+    static const QRegularExpression list("\\(\\s*\\?(?:\\s*,\\s*\\?)*\\s*\\)");
+    static const QRegularExpression rows("\\(\\?\\+\\)(?:\\s*,\\s*\\(\\?\\+\\))+");
+    static const QRegularExpression spaces("\\s*([(),;=<>])\\s*");
+    result.replace(negative, "\\1?");
+    result.replace(list, "(?+)");
+    result.replace(rows, "(?+)");
+    result.replace(spaces, "\\1");
+    result = result.trimmed();
+    while (result.endsWith(';')) {
+        result.chop(1);
+    }
+    return result;
+}
@@ -0,0 +1,104 @@
+#ifndef QUERYHISTORY_H
+#define QUERYHISTORY_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QVector>
+#include <QSqlDatabase>
+#include <QTimer>
+
+// 一条执行记录
+struct HistoryEntry {
+    qint64 id = 0;
+    QDateTime executedAt;
+    QString server;
+    QString dbPath;
+    QString statement;
+    QString fingerprint;
+    qint64 durationMs = 0;
+    int rows = 0;
+    qint64 bytes = 0;
+    bool ok = true;
+};
+
+// 按指纹聚合的统计
+struct FingerprintStats {
+    QString fingerprint;
+    QString sample;             // 最近一次执行的原始语句
+    int count = 0;
+    qint64 totalMs = 0;
+    double meanMs = 0;
+    qint64 p95Ms = 0;
+    qint64 maxMs = 0;
+    QDateTime lastSeen;
+};
+
+/**
+ * @brief 本地查询历史
+ * 每次执行的语句连同服务器、耗时、行数、字节数写入本地SQLite文件，
+ * 并按去掉字面量后的语句指纹聚合出次数、平均耗时与P95，用于找出慢查询
+ */
+class QueryHistory : public QObject
+{
+    Q_OBJECT
+
+public:
+    static QueryHistory* getInstance();
+
+    bool isOpen() const { return opened; }
+
+    /**
+     * @brief 记录一次执行，先放入队列，由定时器在一个事务中批量写入
+     */
+    void record(const QString& server, const QString& dbPath, const QString& statement,
+                qint64 durationMs, int rows, qint64 bytes, bool ok);
+
+    /**
+     * @brief 最近的执行记录，新的在前
+     * @param filter 语句中包含的子串，为空时不过滤
+     */
+    QVector<HistoryEntry> recent(int limit, const QString& filter = QString());
+
+    /**
+     * @brief 按总耗时从高到低排列的语句指纹
+     */
+    QVector<FingerprintStats> slowQueries(int limit);
+
+    void clear();
+
+    /**
+     * @brief 立即写入队列中的记录
+     */
+    void flush();
+
+    /**
+     * @brief 语句指纹：去掉注释，字面量替换为?，IN列表与多行VALUES折叠，空白归一并转小写
+     */
+    static QString fingerprint(const QString& sql);
+
+    /**
+     * @brief 历史库文件位置
+     */
+    static QString databasePath();
+
+private:
+    explicit QueryHistory(QObject *parent = nullptr);
+
+    static QueryHistory* instance;
+    static const char* connectionName;
+    static const int maxEntries = 50000;     // 保留的最多记录数
+    static const int pruneInterval = 500;    // 每写入多少条检查一次
+    static const int flushDelayMs = 2000;    // 记录在队列中最多停留的时间
+    static const int flushBatchSize = 200;   // 队列达到该长度时立即写入
+
+    bool opened;
+    int insertsSincePrune;
+    QVector<HistoryEntry> queued;           // 尚未写入的记录
+    QTimer* flushTimer;
+
+    bool open();
+    void prune();
+    QSqlDatabase database() const;
+};
+
+#endif // QUERYHISTORY_H
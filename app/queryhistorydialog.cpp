@@ -0,0 +1,168 @@
+#include "queryhistorydialog.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QMessageBox>
+
+namespace {
+
+const int historyLimit = 1000;
+const int slowQueryLimit = 200;
+
+QTableWidgetItem* numberItem(qint64 value)
+{
+    QTableWidgetItem* item = new QTableWidgetItem;
+    item->setData(Qt::DisplayRole, value);
+    item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    return item;
+}
+
+} // namespace
+
+QueryHistoryDialog::QueryHistoryDialog(QWidget *parent)
+    : QDialog(parent, Qt::Window | Qt::WindowCloseButtonHint)
+{
+    setupUI();
+    reloadHistory();
+    reloadSlowQueries();
+}
+
+QTableWidget* QueryHistoryDialog::createTable(const QStringList& headers)
+{
+    QTableWidget* table = new QTableWidget(0, headers.size(), this);
+    table->setHorizontalHeaderLabels(headers);
+    table->horizontalHeader()->setStretchLastSection(true);
+    table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table->setSelectionMode(QAbstractItemView::SingleSelection);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->verticalHeader()->setVisible(false);
+    table->setSortingEnabled(true);
+    connect(table, &QTableWidget::cellDoubleClicked, this, &QueryHistoryDialog::onLoadClicked);
+    return table;
+}
+
+void QueryHistoryDialog::setupUI()
+{
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+    mainLayout->setSpacing(10);
+    mainLayout->setContentsMargins(20, 20, 20, 20);
+
+    tabWidget = new QTabWidget(this);
+
+    // 1. 历史记录
+    QWidget* historyPage = new QWidget(this);
+    QVBoxLayout* historyLayout = new QVBoxLayout(historyPage);
+    filterEdit = new QLineEdit(historyPage);
+    filterEdit->setPlaceholderText("筛选语句...");
+    filterEdit->setClearButtonEnabled(true);
+    historyTable = createTable({"时间", "服务器", "耗时(ms)", "行数", "字节", "状态", "语句"});
+    historyLayout->addWidget(filterEdit);
+    historyLayout->addWidget(historyTable);
+    tabWidget->addTab(historyPage, "历史");
+
+    // 2. 慢查询，按总耗时排序
+    slowTable = createTable({"总耗时(ms)", "次数", "平均(ms)", "P95(ms)", "最大(ms)", "最近执行", "语句指纹"});
+    tabWidget->addTab(slowTable, "慢查询");
+    mainLayout->addWidget(tabWidget);
+
+    filterTimer = new QTimer(this);
+    filterTimer->setSingleShot(true);
+    filterTimer->setInterval(200);
+
+    // 3. 按钮
+    QHBoxLayout* buttonLayout = new QHBoxLayout();
+    loadButton = new QPushButton("载入", this);
+    loadButton->setToolTip("把选中的语句放入脚本编辑器");
+    clearButton = new QPushButton("清空历史", this);
+    closeButton = new QPushButton("关闭", this);
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(loadButton);
+    buttonLayout->addWidget(clearButton);
+    buttonLayout->addWidget(closeButton);
+    mainLayout->addLayout(buttonLayout);
+
+    connect(filterEdit, &QLineEdit::textChanged, filterTimer, static_cast<void(QTimer::*)()>(&QTimer::start));
+    connect(filterTimer, &QTimer::timeout, this, &QueryHistoryDialog::reloadHistory);
+    connect(loadButton, &QPushButton::clicked, this, &QueryHistoryDialog::onLoadClicked);
+    connect(clearButton, &QPushButton::clicked, this, &QueryHistoryDialog::onClearClicked);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::close);
+
+    if (!QueryHistory::getInstance()->isOpen()) {
+        setWindowTitle("查询历史 (历史库不可用)");
+    } else {
+        setWindowTitle("查询历史");
+    }
+    resize(1200, 700);
+}
+
+void QueryHistoryDialog::reloadHistory()
+{
+    QVector<HistoryEntry> entries = QueryHistory::getInstance()->recent(historyLimit, filterEdit->text().trimmed());
+
+    historyTable->setSortingEnabled(false);
+    historyTable->setRowCount(entries.size());
+    for (int i = 0; i < entries.size(); ++i) {
+        const HistoryEntry& entry = entries[i];
+        QTableWidgetItem* timeItem = new QTableWidgetItem(entry.executedAt.toString("yyyy-MM-dd HH:mm:ss"));
+        timeItem->setData(Qt::UserRole, entry.statement);
+        historyTable->setItem(i, 0, timeItem);
+        historyTable->setItem(i, 1, new QTableWidgetItem(entry.server + " " + entry.dbPath));
+        historyTable->setItem(i, 2, numberItem(entry.durationMs));
+        historyTable->setItem(i, 3, numberItem(entry.rows));
+        historyTable->setItem(i, 4, numberItem(entry.bytes));
+        historyTable->setItem(i, 5, new QTableWidgetItem(entry.ok ? "成功" : "失败"));
+        QTableWidgetItem* statementItem = new QTableWidgetItem(entry.statement.simplified());
+        statementItem->setToolTip(entry.statement);
+        historyTable->setItem(i, 6, statementItem);
+    }
+    historyTable->setSortingEnabled(true);
+    historyTable->resizeColumnsToContents();
+}
+
+void QueryHistoryDialog::reloadSlowQueries()
+{
+    QVector<FingerprintStats> stats = QueryHistory::getInstance()->slowQueries(slowQueryLimit);
+
+    slowTable->setSortingEnabled(false);
+    slowTable->setRowCount(stats.size());
+    for (int i = 0; i < stats.size(); ++i) {
+        const FingerprintStats& item = stats[i];
+        QTableWidgetItem* totalItem = numberItem(item.totalMs);
+        totalItem->setData(Qt::UserRole, item.sample);
+        slowTable->setItem(i, 0, totalItem);
+        slowTable->setItem(i, 1, numberItem(item.count));
+        slowTable->setItem(i, 2, numberItem(qRound64(item.meanMs)));
+        slowTable->setItem(i, 3, numberItem(item.p95Ms));
+        slowTable->setItem(i, 4, numberItem(item.maxMs));
+        slowTable->setItem(i, 5, new QTableWidgetItem(item.lastSeen.toString("yyyy-MM-dd HH:mm:ss")));
+        QTableWidgetItem* fingerprintItem = new QTableWidgetItem(item.fingerprint);
+        fingerprintItem->setToolTip(item.sample);
+        slowTable->setItem(i, 6, fingerprintItem);
+    }
+    slowTable->sortByColumn(0, Qt::DescendingOrder);
+    slowTable->setSortingEnabled(true);
+    slowTable->resizeColumnsToContents();
+}
+
+void QueryHistoryDialog::onLoadClicked()
+{
+    // 原始语句存放在每页第一列的UserRole中
+    QTableWidget* table = tabWidget->currentIndex() == 0 ? historyTable : slowTable;
+    int row = table->currentRow();
+    if (row < 0 || !table->item(row, 0)) {
+        return;
+    }
+    emit statementChosen(table->item(row, 0)->data(Qt::UserRole).toString());
+}
+
+void QueryHistoryDialog::onClearClicked()
+{
+    QMessageBox::StandardButton reply = QMessageBox::question(
+        this, "确认清空", "确定要清空全部查询历史吗？", QMessageBox::Yes | QMessageBox::No);
+    if (reply != QMessageBox::Yes) {
+        return;
+    }
+    QueryHistory::getInstance()->clear();
+    reloadHistory();
+    reloadSlowQueries();
+}
@@ -0,0 +1,47 @@
+#ifndef QUERYHISTORYDIALOG_H
+#define QUERYHISTORYDIALOG_H
+
+#include <QDialog>
+#include <QTabWidget>
+#include <QTableWidget>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QTimer>
+#include "queryhistory.h"
+
+/**
+ * @brief 查询历史与慢查询对话框
+ * "历史"页按时间倒序列出执行记录，"慢查询"页按语句指纹的总耗时排序，
+ * 双击或点击"载入"把语句放回脚本编辑器
+ */
+class QueryHistoryDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit QueryHistoryDialog(QWidget *parent = nullptr);
+
+signals:
+    void statementChosen(const QString& statement);
+
+private slots:
+    void reloadHistory();
+    void reloadSlowQueries();
+    void onLoadClicked();
+    void onClearClicked();
+
+private:
+    QTabWidget* tabWidget;
+    QTableWidget* historyTable;
+    QTableWidget* slowTable;
+    QLineEdit* filterEdit;
+    QTimer* filterTimer;
+    QPushButton* loadButton;
+    QPushButton* clearButton;
+    QPushButton* closeButton;
+
+    void setupUI();
+    QTableWidget* createTable(const QStringList& headers);
+};
+
+#endif // QUERYHISTORYDIALOG_H
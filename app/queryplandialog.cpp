@@ -0,0 +1,276 @@
+#include "queryplandialog.h"
+#include "tabledata.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QApplication>
+#include <QClipboard>
+#include <QMessageBox>
+#include <QJsonObject>
+#include <QDateTime>
+
+QueryPlanDialog::QueryPlanDialog(SqlProcessHandler* handler, SchemaCache* schema, const QString& statement,
+                                 QWidget *parent)
+    : QDialog(parent, Qt::Window | Qt::WindowCloseButtonHint),
+      sqlHandler(handler), schemaCache(schema), statement(statement.trimmed()),
+      beforeMs(0), createMs(0)
+{
+    // 去掉末尾分号，便于拼接EXPLAIN
+    while (this->statement.endsWith(';')) {
+        this->statement.chop(1);
+        this->statement = this->statement.trimmed();
+    }
+
+    setupUI();
+    connect(sqlHandler, &SqlProcessHandler::responseReceived, this, &QueryPlanDialog::onResponseReceived);
+    connect(schemaCache, &SchemaCache::schemaLoaded, this, &QueryPlanDialog::onSchemaLoaded);
+
+    sendStep(Step::Explain, "EXPLAIN QUERY PLAN " + this->statement + ";");
+    // 没有结构信息就无法判断列归属，先加载
+    if (!schemaCache->isLoaded() && !schemaCache->isLoading()) {
+        schemaCache->refresh();
+    }
+}
+
+QueryPlanDialog::~QueryPlanDialog()
+{
+    // 试用过程中关闭对话框，服务端按顺序执行，删除语句会排在建索引之后
+    if (!trialIndexName.isEmpty()) {
+        sqlHandler->execSql("DROP INDEX IF EXISTS " + trialIndexName + ";");
+    }
+}
+
+void QueryPlanDialog::setupUI()
+{
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+    mainLayout->setSpacing(10);
+    mainLayout->setContentsMargins(20, 20, 20, 20);
+
+    statementLabel = new QLabel(statement, this);
+    statementLabel->setWordWrap(true);
+    statementLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    statementLabel->setFont(QFont("Consolas", 10));
+    mainLayout->addWidget(statementLabel);
+
+    // 1. 查询计划树
+    planTree = new QTreeWidget(this);
+    planTree->setHeaderLabels({"查询计划"});
+    planTree->setMinimumSize(800, 250);
+    mainLayout->addWidget(planTree, 2);
+
+    // 2. 候选索引
+    suggestionTable = new QTableWidget(0, 2, this);
+    suggestionTable->setHorizontalHeaderLabels({"候选索引", "依据"});
+    suggestionTable->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    suggestionTable->horizontalHeader()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
+    suggestionTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    suggestionTable->setSelectionMode(QAbstractItemView::SingleSelection);
+    suggestionTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    suggestionTable->verticalHeader()->setVisible(false);
+    mainLayout->addWidget(suggestionTable, 1);
+
+    resultLabel = new QLabel(this);
+    resultLabel->setWordWrap(true);
+    mainLayout->addWidget(resultLabel);
+
+    // 3. 按钮
+    QHBoxLayout* buttonLayout = new QHBoxLayout();
+    tryButton = new QPushButton("试用索引", this);
+    tryButton->setToolTip("临时创建选中的索引并对比前后耗时，完成后自动删除");
+    copyButton = new QPushButton("复制语句", this);
+    closeButton = new QPushButton("关闭", this);
+    tryButton->setEnabled(false);
+    copyButton->setEnabled(false);
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(tryButton);
+    buttonLayout->addWidget(copyButton);
+    buttonLayout->addWidget(closeButton);
+    mainLayout->addLayout(buttonLayout);
+
+    connect(tryButton, &QPushButton::clicked, this, &QueryPlanDialog::onTryIndexClicked);
+    connect(copyButton, &QPushButton::clicked, this, &QueryPlanDialog::onCopyClicked);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::close);
+    connect(suggestionTable, &QTableWidget::itemSelectionChanged, this, [this]() {
+        bool selected = !suggestionTable->selectedItems().isEmpty();
+        copyButton->setEnabled(selected);
+        tryButton->setEnabled(selected && pendingSteps.isEmpty()
+                              && SqlProcessHandler::isIdempotentSql(statement));
+    });
+
+    setWindowTitle("查询计划");
+    resize(900, 600);
+}
+
+void QueryPlanDialog::sendStep(Step step, const QString& sql)
+{
+    stepTimer.start();
+    pendingSteps[sqlHandler->execSql(sql)] = step;
+}
+
+QString QueryPlanDialog::timingSql() const
+{
+    // 计时执行语句本身：包一层count(*)时SQLite会去掉不需要的ORDER BY、改用覆盖索引计数，
+    // 测不出排序类索引的效果
+    return statement + ";";
+}
+
+void QueryPlanDialog::onResponseReceived(quint64 requestId, const QByteArray& data)
+{
+    if (!pendingSteps.contains(requestId)) {
+        return;
+    }
+    Step step = pendingSteps.take(requestId);
+    qint64 elapsed = stepTimer.elapsed();
+
+    bool ok = false;
+    QJsonObject jsonObj = TableData::parseResponse(data, &ok);
+    QString error;
+    if (!ok) {
+        error = "返回数据格式错误";
+    } else if (jsonObj["status"].toInt() != 0) {
+        error = jsonObj["msg"].toString();
+    }
+
+    switch (step) {
+    case Step::Explain:
+        if (!error.isEmpty()) {
+            QMessageBox::warning(this, "错误", "无法获取查询计划\n" + error);
+            return;
+        }
+        plan = IndexAdvisor::parsePlan(jsonObj);
+        showPlan(plan);
+        updateSuggestions();
+        break;
+    case Step::TimeBefore:
+        if (!error.isEmpty()) {
+            finishTrial("计时查询失败: " + error);
+            return;
+        }
+        beforeMs = elapsed;
+        sendStep(Step::CreateIndex, trialCreateSql);
+        break;
+    case Step::CreateIndex:
+        if (!error.isEmpty()) {
+            trialIndexName.clear();
+            finishTrial("创建索引失败: " + error);
+            return;
+        }
+        createMs = elapsed;
+        sendStep(Step::TimeAfter, timingSql());
+        break;
+    case Step::TimeAfter: {
+        if (!error.isEmpty()) {
+            finishTrial("计时查询失败: " + error);
+            return;
+        }
+        QString ratio = elapsed > 0 ? QString::number(double(beforeMs) / elapsed, 'f', 1) : QString("∞");
+        resultLabel->setText(QString("无索引: %1 ms    有索引: %2 ms    (%3×)    建索引耗时: %4 ms")
+                             .arg(beforeMs).arg(elapsed).arg(ratio).arg(createMs));
+        sendStep(Step::ExplainAfter, "EXPLAIN QUERY PLAN " + statement + ";");
+        break;
+    }
+    case Step::ExplainAfter:
+        // 展示使用索引后的计划，再删除试用索引
+        if (error.isEmpty()) {
+            showPlan(IndexAdvisor::parsePlan(jsonObj));
+        }
+        sendStep(Step::DropIndex, "DROP INDEX IF EXISTS " + trialIndexName + ";");
+        break;
+    case Step::DropIndex:
+        if (!error.isEmpty()) {
+            QMessageBox::warning(this, "错误", "删除试用索引" + trialIndexName + "失败，请手动删除\n" + error);
+        }
+        trialIndexName.clear();
+        finishTrial(resultLabel->text());
+        break;
+    }
+}
+
+void QueryPlanDialog::showPlan(const QVector<PlanNode>& nodes)
+{
+    planTree->clear();
+    QMap<int, QTreeWidgetItem*> items;
+    for (const PlanNode& node : nodes) {
+        QTreeWidgetItem* parentItem = items.value(node.parent);
+        QTreeWidgetItem* item = parentItem ? new QTreeWidgetItem(parentItem) : new QTreeWidgetItem(planTree);
+        item->setText(0, node.detail);
+        if (IndexAdvisor::isFullScan(node.detail)) {
+            item->setForeground(0, Qt::red);
+            item->setToolTip(0, "全表扫描");
+        } else if (IndexAdvisor::isTempBTree(node.detail)) {
+            item->setForeground(0, QColor(230, 130, 0));
+            item->setToolTip(0, "需要临时B树排序");
+        }
+        items[node.id] = item;
+    }
+    planTree->expandAll();
+}
+
+void QueryPlanDialog::updateSuggestions()
+{
+    suggestionTable->setRowCount(0);
+    if (!schemaCache->isLoaded()) {
+        resultLabel->setText("正在加载表结构...");
+        return;
+    }
+
+    suggestions = IndexAdvisor::suggest(statement, plan, *schemaCache);
+    suggestionTable->setRowCount(suggestions.size());
+    for (int i = 0; i < suggestions.size(); ++i) {
+        suggestionTable->setItem(i, 0, new QTableWidgetItem(suggestions[i].createSql));
+        suggestionTable->setItem(i, 1, new QTableWidgetItem(suggestions[i].reason));
+    }
+    if (suggestions.isEmpty()) {
+        resultLabel->setText("没有发现需要补充的索引");
+    } else {
+        resultLabel->clear();
+        suggestionTable->selectRow(0);
+    }
+}
+
+void QueryPlanDialog::onSchemaLoaded()
+{
+    if (!plan.isEmpty()) {
+        updateSuggestions();
+    }
+}
+
+void QueryPlanDialog::onTryIndexClicked()
+{
+    int row = suggestionTable->currentRow();
+    if (row < 0 || row >= suggestions.size() || !pendingSteps.isEmpty()) {
+        return;
+    }
+    // 只对只读查询计时，避免重复执行写操作
+    if (!SqlProcessHandler::isIdempotentSql(statement)) {
+        QMessageBox::information(this, "提示", "仅支持对只读查询试用索引");
+        return;
+    }
+
+    // 用临时名字建索引，避免与用户随后真正创建的索引冲突
+    trialIndexName = QString("rsqlite_trial_%1").arg(QDateTime::currentMSecsSinceEpoch());
+    trialCreateSql = IndexAdvisor::createIndexSql(trialIndexName, suggestions[row].table, suggestions[row].columns);
+    tryButton->setEnabled(false);
+    resultLabel->setText("正在试用索引 " + suggestions[row].createSql + " ...");
+    sendStep(Step::TimeBefore, timingSql());
+}
+
+void QueryPlanDialog::finishTrial(const QString& message)
+{
+    // 中途失败时也要清理已创建的试用索引
+    if (!trialIndexName.isEmpty()) {
+        sendStep(Step::DropIndex, "DROP INDEX IF EXISTS " + trialIndexName + ";");
+        resultLabel->setText(message);
+        return;
+    }
+    resultLabel->setText(message);
+    tryButton->setEnabled(!suggestionTable->selectedItems().isEmpty());
+}
+
+void QueryPlanDialog::onCopyClicked()
+{
+    int row = suggestionTable->currentRow();
+    if (row >= 0 && row < suggestions.size()) {
+        QApplication::clipboard()->setText(suggestions[row].createSql);
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef QUERYPLANDIALOG_H
+#define QUERYPLANDIALOG_H
+
+#include <QDialog>
+#include <QTreeWidget>
+#include <QTableWidget>
+#include <QPushButton>
+#include <QLabel>
+#include <QMap>
+#include <QElapsedTimer>
+#include "sqlprocesshandler.h"
+#include "schemacache.h"
+#include "indexadvisor.h"
+
+/**
+ * @brief 查询计划查看对话框
+ * 以树形展示EXPLAIN QUERY PLAN，标出全表扫描和临时B树，列出候选索引，
+ * 并可临时建立索引对比前后耗时，试用结束后自动删除该索引
+ */
+class QueryPlanDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    QueryPlanDialog(SqlProcessHandler* handler, SchemaCache* schema, const QString& statement,
+                    QWidget *parent = nullptr);
+    ~QueryPlanDialog();
+
+private slots:
+    void onResponseReceived(quint64 requestId, const QByteArray& data);
+    void onSchemaLoaded();
+    void onTryIndexClicked();
+    void onCopyClicked();
+
+private:
+    // 试用索引的各个步骤
+    enum class Step { Explain, TimeBefore, CreateIndex, TimeAfter, ExplainAfter, DropIndex };
+
+    SqlProcessHandler* sqlHandler;
+    SchemaCache* schemaCache;
+    QString statement;
+    QVector<PlanNode> plan;
+    QVector<IndexSuggestion> suggestions;
+
+    QMap<quint64, Step> pendingSteps;
+    QElapsedTimer stepTimer;
+    qint64 beforeMs;
+    qint64 createMs;
+    QString trialIndexName;
+    QString trialCreateSql;
+
+    QLabel* statementLabel;
+    QTreeWidget* planTree;
+    QTableWidget* suggestionTable;
+    QPushButton* tryButton;
+    QPushButton* copyButton;
+    QPushButton* closeButton;
+    QLabel* resultLabel;
+
+    void setupUI();
+    void sendStep(Step step, const QString& sql);
+    void showPlan(const QVector<PlanNode>& nodes);
+    void updateSuggestions();
+    void finishTrial(const QString& message);
+    QString timingSql() const;
+};
+
+#endif // QUERYPLANDIALOG_H
@@ -0,0 +1,63 @@
+#include "recentconnections.h"
+#include <QSettings>
+#include <QFileInfo>
+
+QVector<ConnectionProfile> RecentConnections::load()
+{
+    QVector<ConnectionProfile> profiles;
+    QSettings settings;
+    int count = settings.beginReadArray("recentConnections");
+    for (int i = 0; i < count; ++i) {
+        settings.setArrayIndex(i);
+        ConnectionProfile profile;
+        profile.ip = settings.value("ip").toString();
+        profile.port = static_cast<quint16>(settings.value("port").toUInt());
+        profile.dbPath = settings.value("dbPath").toString();
+        if (profile.isValid()) {
+            profiles << profile;
+        }
+    }
+    settings.endArray();
+    return profiles;
+}
+
+void RecentConnections::remember(const ConnectionProfile& profile)
+{
+    if (!profile.isValid()) {
+        return;
+    }
+    QVector<ConnectionProfile> profiles;
+    profiles << profile;
+    for (const ConnectionProfile& other : load()) {
+        bool same = other.ip == profile.ip && other.port == profile.port && other.dbPath == profile.dbPath;
+        if (!same && profiles.size() < capacity()) {
+            profiles << other;
+        }
+    }
+
+    QSettings settings;
+    settings.remove("recentConnections");
+    settings.beginWriteArray("recentConnections", profiles.size());
+    for (int i = 0; i < profiles.size(); ++i) {
+        settings.setArrayIndex(i);
+        settings.setValue("ip", profiles[i].ip);
+        settings.setValue("port", profiles[i].port);
+        settings.setValue("dbPath", profiles[i].dbPath);
+    }
+    settings.endArray();
+}
+
+int RecentConnections::capacity()
+{
+    return qMax(1, QSettings().value("connection/recentCount", 5).toInt());
+}
+
+bool RecentConnections::warmStartEnabled()
+{
+    return QSettings().value("connection/warmStart", true).toBool();
+}
+
+QString RecentConnections::displayName(const ConnectionProfile& profile)
+{
+    return QString("%1:%2 %3").arg(profile.ip).arg(profile.port).arg(QFileInfo(profile.dbPath).fileName());
+}
@@ -0,0 +1,32 @@
+#ifndef RECENTCONNECTIONS_H
+#define RECENTCONNECTIONS_H
+
+#include <QVector>
+#include "connectionprofile.h"
+
+/**
+ * @brief 最近成功连接过的数据库
+ * 保存在QSettings中，最近的在前，同一服务器上的同一数据库只保留一条。
+ * 连接对话框用于快速选择，启动时在后台预连接最近的一个
+ */
+class RecentConnections
+{
+public:
+    static QVector<ConnectionProfile> load();
+
+    /**
+     * @brief 记下一次成功的连接，移到最前，超出条数的丢弃
+     */
+    static void remember(const ConnectionProfile& profile);
+
+    // QSettings中的键与默认值
+    static int capacity();
+    static bool warmStartEnabled();
+
+    /**
+     * @brief 在列表中显示的名称
+     */
+    static QString displayName(const ConnectionProfile& profile);
+};
+
+#endif // RECENTCONNECTIONS_H
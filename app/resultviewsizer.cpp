@@ -0,0 +1,140 @@
+#include "resultviewsizer.h"
+#include <QHeaderView>
+#include <QScrollBar>
+#include <QAbstractItemModel>
+#include <QFontMetrics>
+
+// 单元格左右留白
+static const int CELL_PADDING = 16;
+
+ResultViewSizer::ResultViewSizer(QTableView* view, QObject *parent)
+    : QObject(parent), view(view), sampleRows(200), maxColumnWidth(400)
+{
+    // 滚动停止后再修正可见行，避免快速滚动时反复测量
+    refineTimer = new QTimer(this);
+    refineTimer->setSingleShot(true);
+    refineTimer->setInterval(50);
+    connect(refineTimer, &QTimer::timeout, this, &ResultViewSizer::refineVisibleRows);
+
+    connect(view->verticalScrollBar(), &QScrollBar::valueChanged,
+            this, &ResultViewSizer::scheduleRefine);
+    connect(view->horizontalScrollBar(), &QScrollBar::valueChanged,
+            this, &ResultViewSizer::scheduleRefine);
+}
+
+int ResultViewSizer::textWidth(const QString& text) const
+{
+    // 多行文本只按最长的一行计算宽度
+    const QFontMetrics metrics = view->fontMetrics();
+    int width = 0;
+    for (const QString& line : text.split('\n')) {
+        width = qMax(width, metrics.horizontalAdvance(line));
+    }
+    return width + CELL_PADDING;
+}
+
+int ResultViewSizer::cellWidth(int row, int column) const
+{
+    QAbstractItemModel* model = view->model();
+    return textWidth(model->data(model->index(row, column)).toString());
+}
+
+void ResultViewSizer::fitToContents()
+{
+    QAbstractItemModel* model = view->model();
+    if (!model) {
+        return;
+    }
+
+    // 连接模型信号，模型重置后清空已测量记录
+    disconnect(model, &QAbstractItemModel::modelReset, this, &ResultViewSizer::onModelReset);
+    connect(model, &QAbstractItemModel::modelReset, this, &ResultViewSizer::onModelReset);
+
+    const int rowCount = model->rowCount();
+    const int columnCount = model->columnCount();
+    measuredRows = QBitArray(rowCount);
+
+    // 统一行高，不逐行测量
+    view->verticalHeader()->setDefaultSectionSize(view->fontMetrics().height() + 10);
+
+    // 抽样：前半取开头的行，后半在整个结果中等距抽取
+    QVector<int> samples;
+    const int headCount = qMin(rowCount, sampleRows / 2);
+    for (int row = 0; row < headCount; ++row) {
+        samples << row;
+    }
+    const int strideCount = qMin(rowCount - headCount, sampleRows - headCount);
+    for (int i = 0; i < strideCount; ++i) {
+        samples << headCount + static_cast<int>(static_cast<qint64>(rowCount - headCount) * i / strideCount);
+    }
+
+    QHeaderView* header = view->horizontalHeader();
+    for (int column = 0; column < columnCount; ++column) {
+        int width = textWidth(model->headerData(column, Qt::Horizontal).toString());
+        for (int row : samples) {
+            width = qMax(width, cellWidth(row, column));
+        }
+        header->resizeSection(column, qMin(width, maxColumnWidth));
+    }
+
+    refineVisibleRows();
+}
+
+void ResultViewSizer::scheduleRefine()
+{
+    refineTimer->start();
+}
+
+void ResultViewSizer::onModelReset()
+{
+    measuredRows.clear();
+}
+
+void ResultViewSizer::refineVisibleRows()
+{
+    QAbstractItemModel* model = view->model();
+    if (!model || model->rowCount() == 0) {
+        return;
+    }
+    if (measuredRows.size() != model->rowCount()) {
+        measuredRows.resize(model->rowCount());
+    }
+
+    int first = view->rowAt(0);
+    int last = view->rowAt(view->viewport()->height() - 1);
+    if (first < 0) {
+        return;
+    }
+    if (last < 0) {
+        last = model->rowCount() - 1;
+    }
+
+    for (int row = first; row <= last; ++row) {
+        if (!measuredRows.testBit(row)) {
+            measureRow(row);
+            measuredRows.setBit(row);
+        }
+    }
+}
+
+void ResultViewSizer::measureRow(int row)
+{
+    QAbstractItemModel* model = view->model();
+    QHeaderView* header = view->horizontalHeader();
+    bool multiLine = false;
+
+    // 只放宽不收窄，避免用户滚动时列宽来回跳动
+    for (int column = 0; column < model->columnCount(); ++column) {
+        const QString text = model->data(model->index(row, column)).toString();
+        multiLine = multiLine || text.contains('\n');
+        int width = qMin(textWidth(text), maxColumnWidth);
+        if (width > header->sectionSize(column)) {
+            header->resizeSection(column, width);
+        }
+    }
+
+    // 仅多行文本需要单独调整行高
+    if (multiLine) {
+        view->resizeRowToContents(row);
+    }
+}
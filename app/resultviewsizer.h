@@ -0,0 +1,47 @@
+#ifndef RESULTVIEWSIZER_H
+#define RESULTVIEWSIZER_H
+
+#include <QObject>
+#include <QTableView>
+#include <QTimer>
+#include <QBitArray>
+
+/**
+ * @brief 结果表格的列宽/行高估算器
+ * resizeColumnsToContents/resizeRowsToContents会测量全部单元格，大结果集下耗时随行数增长。
+ * 这里只按表头和有限的抽样行估算列宽，行高统一使用默认值，
+ * 之后在行滚动进可见区域时再按需修正，加载耗时与行数无关。
+ */
+class ResultViewSizer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ResultViewSizer(QTableView* view, QObject *parent = nullptr);
+
+    /**
+     * @brief 数据加载完成后调用，按表头和抽样行估算列宽并统一行高
+     */
+    void fitToContents();
+
+    void setSampleRows(int rows) { sampleRows = rows; }
+    void setMaxColumnWidth(int width) { maxColumnWidth = width; }
+
+private slots:
+    void scheduleRefine();
+    void refineVisibleRows();
+    void onModelReset();
+
+private:
+    QTableView* view;
+    QTimer* refineTimer;
+    QBitArray measuredRows;     // 已修正过的行，避免重复测量
+    int sampleRows;             // 估算列宽时最多抽样的行数
+    int maxColumnWidth;         // 估算出的列宽上限，超长文本不撑满屏幕
+
+    int textWidth(const QString& text) const;
+    int cellWidth(int row, int column) const;
+    void measureRow(int row);
+};
+
+#endif // RESULTVIEWSIZER_H
@@ -0,0 +1,87 @@
+#include "scriptfiledialog.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFileInfo>
+#include <QMessageBox>
+
+ScriptFileDialog::ScriptFileDialog(SqlProcessHandler* handler, QWidget *parent)
+    : QDialog(parent, Qt::Window | Qt::WindowCloseButtonHint)
+{
+    fileRunner = new ScriptFileRunner(handler, this);
+
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+    mainLayout->setSpacing(10);
+    mainLayout->setContentsMargins(20, 20, 20, 20);
+
+    fileLabel = new QLabel(this);
+    progressBar = new QProgressBar(this);
+    progressBar->setRange(0, 1000);
+    statementLabel = new QLabel(this);
+    mainLayout->addWidget(fileLabel);
+    mainLayout->addWidget(progressBar);
+    mainLayout->addWidget(statementLabel);
+
+    QHBoxLayout* buttonLayout = new QHBoxLayout();
+    stopButton = new QPushButton("停止", this);
+    stopButton->setToolTip("当前批次执行完成后停止");
+    closeButton = new QPushButton("关闭", this);
+    closeButton->setEnabled(false);
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(stopButton);
+    buttonLayout->addWidget(closeButton);
+    mainLayout->addLayout(buttonLayout);
+
+    connect(fileRunner, &ScriptFileRunner::progress, this, &ScriptFileDialog::onProgress);
+    connect(fileRunner, &ScriptFileRunner::finished, this, &ScriptFileDialog::onFinished);
+    connect(stopButton, &QPushButton::clicked, fileRunner, &ScriptFileRunner::stop);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::accept);
+
+    setWindowTitle("执行SQL文件");
+    resize(700, 180);
+}
+
+bool ScriptFileDialog::start(const QString& path)
+{
+    QString error;
+    if (!fileRunner->start(path, &error)) {
+        QMessageBox::warning(this, "错误", "无法打开文件：" + path + "\n" + error);
+        return false;
+    }
+    fileLabel->setText(QString("%1  (%2 MB)").arg(QFileInfo(path).fileName())
+                       .arg(fileRunner->totalBytes() / 1048576.0, 0, 'f', 1));
+    statementLabel->setText("正在读取...");
+    return true;
+}
+
+void ScriptFileDialog::reject()
+{
+    // 执行中关闭窗口等同于停止，避免留下不知是否执行的批次
+    if (fileRunner->isRunning()) {
+        fileRunner->stop();
+        return;
+    }
+    QDialog::reject();
+}
+
+void ScriptFileDialog::onProgress(qint64 bytesRead, int statementsDone, int statementsRead)
+{
+    const qint64 total = fileRunner->totalBytes();
+    progressBar->setValue(total > 0 ? int(bytesRead * 1000 / total) : 1000);
+    statementLabel->setText(QString("已读取 %1 / %2 MB，已执行 %3 / %4 条语句")
+                            .arg(bytesRead / 1048576.0, 0, 'f', 1)
+                            .arg(total / 1048576.0, 0, 'f', 1)
+                            .arg(statementsDone)
+                            .arg(statementsRead));
+}
+
+void ScriptFileDialog::onFinished(bool ok, const QString& message)
+{
+    stopButton->setEnabled(false);
+    closeButton->setEnabled(true);
+    statementLabel->setText(message);
+    if (ok) {
+        progressBar->setValue(progressBar->maximum());
+    } else {
+        QMessageBox::warning(this, "执行SQL文件", message);
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef SCRIPTFILEDIALOG_H
+#define SCRIPTFILEDIALOG_H
+
+#include <QDialog>
+#include <QLabel>
+#include <QProgressBar>
+#include <QPushButton>
+#include "scriptfilerunner.h"
+
+/**
+ * @brief 执行SQL文件的进度对话框
+ * 文件不载入编辑器，由ScriptFileRunner分块读取、分批执行，显示字节与语句进度
+ */
+class ScriptFileDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    ScriptFileDialog(SqlProcessHandler* handler, QWidget *parent = nullptr);
+
+    /**
+     * @brief 开始执行文件，无法打开时提示并返回false
+     */
+    bool start(const QString& path);
+
+    ScriptFileRunner* runner() const { return fileRunner; }
+
+protected:
+    void reject() override;
+
+private slots:
+    void onProgress(qint64 bytesRead, int statementsDone, int statementsRead);
+    void onFinished(bool ok, const QString& message);
+
+private:
+    ScriptFileRunner* fileRunner;
+    QLabel* fileLabel;
+    QProgressBar* progressBar;
+    QLabel* statementLabel;
+    QPushButton* stopButton;
+    QPushButton* closeButton;
+};
+
+#endif // SCRIPTFILEDIALOG_H
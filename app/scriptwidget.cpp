@@ -0,0 +1,325 @@
+#include "scriptwidget.h"
+#include <QMessageBox>
+#include <QRegularExpression>
+#include "sqlsplitter.h"
+#include "queryplandialog.h"
+#include "queryhistory.h"
+#include "resultsnapshot.h"
+#include <QFileDialog>
+#include <QtConcurrent>
+
+ScriptWidget::ScriptWidget(SqlProcessHandler* handler, SchemaCache* schema, QWidget *parent)
+    : QWidget(parent), sqlHandler(handler), schemaCache(schema), executeRequestId(0), executeChangesSchema(false)
+{
+    tableModel = new ResultTableModel(this);
+    proxyModel = new ResultProxyModel(this);
+    proxyModel->setSourceModel(tableModel);
+    snapshotWatcher = new QFutureWatcher<QString>(this);
+    setupUI();
+    initConnections();
+}
+
+ScriptWidget::~ScriptWidget()
+{
+}
+
+void ScriptWidget::setupUI()
+{
+    // 创建主垂直布局
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+    mainLayout->setSpacing(10);  // 设置控件间距
+    mainLayout->setContentsMargins(20, 20, 20, 20);  // 设置边距
+    
+    // 1. 创建文本编辑器
+    scriptEdit = new QTextEdit(this);
+    scriptEdit->setMinimumSize(1500, 400);  // 设置最小尺寸
+    scriptEdit->setFont(QFont("Consolas", 11));
+    scriptEdit->setPlaceholderText("请输入SQL语句...");
+    mainLayout->addWidget(scriptEdit);
+    
+    // 2. 创建按钮水平布局
+    QHBoxLayout* buttonLayout = new QHBoxLayout();
+    buttonLayout->setContentsMargins(0, 0, 0, 0);
+    
+    executeBtn = new QPushButton("执行", this);
+    clearBtn = new QPushButton("清除", this);
+    explainBtn = new QPushButton("解释", this);
+    explainBtn->setToolTip("查看选中语句或光标所在语句的查询计划");
+    
+    // 设置按钮最小高度
+    executeBtn->setMinimumHeight(80);
+    clearBtn->setMinimumHeight(80);
+    explainBtn->setMinimumHeight(80);
+    executeBtn->setMinimumWidth(120);
+    clearBtn->setMinimumWidth(120);
+    explainBtn->setMinimumWidth(120);
+    
+    // 设置按钮样式
+    QString buttonStyle = "QPushButton { font-size: 14px; }";
+    executeBtn->setStyleSheet(buttonStyle);
+    clearBtn->setStyleSheet(buttonStyle);
+    explainBtn->setStyleSheet(buttonStyle);
+    
+    // 添加弹性空间使按钮靠右
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(explainBtn);
+    buttonLayout->addWidget(executeBtn);
+    buttonLayout->addWidget(clearBtn);
+    
+    // 创建一个容器widget来容纳按钮布局，并设置最小高度
+    QWidget* buttonContainer = new QWidget(this);
+    buttonContainer->setMinimumHeight(100);
+    buttonContainer->setLayout(buttonLayout);
+    mainLayout->addWidget(buttonContainer);
+    
+    // 3. 创建结果筛选栏
+    QHBoxLayout* filterLayout = new QHBoxLayout();
+    filterEdit = new QLineEdit(this);
+    filterEdit->setPlaceholderText("筛选结果(不区分大小写的子串)...");
+    filterEdit->setClearButtonEnabled(true);
+    regexCheck = new QCheckBox("正则", this);
+    statusLabel = new QLabel(this);
+    saveSnapshotBtn = new QPushButton("保存快照", this);
+    saveSnapshotBtn->setToolTip("把当前结果保存为快照文件，之后可以不连接服务器直接打开");
+    saveSnapshotBtn->setEnabled(false);
+    filterLayout->addWidget(filterEdit);
+    filterLayout->addWidget(regexCheck);
+    filterLayout->addStretch();
+    filterLayout->addWidget(statusLabel);
+    filterLayout->addWidget(saveSnapshotBtn);
+    mainLayout->addLayout(filterLayout);
+
+    // 输入停顿后再筛选
+    filterTimer = new QTimer(this);
+    filterTimer->setSingleShot(true);
+    filterTimer->setInterval(200);
+
+    // 4. 创建表格视图
+    resultView = new QTableView(this);
+    resultView->setMinimumSize(1500, 500);
+    resultView->setHorizontalScrollMode(QAbstractItemView::ScrollPerPixel);  // 水平滚动
+    resultView->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);    // 垂直滚动
+    resultView->horizontalHeader()->setStretchLastSection(false);            // 不拉伸最后一列
+    resultView->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive); // 允许调整列宽
+    resultView->verticalHeader()->setSectionResizeMode(QHeaderView::Interactive);   // 允许调整行高
+    resultView->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);          // 需要时显示垂直滚动条
+    resultView->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);        // 需要时显示水平滚动条
+    resultView->setModel(proxyModel);
+    resultView->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
+    resultView->setSortingEnabled(true);                                     // 点击表头在客户端排序
+    mainLayout->addWidget(resultView);
+    viewSizer = new ResultViewSizer(resultView, this);
+    
+    // 设置窗口属性
+    setWindowTitle("SQL脚本执行");
+    setMinimumWidth(1600);  // 设置窗口最小宽度，略大于内部控件
+}
+
+void ScriptWidget::initConnections()
+{
+    connect(executeBtn, &QPushButton::clicked, this, &ScriptWidget::onExecuteClicked);
+    connect(clearBtn, &QPushButton::clicked, this, &ScriptWidget::onClearClicked);
+    connect(explainBtn, &QPushButton::clicked, this, &ScriptWidget::onExplainClicked);
+    // 只处理本窗口发出的请求，结构加载、查询计划等请求的结果不会混入
+    connect(sqlHandler, &SqlProcessHandler::responseReceived, this, &ScriptWidget::onResponseReceived);
+    connect(filterEdit, &QLineEdit::textChanged, filterTimer, static_cast<void(QTimer::*)()>(&QTimer::start));
+    connect(regexCheck, &QCheckBox::toggled, this, &ScriptWidget::onFilterChanged);
+    connect(filterTimer, &QTimer::timeout, this, &ScriptWidget::onFilterChanged);
+    connect(proxyModel, &ResultProxyModel::mappingApplied, this, &ScriptWidget::onMappingApplied);
+    connect(saveSnapshotBtn, &QPushButton::clicked, this, &ScriptWidget::onSaveSnapshotClicked);
+    connect(snapshotWatcher, &QFutureWatcher<QString>::finished, this, &ScriptWidget::onSnapshotSaved);
+    connect(tableModel, &QAbstractItemModel::modelReset, this, [this]() {
+        saveSnapshotBtn->setEnabled(!tableModel->store().isEmpty() && !snapshotWatcher->isRunning());
+    });
+}
+
+void ScriptWidget::onExecuteClicked()
+{
+    QString script = scriptEdit->toPlainText().trimmed();
+    if(script.isEmpty()) {
+        return;
+    }
+    
+    // 清空现有表格数据
+    tableModel->clear();
+    
+    // 执行SQL，记下请求ID以便匹配返回数据
+    executeScript = script;
+    executeTimer.start();
+    executeRequestId = sqlHandler->execSql(script);
+    static const QRegularExpression ddl("\\b(CREATE|DROP|ALTER)\\b", QRegularExpression::CaseInsensitiveOption);
+    executeChangesSchema = ddl.match(script).hasMatch();
+}
+
+void ScriptWidget::onResponseReceived(quint64 requestId, const QByteArray& data)
+{
+    if (requestId != executeRequestId) {
+        return;
+    }
+    executeRequestId = 0;
+
+    // 流式解码，不构造完整的QJsonDocument，超出内存预算的行溢出到磁盘
+    QJsonObject jsonObj;
+    bool ok = false;
+    ResultStore store = ResultStore::fromResponse(data, &jsonObj, &ok);
+
+    // 记入本地查询历史。脚本作为一条请求执行，服务端只给出一次应答，整段脚本记为一条；
+    // 逐条发送能得到每条语句的耗时，但每条语句都要多一次往返
+    const ConnectionProfile profile = sqlHandler->connectionProfile();
+    QueryHistory::getInstance()->record(QString("%1:%2").arg(profile.ip).arg(profile.port), profile.dbPath,
+                                        executeScript, executeTimer.elapsed(), store.rowCount(),
+                                        data.size(), ok && jsonObj["status"].toInt() == 0);
+
+    if (!ok) {
+        QMessageBox::warning(this, "错误", "返回数据格式错误\n" + QString::fromUtf8(data));
+        return;
+    }
+    
+    // 创建 TableData 对象并填充数据
+    TableData tableData;
+    
+    // 设置状态和息
+    tableData.setStatus(jsonObj["status"].toInt());
+    tableData.setMsg(jsonObj["msg"].toString());
+
+    QJsonObject columns = jsonObj["columns"].toObject();
+    // 执行了DDL时重新加载表结构缓存
+    if (executeChangesSchema) {
+        schemaCache->refresh();
+    }
+    if(tableData.getStatus() != 0) {
+        QMessageBox::warning(this, "错误", tableData.getMsg());
+        return;
+    }else{
+        // 成功
+        
+        if(columns.isEmpty()){
+            QMessageBox::information(this, "提示", tableData.getMsg());
+            return;
+        }
+    }
+
+    // 更新表格视图
+    updateTableView(store);
+}
+
+QString ScriptWidget::currentStatement() const
+{
+    QTextCursor cursor = scriptEdit->textCursor();
+    if (cursor.hasSelection()) {
+        // selectedText中的换行为U+2029
+        return cursor.selectedText().replace(QChar::ParagraphSeparator, '\n').trimmed();
+    }
+
+    // 没有选中时取光标所在的语句，光标在语句之间则取前一条
+    QVector<SqlStatement> statements = SqlSplitter::split(scriptEdit->toPlainText());
+    int position = cursor.position();
+    QString result;
+    for (const SqlStatement& statement : statements) {
+        if (statement.begin > position) {
+            break;
+        }
+        result = statement.text;
+        if (position <= statement.end) {
+            break;
+        }
+    }
+    if (result.isEmpty() && !statements.isEmpty()) {
+        result = statements.first().text;
+    }
+    return result;
+}
+
+void ScriptWidget::onExplainClicked()
+{
+    QString statement = currentStatement();
+    if (statement.isEmpty()) {
+        return;
+    }
+
+    QueryPlanDialog* dialog = new QueryPlanDialog(sqlHandler, schemaCache, statement, this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    dialog->show();
+}
+
+void ScriptWidget::updateTableView(const ResultStore& store)
+{
+    if (store.isEmpty()) {
+        tableModel->clear();
+        QMessageBox::information(this, "提示", "查询结果为空");
+        return;
+    }
+
+    // 直接交给模型，不再逐个创建单元格
+    tableModel->setStore(store);
+
+    // 按表头和抽样行估算列宽，可见行滚动到时再修正
+    viewSizer->fitToContents();
+}
+
+void ScriptWidget::onFilterChanged()
+{
+    // 新的输入会取消尚未完成的筛选
+    proxyModel->setFilter(filterEdit->text(), regexCheck->isChecked());
+}
+
+void ScriptWidget::onMappingApplied(int visibleRows, qint64 elapsedMs)
+{
+    statusLabel->setText(QString("%1 / %2 行  (%3 ms)")
+                         .arg(visibleRows)
+                         .arg(tableModel->rowCount())
+                         .arg(elapsedMs));
+}
+
+void ScriptWidget::onSaveSnapshotClicked()
+{
+    if (tableModel->store().isEmpty() || snapshotWatcher->isRunning()) {
+        return;
+    }
+    QString path = QFileDialog::getSaveFileName(this, "保存结果快照", QString(), "结果快照 (*.rsnap)");
+    if (path.isEmpty()) {
+        return;
+    }
+    if (!path.endsWith(".rsnap", Qt::CaseInsensitive)) {
+        path += ".rsnap";
+    }
+
+    // 存储拷贝只增加引用计数，后台写文件不受界面后续修改影响
+    ResultStore store = tableModel->store();
+    saveSnapshotBtn->setEnabled(false);
+    statusLabel->setText("正在保存快照...");
+    snapshotWatcher->setFuture(QtConcurrent::run([store, path]() {
+        QString error;
+        ResultSnapshot::save(store, path, &error);
+        return error;
+    }));
+}
+
+void ScriptWidget::onSnapshotSaved()
+{
+    const QString error = snapshotWatcher->result();
+    saveSnapshotBtn->setEnabled(!tableModel->store().isEmpty());
+    if (!error.isEmpty()) {
+        statusLabel->clear();
+        QMessageBox::warning(this, "错误", "保存快照失败：" + error);
+        return;
+    }
+    statusLabel->setText("快照已保存");
+}
+
+void ScriptWidget::onClearClicked()
+{
+    scriptEdit->clear();
+    tableModel->clear();
+}
+
+void ScriptWidget::releaseResults()
+{
+    tableModel->clear();
+    statusLabel->setText("结果已释放，重新执行以查看");
+}
+
+void ScriptWidget::setScriptContent(const QString& content)
+{
+    scriptEdit->setText(content);
+}
@@ -0,0 +1,84 @@
+#ifndef SCRIPTWIDGET_H
+#define SCRIPTWIDGET_H
+
+#include <QWidget>
+#include <QTextEdit>
+#include <QPushButton>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QTableView>
+#include <QLineEdit>
+#include <QCheckBox>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QHeaderView>
+#include <QFutureWatcher>
+#include "sqlprocesshandler.h"
+#include "tabledata.h"
+#include "resulttablemodel.h"
+#include "resultproxymodel.h"
+#include "resultviewsizer.h"
+#include "schemacache.h"
+
+namespace Ui {
+class ScriptWidget;
+}
+
+class ScriptWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    ScriptWidget(SqlProcessHandler* handler, SchemaCache* schema, QWidget *parent = nullptr);
+    ~ScriptWidget();
+    
+    void setScriptContent(const QString& content);
+
+    /**
+     * @brief 释放结果集以回收内存，编辑中的脚本保留
+     */
+    void releaseResults();
+
+private:
+    QTextEdit* scriptEdit;
+    QPushButton* executeBtn;
+    QPushButton* clearBtn;
+    QPushButton* explainBtn;
+    QTableView* resultView;
+    ResultViewSizer* viewSizer;
+    SqlProcessHandler *sqlHandler;
+    SchemaCache* schemaCache;
+    quint64 executeRequestId;       // 当前执行请求的ID，0表示没有
+    bool executeChangesSchema;      // 当前执行的脚本包含DDL
+    QString executeScript;          // 当前执行的脚本，写入查询历史
+    QElapsedTimer executeTimer;
+    ResultTableModel* tableModel;
+    ResultProxyModel* proxyModel;
+    QLineEdit* filterEdit;
+    QCheckBox* regexCheck;
+    QLabel* statusLabel;
+    QTimer* filterTimer;
+    QPushButton* saveSnapshotBtn;
+    QFutureWatcher<QString>* snapshotWatcher;   // 后台保存快照，结果为错误信息
+    
+    void setupUI();
+    void initConnections();
+    void updateTableView(const ResultStore& store);
+    QString currentStatement() const;
+
+private slots:
+    void onExecuteClicked();
+    void onClearClicked();
+    void onExplainClicked();
+    void onResponseReceived(quint64 requestId, const QByteArray& data);
+    void onFilterChanged();
+    void onMappingApplied(int visibleRows, qint64 elapsedMs);
+    void onSaveSnapshotClicked();
+    void onSnapshotSaved();
+};
+
+#endif // SCRIPTWIDGET_H
@@ -0,0 +1,87 @@
+#include "scrollprefetcher.h"
+#include "resultspillfile.h"
+#include <QScrollBar>
+#include <QThread>
+#include <QtConcurrent>
+
+namespace {
+
+// 滚动停顿多久后预取
+const int scrollSettleMs = 50;
+
+} // namespace
+
+ScrollPrefetcher::ScrollPrefetcher(QTableView* view, ResultProxyModel* proxy, QObject *parent)
+    : QObject(parent), view(view), proxy(proxy), generation(new QAtomicInt(0)),
+      lastValue(0), scrollingDown(true), lookaheadScreens(2)
+{
+    pool.setMaxThreadCount(1);
+
+    scrollTimer = new QTimer(this);
+    scrollTimer->setSingleShot(true);
+    scrollTimer->setInterval(scrollSettleMs);
+    connect(scrollTimer, &QTimer::timeout, this, &ScrollPrefetcher::prefetch);
+    connect(view->verticalScrollBar(), &QScrollBar::valueChanged, this, &ScrollPrefetcher::onScrolled);
+}
+
+ScrollPrefetcher::~ScrollPrefetcher()
+{
+    // 作废排队中的预取，等待正在解码的一页完成
+    generation->ref();
+    pool.clear();
+    pool.waitForDone();
+}
+
+void ScrollPrefetcher::onScrolled(int value)
+{
+    scrollingDown = value >= lastValue;
+    lastValue = value;
+    generation->ref();
+    scrollTimer->start();
+}
+
+void ScrollPrefetcher::prefetch()
+{
+    ResultTableModel* model = proxy->resultModel();
+    if (!model || model->store().allRowsInMemory()) {
+        return;
+    }
+
+    const int rowCount = proxy->rowCount();
+    int first = view->rowAt(0);
+    int last = view->rowAt(view->viewport()->height() - 1);
+    if (first < 0 || rowCount == 0) {
+        return;
+    }
+    if (last < 0) {
+        last = rowCount - 1;
+    }
+
+    // 沿滚动方向取下几屏的行，映射到源模型(排序后源行号不连续)
+    const int span = (last - first + 1) * lookaheadScreens;
+    const int begin = scrollingDown ? last + 1 : qMax(0, first - span);
+    const int end = scrollingDown ? qMin(rowCount, last + 1 + span) : first;
+    QVector<int> rows;
+    rows.reserve(end - begin);
+    for (int row = begin; row < end; ++row) {
+        rows << proxy->mapToSource(proxy->index(row, 0)).row();
+    }
+
+    // 在界面线程换算成溢出文件的行号，后台只持有溢出文件：
+    // 复制整个结果会让预取期间界面线程上的修改深拷贝内存中的列
+    const QVector<int> fileRows = model->store().spillFileRows(rows);
+    const QSharedPointer<ResultSpillFile> spill = model->store().spillFile();
+    if (fileRows.isEmpty() || !spill) {
+        return;
+    }
+    const QSharedPointer<QAtomicInt> counter = generation;
+    const int expected = generation->load();
+    pool.clear();
+    QtConcurrent::run(&pool, [spill, fileRows, counter, expected]() {
+        if (counter->load() != expected) {
+            return;
+        }
+        QThread::currentThread()->setPriority(QThread::LowPriority);
+        spill->prefetchRows(fileRows);
+    });
+}
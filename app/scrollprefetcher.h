@@ -0,0 +1,46 @@
+#ifndef SCROLLPREFETCHER_H
+#define SCROLLPREFETCHER_H
+
+#include <QObject>
+#include <QTableView>
+#include <QTimer>
+#include <QThreadPool>
+#include <QSharedPointer>
+#include <QAtomicInt>
+#include "resultproxymodel.h"
+
+/**
+ * @brief 沿滚动方向预取下一屏的溢出行
+ * 结果超出内存预算时，溢出到磁盘的行在滚动到时才按页解码。这里在滚动停顿后，
+ * 把沿滚动方向的下两屏行所在的页在后台解码进页缓存；用户又滚动到别处时，
+ * 尚未开始的预取直接作废。全部行都在内存中时不做任何事。
+ */
+class ScrollPrefetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    ScrollPrefetcher(QTableView* view, ResultProxyModel* proxy, QObject *parent = nullptr);
+    ~ScrollPrefetcher();
+
+    /**
+     * @brief 预取的屏数
+     */
+    void setLookaheadScreens(int screens) { lookaheadScreens = qMax(1, screens); }
+
+private slots:
+    void onScrolled(int value);
+    void prefetch();
+
+private:
+    QTableView* view;
+    ResultProxyModel* proxy;
+    QTimer* scrollTimer;
+    QThreadPool pool;                   // 单线程、低优先级，不占用排序/筛选的线程池
+    QSharedPointer<QAtomicInt> generation;  // 每次滚动递增，过期的预取不再执行
+    int lastValue;
+    bool scrollingDown;
+    int lookaheadScreens;
+};
+
+#endif // SCROLLPREFETCHER_H
@@ -0,0 +1,145 @@
+#include "sessionwidget.h"
+#include "keepalivedialog.h"
+#include "scriptfiledialog.h"
+#include "globalsearchdialog.h"
+#include "viewcache.h"
+#include <QFileInfo>
+#include <QMessageBox>
+#include <QDialog>
+
+SessionWidget::SessionWidget(QTcpSocket* socket, const ConnectionProfile& profile, QWidget *parent)
+    : QWidget(parent), connectionProfile(profile)
+{
+    mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(0, 0, 0, 0);
+    viewStack = new QStackedWidget(this);
+    mainLayout->addWidget(viewStack);
+
+    // 会话内的socket、处理器与结构缓存互相独立，不使用进程默认实例
+    socketManager = new SocketManager(this);
+    socketManager->setSocket(socket);
+    sqlHandler = new SqlProcessHandler(socketManager, this);
+    sqlHandler->setConnectionProfile(profile);
+    sqlHandler->setSocket(socket);
+    applyKeepAliveSettings();
+    schemaCache = new SchemaCache(sqlHandler, this);
+    schemaCache->refresh();
+
+    connect(sqlHandler, &SqlProcessHandler::connectionLost, this, &SessionWidget::onConnectionLost);
+    connect(sqlHandler, &SqlProcessHandler::reconnecting, this, &SessionWidget::onReconnecting);
+    connect(sqlHandler, &SqlProcessHandler::reconnected, this, &SessionWidget::onReconnected);
+    connect(sqlHandler, &SqlProcessHandler::reconnectFailed, this, &SessionWidget::onReconnectFailed);
+}
+
+SessionWidget::~SessionWidget()
+{
+    // 视图与会话窗口(搜索、执行文件)析构时还会用到处理器(如取消订阅、取消请求)，先于处理器释放
+    clearWidgets();
+    qDeleteAll(findChildren<QDialog*>(QString(), Qt::FindDirectChildrenOnly));
+    closeConnection();
+}
+
+QString SessionWidget::title() const
+{
+    return QString("%1:%2 %3").arg(connectionProfile.ip).arg(connectionProfile.port)
+            .arg(QFileInfo(connectionProfile.dbPath).fileName());
+}
+
+void SessionWidget::clearWidgets()
+{
+    delete scriptWidget.data();
+    delete findTableWidget.data();
+}
+
+void SessionWidget::closeConnection()
+{
+    sqlHandler->setSocket(nullptr);
+    socketManager->closeSocket();
+}
+
+void SessionWidget::showView(QWidget* view)
+{
+    viewStack->setCurrentWidget(view);
+    view->setFocus();
+    ViewCache::getInstance()->touch(view);
+}
+
+void SessionWidget::showSelfQuery()
+{
+    if (!scriptWidget) {
+        scriptWidget = new ScriptWidget(sqlHandler, schemaCache, viewStack);
+        viewStack->addWidget(scriptWidget);
+    }
+    showView(scriptWidget);
+}
+
+void SessionWidget::showScript(const QString& content)
+{
+    showSelfQuery();
+    scriptWidget->setScriptContent(content);
+}
+
+void SessionWidget::showFindTable()
+{
+    if (!findTableWidget) {
+        findTableWidget = new FindTableWidget(sqlHandler, schemaCache, viewStack);
+        viewStack->addWidget(findTableWidget);
+    }
+    showView(findTableWidget);
+}
+
+void SessionWidget::showGlobalSearch()
+{
+    GlobalSearchDialog* dialog = new GlobalSearchDialog(sqlHandler, schemaCache, connectionProfile, this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    dialog->setWindowTitle("全库搜索 - " + title());
+    dialog->show();
+}
+
+void SessionWidget::runScriptFile(const QString& path)
+{
+    ScriptFileDialog* dialog = new ScriptFileDialog(sqlHandler, this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    dialog->setWindowTitle("执行SQL文件 - " + title());
+    connect(dialog->runner(), &ScriptFileRunner::finished, this, [this, dialog]() {
+        if (dialog->runner()->changesSchema()) {
+            schemaCache->refresh();
+        }
+    });
+    if (!dialog->start(path)) {
+        dialog->deleteLater();
+        return;
+    }
+    dialog->show();
+}
+
+void SessionWidget::applyKeepAliveSettings()
+{
+    sqlHandler->setHeartbeat(KeepAliveDialog::heartbeatIntervalMs(), KeepAliveDialog::heartbeatTimeoutMs());
+    sqlHandler->setReconnectPolicy(KeepAliveDialog::reconnectMaxAttempts(), 500, 30000);
+    sqlHandler->setServerCancelEnabled(KeepAliveDialog::serverCancelEnabled());
+}
+
+void SessionWidget::onConnectionLost(const QString& reason)
+{
+    emit statusMessage(title() + " 连接中断：" + reason, 0);
+}
+
+void SessionWidget::onReconnecting(int attempt, int delayMs)
+{
+    emit statusMessage(QString("%1 连接中断，%2秒后第%3次重连...").arg(title()).arg(delayMs / 1000.0).arg(attempt), 0);
+}
+
+void SessionWidget::onReconnected()
+{
+    emit statusMessage(title() + " 已重新连接", 5000);
+}
+
+void SessionWidget::onReconnectFailed(const QString& reason)
+{
+    emit statusMessage(QString(), 0);
+    clearWidgets();
+    closeConnection();
+    emit sessionDisconnected();
+    QMessageBox::warning(this, "连接中断", title() + " 与服务器的连接已断开：" + reason);
+}
@@ -0,0 +1,92 @@
+#ifndef SESSIONWIDGET_H
+#define SESSIONWIDGET_H
+
+#include <QWidget>
+#include <QVBoxLayout>
+#include <QStackedWidget>
+#include <QPointer>
+#include <QTcpSocket>
+#include "connectionprofile.h"
+#include "socketmanager.h"
+#include "sqlprocesshandler.h"
+#include "schemacache.h"
+#include "scriptwidget.h"
+#include "findtablewidget.h"
+
+/**
+ * @brief 一个数据库会话
+ * 每个会话持有独立的socket、请求处理器、结构缓存和视图，作为主窗口的一个标签页，
+ * 多个服务器或数据库可以同时打开、互不影响
+ */
+class SessionWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    SessionWidget(QTcpSocket* socket, const ConnectionProfile& profile, QWidget *parent = nullptr);
+    ~SessionWidget();
+
+    const ConnectionProfile& profile() const { return connectionProfile; }
+    QString title() const;
+    bool isConnected() const { return sqlHandler->isConnected(); }
+
+    /**
+     * @brief 显示自定义查询页，已有时直接切回，保留编辑内容与结果
+     */
+    void showSelfQuery();
+
+    /**
+     * @brief 在脚本页中载入内容，已有脚本页时复用
+     */
+    void showScript(const QString& content);
+
+    /**
+     * @brief 显示查找表页，已有时直接切回，保留已加载的表
+     */
+    void showFindTable();
+
+    /**
+     * @brief 打开全库搜索窗口，额外的搜索连接随窗口关闭
+     */
+    void showGlobalSearch();
+
+    /**
+     * @brief 流式执行SQL文件，文件不载入编辑器
+     */
+    void runScriptFile(const QString& path);
+
+    void applyKeepAliveSettings();
+
+signals:
+    /**
+     * @brief 需要在状态栏显示的连接状态
+     */
+    void statusMessage(const QString& msg, int timeoutMs);
+
+    /**
+     * @brief 自动重连失败，会话已断开
+     */
+    void sessionDisconnected();
+
+private slots:
+    void onConnectionLost(const QString& reason);
+    void onReconnecting(int attempt, int delayMs);
+    void onReconnected();
+    void onReconnectFailed(const QString& reason);
+
+private:
+    ConnectionProfile connectionProfile;
+    SocketManager* socketManager;
+    SqlProcessHandler* sqlHandler;
+    SchemaCache* schemaCache;
+    QVBoxLayout* mainLayout;
+    QStackedWidget* viewStack;              // 切换时视图只隐藏，不销毁
+    QPointer<ScriptWidget> scriptWidget;    // 内存超出上限时可能被ViewCache淘汰
+    QPointer<FindTableWidget> findTableWidget;
+
+    void showView(QWidget* view);
+    void clearWidgets();
+    void closeConnection();
+};
+
+#endif // SESSIONWIDGET_H
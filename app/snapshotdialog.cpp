@@ -0,0 +1,83 @@
+#include "snapshotdialog.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QFileInfo>
+
+SnapshotDialog::SnapshotDialog(const QSharedPointer<ResultSnapshot>& snapshot, qint64 openMs, QWidget *parent)
+    : QDialog(parent, Qt::Window | Qt::WindowCloseButtonHint), snapshot(snapshot), openMs(openMs)
+{
+    tableModel = new ResultTableModel(this);
+    proxyModel = new ResultProxyModel(this);
+    proxyModel->setSourceModel(tableModel);
+    setupUI();
+
+    tableModel->setStore(ResultStore::fromSnapshot(snapshot));
+    viewSizer->fitToContents();
+    statusLabel->setText(summary());
+}
+
+void SnapshotDialog::setupUI()
+{
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+    mainLayout->setSpacing(10);
+    mainLayout->setContentsMargins(20, 20, 20, 20);
+
+    // 1. 筛选栏
+    QHBoxLayout* filterLayout = new QHBoxLayout();
+    filterEdit = new QLineEdit(this);
+    filterEdit->setPlaceholderText("筛选结果(不区分大小写的子串)...");
+    filterEdit->setClearButtonEnabled(true);
+    regexCheck = new QCheckBox("正则", this);
+    statusLabel = new QLabel(this);
+    filterLayout->addWidget(filterEdit);
+    filterLayout->addWidget(regexCheck);
+    filterLayout->addStretch();
+    filterLayout->addWidget(statusLabel);
+    mainLayout->addLayout(filterLayout);
+
+    filterTimer = new QTimer(this);
+    filterTimer->setSingleShot(true);
+    filterTimer->setInterval(200);
+
+    // 2. 表格视图
+    resultView = new QTableView(this);
+    resultView->setHorizontalScrollMode(QAbstractItemView::ScrollPerPixel);
+    resultView->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    resultView->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    resultView->setModel(proxyModel);
+    resultView->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
+    resultView->setSortingEnabled(true);
+    mainLayout->addWidget(resultView);
+    viewSizer = new ResultViewSizer(resultView, this);
+
+    connect(filterEdit, &QLineEdit::textChanged, filterTimer, static_cast<void(QTimer::*)()>(&QTimer::start));
+    connect(regexCheck, &QCheckBox::toggled, this, &SnapshotDialog::onFilterChanged);
+    connect(filterTimer, &QTimer::timeout, this, &SnapshotDialog::onFilterChanged);
+    connect(proxyModel, &ResultProxyModel::mappingApplied, this, &SnapshotDialog::onMappingApplied);
+
+    setWindowTitle("结果快照 - " + QFileInfo(snapshot->filePath()).fileName());
+    resize(1400, 800);
+}
+
+QString SnapshotDialog::summary() const
+{
+    return QString("%1 行  %2 列  %3  (打开 %4 ms)")
+            .arg(snapshot->rowCount())
+            .arg(snapshot->columnCount())
+            .arg(QString::number(snapshot->fileSize() / 1048576.0, 'f', 1) + " MB")
+            .arg(openMs);
+}
+
+void SnapshotDialog::onFilterChanged()
+{
+    proxyModel->setFilter(filterEdit->text(), regexCheck->isChecked());
+}
+
+void SnapshotDialog::onMappingApplied(int visibleRows, qint64 elapsedMs)
+{
+    statusLabel->setText(QString("%1 / %2 行  (%3 ms)")
+                         .arg(visibleRows)
+                         .arg(tableModel->rowCount())
+                         .arg(elapsedMs));
+}
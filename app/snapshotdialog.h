@@ -0,0 +1,46 @@
+#ifndef SNAPSHOTDIALOG_H
+#define SNAPSHOTDIALOG_H
+
+#include <QDialog>
+#include <QTableView>
+#include <QLineEdit>
+#include <QCheckBox>
+#include <QLabel>
+#include <QTimer>
+#include "resulttablemodel.h"
+#include "resultproxymodel.h"
+#include "resultviewsizer.h"
+#include "resultsnapshot.h"
+
+/**
+ * @brief 浏览已保存的结果快照
+ * 表格模型直接读取快照文件的映射，不需要连接服务器，支持客户端排序与筛选
+ */
+class SnapshotDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    SnapshotDialog(const QSharedPointer<ResultSnapshot>& snapshot, qint64 openMs, QWidget *parent = nullptr);
+
+private slots:
+    void onFilterChanged();
+    void onMappingApplied(int visibleRows, qint64 elapsedMs);
+
+private:
+    QSharedPointer<ResultSnapshot> snapshot;
+    qint64 openMs;
+    QTableView* resultView;
+    ResultTableModel* tableModel;
+    ResultProxyModel* proxyModel;
+    ResultViewSizer* viewSizer;
+    QLineEdit* filterEdit;
+    QCheckBox* regexCheck;
+    QLabel* statusLabel;
+    QTimer* filterTimer;
+
+    void setupUI();
+    QString summary() const;
+};
+
+#endif // SNAPSHOTDIALOG_H
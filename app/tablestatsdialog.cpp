@@ -0,0 +1,135 @@
+#include "tablestatsdialog.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+
+namespace {
+
+// 单元格中显示的高频值个数，其余放在提示中
+const int visibleTopValues = 3;
+
+enum StatsColumn {
+    NameColumn,
+    TypeColumn,
+    NullColumn,
+    DistinctColumn,
+    MinColumn,
+    MaxColumn,
+    TopColumn,
+    StatsColumnCount
+};
+
+QString percent(double fraction)
+{
+    return QString::number(fraction * 100, 'f', 1) + "%";
+}
+
+} // namespace
+
+TableStatsDialog::TableStatsDialog(SqlProcessHandler* handler, SchemaCache* schema, const QString& table, QWidget *parent)
+    : QDialog(parent, Qt::Window | Qt::WindowCloseButtonHint), table(table)
+{
+    collector = new TableStatsCollector(handler, schema, this);
+    setupUI();
+
+    connect(collector, &TableStatsCollector::progress, summaryLabel, &QLabel::setText);
+    connect(collector, &TableStatsCollector::finished, this, &TableStatsDialog::onFinished);
+    connect(collector, &TableStatsCollector::failed, this, &TableStatsDialog::onFailed);
+    connect(resampleButton, &QPushButton::clicked, this, &TableStatsDialog::onResample);
+
+    onResample();
+}
+
+void TableStatsDialog::setupUI()
+{
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+    mainLayout->setSpacing(10);
+    mainLayout->setContentsMargins(20, 20, 20, 20);
+
+    // 1. 概要与重新抽样
+    QHBoxLayout* topLayout = new QHBoxLayout();
+    summaryLabel = new QLabel(this);
+    resampleButton = new QPushButton("重新抽样", this);
+    topLayout->addWidget(summaryLabel);
+    topLayout->addStretch();
+    topLayout->addWidget(resampleButton);
+    mainLayout->addLayout(topLayout);
+
+    // 2. 每列一行
+    statsTable = new QTableWidget(0, StatsColumnCount, this);
+    statsTable->setHorizontalHeaderLabels({"列", "类型", "空值", "不同值(估算)", "最小值", "最大值", "高频值(样本)"});
+    statsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    statsTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    statsTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    statsTable->horizontalHeader()->setStretchLastSection(true);
+    statsTable->verticalHeader()->setVisible(false);
+    mainLayout->addWidget(statsTable);
+
+    setWindowTitle("列统计 - " + table);
+    resize(1200, 600);
+}
+
+void TableStatsDialog::onResample()
+{
+    resampleButton->setEnabled(false);
+    collector->start(table);
+}
+
+void TableStatsDialog::onFinished(const TableStats& stats)
+{
+    resampleButton->setEnabled(true);
+
+    QString rows = stats.rowCount < 0 ? QString("未知") : QString("约 %1").arg(stats.rowCount);
+    if (stats.fullScan) {
+        rows = QString::number(stats.rowCount);
+    }
+    summaryLabel->setText(QString("行数：%1 (%2)    样本：%3 行%4")
+                          .arg(rows)
+                          .arg(stats.rowCountSource)
+                          .arg(stats.sampleRows)
+                          .arg(stats.fullScan ? "，即全表" : ""));
+
+    statsTable->setRowCount(stats.columns.size());
+    for (int row = 0; row < stats.columns.size(); ++row) {
+        const ColumnStats& column = stats.columns[row];
+
+        QStringList top;
+        QStringList topTip;
+        for (int i = 0; i < column.topValues.size(); ++i) {
+            const QPair<QString, int>& value = column.topValues[i];
+            QString text = QString("%1 (%2)").arg(value.first.left(40),
+                                                  percent(stats.sampleRows > 0 ? double(value.second) / stats.sampleRows : 0));
+            if (i < visibleTopValues) {
+                top << text;
+            }
+            topTip << QString("%1 × %2").arg(value.first).arg(value.second);
+        }
+
+        QString distinct = QString::number(column.distinct);
+        if (!stats.fullScan) {
+            distinct = "≈" + distinct + (column.distinctFromIndex ? " (索引统计)" : "");
+        }
+
+        QStringList cells;
+        cells << column.name << column.type << percent(column.nullFraction) << distinct
+              << column.min << column.max << top.join(", ");
+        for (int i = 0; i < cells.size(); ++i) {
+            QTableWidgetItem* item = new QTableWidgetItem(cells[i]);
+            if ((i == MinColumn || i == MaxColumn) && !column.rangeFromIndex && !stats.fullScan) {
+                item->setToolTip("来自样本，全表的最小/最大值可能超出");
+            } else if (i == TopColumn) {
+                item->setToolTip(topTip.join('\n'));
+            } else if (i == NullColumn) {
+                item->setToolTip("样本中NULL或空串所占比例");
+            }
+            statsTable->setItem(row, i, item);
+        }
+    }
+    statsTable->resizeColumnsToContents();
+}
+
+void TableStatsDialog::onFailed(const QString& msg)
+{
+    resampleButton->setEnabled(true);
+    summaryLabel->setText("统计失败：" + msg);
+}
@@ -0,0 +1,37 @@
+#ifndef TABLESTATSDIALOG_H
+#define TABLESTATSDIALOG_H
+
+#include <QDialog>
+#include <QTableWidget>
+#include <QLabel>
+#include <QPushButton>
+#include "tablestats.h"
+
+/**
+ * @brief 一张表的列统计面板
+ * 由TableStatsCollector按随机rowid抽样在后台计算，不扫描全表；
+ * 每列显示空值比例、不同值估算、最小/最大值和高频值
+ */
+class TableStatsDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    TableStatsDialog(SqlProcessHandler* handler, SchemaCache* schema, const QString& table, QWidget *parent = nullptr);
+
+private slots:
+    void onResample();
+    void onFinished(const TableStats& stats);
+    void onFailed(const QString& msg);
+
+private:
+    QString table;
+    TableStatsCollector* collector;
+    QLabel* summaryLabel;
+    QTableWidget* statsTable;
+    QPushButton* resampleButton;
+
+    void setupUI();
+};
+
+#endif // TABLESTATSDIALOG_H
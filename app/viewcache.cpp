@@ -0,0 +1,87 @@
+#include "viewcache.h"
+#include "resulttablemodel.h"
+#include "scriptwidget.h"
+#include "findtablewidget.h"
+#include <QStackedWidget>
+#include <QSettings>
+
+ViewCache* ViewCache::instance = nullptr;
+
+ViewCache* ViewCache::getInstance()
+{
+    if (!instance) {
+        instance = new ViewCache();
+    }
+    return instance;
+}
+
+ViewCache::ViewCache(QObject *parent)
+    : QObject(parent), useCounter(0)
+{
+    memoryCap = QSettings().value("view/memoryCapMB", 512).toLongLong() * 1024 * 1024;
+}
+
+void ViewCache::touch(QWidget* view)
+{
+    if (!lastUse.contains(view)) {
+        // 视图随会话关闭或被淘汰时注销
+        connect(view, &QObject::destroyed, this, [this, view]() {
+            lastUse.remove(view);
+        });
+    }
+    lastUse[view] = ++useCounter;
+    evict();
+}
+
+qint64 ViewCache::memoryUsage(QWidget* view)
+{
+    qint64 bytes = 0;
+    for (const ResultTableModel* model : view->findChildren<ResultTableModel*>()) {
+        bytes += model->store().memoryUsage();
+    }
+    return bytes;
+}
+
+bool ViewCache::isShown(QWidget* view)
+{
+    // 会话中当前的视图，即使所在标签页不是当前页也不淘汰，切回标签页时应原样可见
+    QStackedWidget* stack = qobject_cast<QStackedWidget*>(view->parentWidget());
+    return !stack || stack->currentWidget() == view;
+}
+
+void ViewCache::evict()
+{
+    if (memoryCap <= 0) {
+        return;
+    }
+    QMap<QWidget*, qint64> usage;
+    qint64 total = 0;
+    for (auto it = lastUse.constBegin(); it != lastUse.constEnd(); ++it) {
+        usage[it.key()] = memoryUsage(it.key());
+        total += usage[it.key()];
+    }
+
+    while (total > memoryCap) {
+        QWidget* oldest = nullptr;
+        for (auto it = lastUse.constBegin(); it != lastUse.constEnd(); ++it) {
+            if (!isShown(it.key()) && usage[it.key()] > 0
+                    && (!oldest || it.value() < lastUse.value(oldest))) {
+                oldest = it.key();
+            }
+        }
+        if (!oldest) {
+            return;
+        }
+        // 只释放结果集，视图本身保留：脚本编辑器中的内容不能丢
+        total -= usage.take(oldest);
+        if (ScriptWidget* script = qobject_cast<ScriptWidget*>(oldest)) {
+            script->releaseResults();
+        } else if (FindTableWidget* find = qobject_cast<FindTableWidget*>(oldest)) {
+            find->releaseResults();
+        } else {
+            for (ResultTableModel* model : oldest->findChildren<ResultTableModel*>()) {
+                model->clear();
+            }
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef VIEWCACHE_H
+#define VIEWCACHE_H
+
+#include <QObject>
+#include <QWidget>
+#include <QMap>
+
+/**
+ * @brief 各会话中保留的视图
+ * 切换查找表/自定义查询时视图不再销毁，只在会话的QStackedWidget中隐藏，模型与已加载的数据随之保留。
+ * 所有视图中结果集占用的内存合计超过上限时，按最近使用时间释放未显示视图中的结果集，
+ * 视图与编辑中的脚本保留，查找表再次显示时重新加载
+ */
+class ViewCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    static ViewCache* getInstance();
+
+    /**
+     * @brief 结果集内存合计的上限(字节)，0表示不限制
+     */
+    void setMemoryCap(qint64 bytes) { memoryCap = bytes; }
+
+    /**
+     * @brief 视图被显示：首次出现时登记，更新其最近使用时间，并在超出上限时淘汰其他视图
+     */
+    void touch(QWidget* view);
+
+    /**
+     * @brief 视图中结果集占用的内存
+     */
+    static qint64 memoryUsage(QWidget* view);
+
+private:
+    explicit ViewCache(QObject *parent = nullptr);
+
+    static ViewCache* instance;
+
+    qint64 memoryCap;
+    quint64 useCounter;
+    QMap<QWidget*, quint64> lastUse;    // 视图 -> 最近使用的序号
+
+    void evict();
+    static bool isShown(QWidget* view);
+};
+
+#endif // VIEWCACHE_H
@@ -0,0 +1,19 @@
+QT       = core network
+
+CONFIG += console c++11
+CONFIG -= app_bundle
+TARGET = rsqlite-cli
+
+include(../core/core.pri)
+
+SOURCES += \
+    main.cpp \
+    clirunner.cpp
+
+HEADERS += \
+    clirunner.h
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
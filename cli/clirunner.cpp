@@ -0,0 +1,261 @@
+#include "clirunner.h"
+#include <QElapsedTimer>
+#include <QCoreApplication>
+#include <QJsonDocument>
+#include "socketmanager.h"
+#include "sqlprocesshandler.h"
+
+namespace {
+
+// 每次阻塞等待的上限，其间检查连接状态与投递的事件
+const int waitSliceMs = 100;
+
+} // namespace
+
+CliRunner::CliRunner(const CliOptions& options, QObject *parent)
+    : QObject(parent), options(options), err(stderr), responseReady(false)
+{
+    err.setCodec("UTF-8");
+}
+
+bool CliRunner::openOutput()
+{
+    if (options.outputPath.isEmpty()) {
+        outFile.open(stdout, QIODevice::WriteOnly);
+    } else {
+        outFile.setFileName(options.outputPath);
+        if (!outFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            err << "无法写入输出文件：" << options.outputPath << "\n";
+            return false;
+        }
+    }
+    out.setDevice(&outFile);
+    out.setCodec("UTF-8");
+    return true;
+}
+
+int CliRunner::run()
+{
+    if (!openOutput()) {
+        return ExitIoError;
+    }
+
+    QElapsedTimer total;
+    total.start();
+
+    // 建立连接并完成数据库握手
+    QElapsedTimer timer;
+    timer.start();
+    ConnectError error = ConnectError::None;
+    QString errorMsg;
+    QTcpSocket* socket = SocketManager::openConnection(options.host, options.port, options.dbPath,
+                                                       options.timeoutMs, &error, &errorMsg);
+    double connectMs = timer.nsecsElapsed() / 1e6;
+
+    QJsonObject connectTiming;
+    connectTiming["type"] = "connect";
+    connectTiming["host"] = options.host;
+    connectTiming["port"] = options.port;
+    connectTiming["ok"] = socket != nullptr;
+    connectTiming["ms"] = connectMs;
+    writeTiming(connectTiming);
+
+    if (!socket) {
+        err << "连接失败：" << errorMsg << "\n";
+        return error == ConnectError::DatabaseRejected ? ExitDatabaseRejected : ExitConnectFailed;
+    }
+
+    SocketManager::getInstance()->setSocket(socket);
+    SqlProcessHandler* sqlHandler = SqlProcessHandler::getInstance();
+    sqlHandler->setSocket(socket);
+    connect(sqlHandler, &SqlProcessHandler::dataReceived, this, &CliRunner::onDataReceived);
+
+    int exitCode = ExitOk;
+    int failed = 0;
+    for (int i = 0; i < options.statements.size(); ++i) {
+        responseReady = false;
+        response.clear();
+
+        // 上一条之后连接已断开时不再发送
+        bool disconnected = socket->state() != QAbstractSocket::ConnectedState;
+        bool received = false;
+        timer.restart();
+        if (!disconnected) {
+            sqlHandler->execSql(options.statements[i]);
+            received = waitForResponse(options.timeoutMs, &disconnected);
+        }
+        double execMs = timer.nsecsElapsed() / 1e6;
+
+        QJsonObject timing;
+        timing["type"] = "statement";
+        timing["index"] = i + 1;
+        timing["source"] = options.sources.value(i);
+        timing["exec_ms"] = execMs;
+        timing["bytes"] = response.size();
+
+        if (!received) {
+            timing["status"] = -1;
+            timing["msg"] = disconnected ? "disconnected" : "timeout";
+            writeTiming(timing);
+            err << (disconnected ? "与服务器的连接中断：" : "等待服务器响应超时：") << options.sources.value(i) << "\n";
+            exitCode = ExitTimeout;
+            ++failed;
+            break;
+        }
+
+        timer.restart();
+        bool ok = false;
+        QJsonObject obj = TableData::parseResponse(response, &ok);
+        TableData tableData = TableData::fromJsonObject(obj);
+        double decodeMs = timer.nsecsElapsed() / 1e6;
+
+        if (!ok) {
+            tableData.setStatus(-1);
+            tableData.setMsg("返回数据格式错误");
+        }
+
+        timing["status"] = tableData.getStatus();
+        timing["rows"] = tableData.getRows().size();
+        timing["decode_ms"] = decodeMs;
+
+        // 连接中断时处理器以失败应答结束在途的请求，按连接中断而不是SQL错误退出
+        if (tableData.getStatus() != 0 && socket->state() != QAbstractSocket::ConnectedState) {
+            timing["msg"] = "disconnected";
+            writeTiming(timing);
+            err << "与服务器的连接中断(" << options.sources.value(i) << ")：" << tableData.getMsg() << "\n";
+            exitCode = ExitTimeout;
+            ++failed;
+            break;
+        }
+
+        if (tableData.getStatus() != 0) {
+            timing["msg"] = tableData.getMsg();
+            writeTiming(timing);
+            err << "执行失败(" << options.sources.value(i) << ")：" << tableData.getMsg() << "\n";
+            exitCode = ExitSqlError;
+            ++failed;
+            if (!options.continueOnError) {
+                break;
+            }
+            continue;
+        }
+
+        timer.restart();
+        writeResult(tableData);
+        timing["write_ms"] = timer.nsecsElapsed() / 1e6;
+        writeTiming(timing);
+
+        if (outFile.error() != QFileDevice::NoError) {
+            err << "写入输出失败：" << outFile.errorString() << "\n";
+            exitCode = ExitIoError;
+            break;
+        }
+    }
+
+    sqlHandler->setSocket(nullptr);
+    SocketManager::getInstance()->closeSocket();
+
+    QJsonObject summary;
+    summary["type"] = "summary";
+    summary["statements"] = options.statements.size();
+    summary["failed"] = failed;
+    summary["total_ms"] = total.nsecsElapsed() / 1e6;
+    summary["exit_code"] = exitCode;
+    writeTiming(summary);
+
+    return exitCode;
+}
+
+void CliRunner::onDataReceived(const QByteArray& data)
+{
+    response = data;
+    responseReady = true;
+}
+
+bool CliRunner::waitForResponse(int timeoutMs, bool* disconnected)
+{
+    QTcpSocket* socket = SocketManager::getInstance()->getSocket();
+    QElapsedTimer timer;
+    timer.start();
+    // waitForReadyRead会同步触发readyRead，由SqlProcessHandler分帧后回调onDataReceived；
+    // 连接中断时的失败应答经QTimer投递，没有事件循环，需要在等待间隙处理事件
+    while (!responseReady) {
+        QCoreApplication::processEvents();
+        if (responseReady) {
+            break;
+        }
+        if (!socket || socket->state() != QAbstractSocket::ConnectedState) {
+            *disconnected = true;
+            return false;
+        }
+        int remaining = timeoutMs - static_cast<int>(timer.elapsed());
+        if (remaining <= 0) {
+            return false;
+        }
+        socket->waitForReadyRead(qMin(remaining, waitSliceMs));
+    }
+    return true;
+}
+
+void CliRunner::writeResult(const TableData& data)
+{
+    if (options.format == "json") {
+        // 流式写出，大结果不再先构造完整的JSON文档
+        out.flush();
+        data.writeJson(&outFile);
+        outFile.write("\n");
+        return;
+    }
+
+    const QString sep = options.format == "tsv" ? "\t" : ",";
+    QStringList columns = data.getColumns().keys();
+    if (columns.isEmpty()) {
+        return;
+    }
+
+    if (options.header) {
+        QStringList fields;
+        for (const QString& column : columns) {
+            fields << escapeField(column);
+        }
+        out << fields.join(sep) << "\n";
+    }
+
+    for (const auto& row : data.getRows()) {
+        QStringList fields;
+        for (const QString& column : columns) {
+            fields << escapeField(row.value(column));
+        }
+        out << fields.join(sep) << "\n";
+    }
+    out.flush();
+}
+
+QString CliRunner::escapeField(const QString& value) const
+{
+    if (options.format == "tsv") {
+        QString escaped = value;
+        escaped.replace("\\", "\\\\");
+        escaped.replace("\t", "\\t");
+        escaped.replace("\n", "\\n");
+        escaped.replace("\r", "\\r");
+        return escaped;
+    }
+
+    // csv: 含分隔符、引号或换行时用双引号包裹
+    if (value.contains(',') || value.contains('"') || value.contains('\n') || value.contains('\r')) {
+        QString escaped = value;
+        escaped.replace("\"", "\"\"");
+        return "\"" + escaped + "\"";
+    }
+    return value;
+}
+
+void CliRunner::writeTiming(const QJsonObject& obj)
+{
+    if (!options.timing) {
+        return;
+    }
+    err << QString::fromUtf8(QJsonDocument(obj).toJson(QJsonDocument::Compact)) << "\n";
+    err.flush();
+}
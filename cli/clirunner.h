@@ -0,0 +1,78 @@
+#ifndef CLIRUNNER_H
+#define CLIRUNNER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include <QFile>
+#include <QJsonObject>
+#include "tabledata.h"
+
+// 命令行客户端退出码
+enum CliExitCode {
+    ExitOk = 0,                 // 全部执行成功
+    ExitUsage = 1,              // 参数错误
+    ExitConnectFailed = 2,      // 无法连接服务器
+    ExitDatabaseRejected = 3,   // 服务端拒绝打开数据库
+    ExitSqlError = 4,           // 至少一条SQL执行失败
+    ExitTimeout = 5,            // 等待响应超时或连接中断
+    ExitIoError = 6             // 读取脚本或写入输出失败
+};
+
+// 命令行参数
+struct CliOptions {
+    QString host;
+    quint16 port = 0;
+    QString dbPath;
+    QStringList statements;     // 按顺序执行的SQL，每项作为一次EXEC_SQL请求发送
+    QStringList sources;        // 与statements一一对应的来源描述，用于计时输出
+    QString outputPath;         // 为空时输出到stdout
+    QString format = "csv";     // csv / tsv / json
+    bool header = true;         // csv/tsv是否输出表头
+    bool timing = false;        // 是否向stderr输出机器可读的计时信息(每行一个JSON)
+    bool continueOnError = false;
+    int timeoutMs = 30000;
+};
+
+/**
+ * @brief 无界面的命令行执行器
+ * 复用协议层完成连接握手与SQL执行，将结果流式写入stdout或文件
+ */
+class CliRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CliRunner(const CliOptions& options, QObject *parent = nullptr);
+
+    /**
+     * @brief 连接服务器并依次执行所有SQL
+     * @return CliExitCode退出码
+     */
+    int run();
+
+private slots:
+    void onDataReceived(const QByteArray& data);
+
+private:
+    CliOptions options;
+    QFile outFile;
+    QTextStream out;
+    QTextStream err;
+    QByteArray response;
+    bool responseReady;
+
+    bool openOutput();
+    /**
+     * @brief 等待当前请求的应答
+     * @param disconnected 连接中断时置为true
+     * @return 是否收到应答(包括连接中断时处理器给出的失败应答)
+     */
+    bool waitForResponse(int timeoutMs, bool* disconnected);
+    void writeResult(const TableData& data);
+    void writeTiming(const QJsonObject& obj);
+    QString escapeField(const QString& value) const;
+};
+
+#endif // CLIRUNNER_H
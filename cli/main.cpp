@@ -0,0 +1,101 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QTextStream>
+#include "clirunner.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QCoreApplication::setApplicationName("rsqlite-cli");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("SQLite远程连接器命令行客户端");
+    parser.addHelpOption();
+
+    QCommandLineOption hostOption({"H", "host"}, "服务器IP地址", "ip");
+    QCommandLineOption portOption({"p", "port"}, "服务器端口", "port");
+    QCommandLineOption dbOption({"d", "db"}, "服务端数据库路径", "dbpath");
+    QCommandLineOption execOption({"e", "execute"}, "执行一条SQL，可重复", "sql");
+    QCommandLineOption fileOption({"f", "file"}, "执行SQL脚本文件，可重复，- 表示stdin", "file");
+    QCommandLineOption outputOption({"o", "output"}, "结果输出文件，默认stdout", "file");
+    QCommandLineOption formatOption("format", "输出格式：csv、tsv、json", "format", "csv");
+    QCommandLineOption noHeaderOption("no-header", "csv/tsv不输出表头");
+    QCommandLineOption timingOption("timing", "向stderr输出计时信息，每行一个JSON对象");
+    QCommandLineOption timeoutOption("timeout", "连接与每条请求的超时时间(毫秒)", "ms", "30000");
+    QCommandLineOption continueOption("continue-on-error", "某条SQL失败后继续执行后续SQL");
+    parser.addOptions({hostOption, portOption, dbOption, execOption, fileOption, outputOption,
+                       formatOption, noHeaderOption, timingOption, timeoutOption, continueOption});
+    parser.process(a);
+
+    QTextStream err(stderr);
+    err.setCodec("UTF-8");
+
+    CliOptions options;
+    options.host = parser.value(hostOption);
+    // 超出范围的端口不能截断成另一个端口
+    bool portOk = false;
+    const uint port = parser.value(portOption).toUInt(&portOk);
+    options.port = portOk && port <= 65535 ? static_cast<quint16>(port) : 0;
+    options.dbPath = parser.value(dbOption);
+    options.outputPath = parser.value(outputOption);
+    options.format = parser.value(formatOption).toLower();
+    options.header = !parser.isSet(noHeaderOption);
+    options.timing = parser.isSet(timingOption);
+    options.continueOnError = parser.isSet(continueOption);
+    bool timeoutOk = false;
+    options.timeoutMs = parser.value(timeoutOption).toInt(&timeoutOk);
+
+    if (options.host.isEmpty() || !parser.isSet(portOption) || options.dbPath.isEmpty()) {
+        err << "必须指定 --host、--port 和 --db\n";
+        return ExitUsage;
+    }
+    if (options.port == 0) {
+        err << "无效的端口：" << parser.value(portOption) << "，应为1-65535\n";
+        return ExitUsage;
+    }
+    if (options.format != "csv" && options.format != "tsv" && options.format != "json") {
+        err << "不支持的输出格式：" << options.format << "\n";
+        return ExitUsage;
+    }
+    if (!timeoutOk || options.timeoutMs <= 0) {
+        err << "超时时间必须大于0\n";
+        return ExitUsage;
+    }
+
+    const QStringList statements = parser.values(execOption);
+    for (int i = 0; i < statements.size(); ++i) {
+        options.statements << statements[i];
+        options.sources << QString("-e#%1").arg(i + 1);
+    }
+
+    for (const QString& fileName : parser.values(fileOption)) {
+        QFile file;
+        bool opened = false;
+        if (fileName == "-") {
+            opened = file.open(stdin, QIODevice::ReadOnly | QIODevice::Text);
+        } else {
+            file.setFileName(fileName);
+            opened = file.open(QIODevice::ReadOnly | QIODevice::Text);
+        }
+        if (!opened) {
+            err << "无法打开文件：" << fileName << "\n";
+            return ExitIoError;
+        }
+        QTextStream in(&file);
+        in.setCodec("UTF-8");
+        QString script = in.readAll().trimmed();
+        if (!script.isEmpty()) {
+            options.statements << script;
+            options.sources << fileName;
+        }
+    }
+
+    if (options.statements.isEmpty()) {
+        err << "没有需要执行的SQL，请使用 -e 或 -f\n";
+        return ExitUsage;
+    }
+
+    CliRunner runner(options);
+    return runner.run();
+}
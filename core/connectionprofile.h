@@ -0,0 +1,15 @@
+#ifndef CONNECTIONPROFILE_H
+#define CONNECTIONPROFILE_H
+
+#include <QString>
+
+// 一次数据库连接所需的信息，断线重连时用于重放CONNECT_DATABASE握手
+struct ConnectionProfile {
+    QString ip;
+    quint16 port = 0;
+    QString dbPath;
+
+    bool isValid() const { return !ip.isEmpty() && port != 0 && !dbPath.isEmpty(); }
+};
+
+#endif // CONNECTIONPROFILE_H
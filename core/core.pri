@@ -0,0 +1,15 @@
+# 链接协议层静态库，供app与cli工程include
+QT += network concurrent
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+win32:CONFIG(release, debug|release): RSQLCORE_DIR = $$OUT_PWD/../core/release
+else:win32:CONFIG(debug, debug|release): RSQLCORE_DIR = $$OUT_PWD/../core/debug
+else: RSQLCORE_DIR = $$OUT_PWD/../core
+
+LIBS += -L$$RSQLCORE_DIR -lrsqlcore
+
+win32-g++: PRE_TARGETDEPS += $$RSQLCORE_DIR/librsqlcore.a
+else:win32:!win32-g++: PRE_TARGETDEPS += $$RSQLCORE_DIR/rsqlcore.lib
+else: PRE_TARGETDEPS += $$RSQLCORE_DIR/librsqlcore.a
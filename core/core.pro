@@ -0,0 +1,51 @@
+QT       = core network concurrent
+
+TEMPLATE = lib
+CONFIG += staticlib c++11
+TARGET = rsqlcore
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+SOURCES += \
+    sqlprocesshandler.cpp \
+    tabledata.cpp \
+    socketmanager.cpp \
+    resultstore.cpp \
+    resulttablemodel.cpp \
+    resultproxymodel.cpp \
+    sqlsplitter.cpp \
+    schemacache.cpp \
+    indexadvisor.cpp \
+    resultspillfile.cpp \
+    resultsnapshot.cpp \
+    jsonstreamwriter.cpp \
+    scriptfilerunner.cpp \
+    messagelog.cpp \
+    tablestats.cpp \
+    globalsearch.cpp \
+    tableprefetcher.cpp \
+    rowcountestimator.cpp
+
+HEADERS += \
+    connectionprofile.h \
+    funcid.h \
+    sqlprocesshandler.h \
+    tabledata.h \
+    socketmanager.h \
+    resultstore.h \
+    resulttablemodel.h \
+    resultproxymodel.h \
+    sqlsplitter.h \
+    schemacache.h \
+    indexadvisor.h \
+    resultspillfile.h \
+    resultsnapshot.h \
+    jsonstreamwriter.h \
+    scriptfilerunner.h \
+    messagelog.h \
+    tablestats.h \
+    globalsearch.h \
+    tableprefetcher.h \
+    rowcountestimator.h
@@ -0,0 +1,26 @@
+#ifndef FUNCID_H
+#define FUNCID_H
+#include <iostream>
+#include <QObject>
+
+//app应用信息
+const int APPID = 10086;
+const QString APPKEY = "test";
+
+//TCP指令功能号
+const QString CONNECT_DATABASE = "100000";
+//执行sql
+const QString EXEC_SQL = "100001";
+//订阅表的行级变更，msg: {"table": 表名}
+const QString SUBSCRIBE_TABLE = "100002";
+//取消订阅，msg: {"table": 表名}
+const QString UNSUBSCRIBE_TABLE = "100003";
+//中断本连接正在执行的SQL(sqlite3_interrupt)，服务端需在读线程上立即处理且不应答，
+//被中断的请求照常以错误应答，不破坏应答顺序
+const QString CANCEL_SQL = "100004";
+
+//服务端主动推送的变更通知，不对应任何请求：
+//{"funcid":"200000","table":表名,"events":[{"op":"insert|update|delete","rowid":行号,"row":{列:值}}]}
+const QString CHANGE_NOTIFY = "200000";
+
+#endif // FUNCID_H
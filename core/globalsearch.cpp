@@ -0,0 +1,397 @@
+#include "globalsearch.h"
+#include "indexadvisor.h"
+#include "tabledata.h"
+#include <QtConcurrent>
+#include <QPointer>
+#include <QThread>
+#include <QJsonArray>
+#include <QSet>
+#include <QRegularExpression>
+
+namespace {
+
+// 额外连接的握手超时
+const int connectTimeoutMs = 5000;
+// 行预览的最大长度
+const int previewLength = 120;
+
+// LIKE模式中的%、_和转义符本身按字面匹配
+QString likePattern(const QString& term)
+{
+    QString escaped = term;
+    escaped.replace('\\', "\\\\").replace('%', "\\%").replace('_', "\\_");
+    return TableData::sqlLiteral("%" + escaped + "%");
+}
+
+bool isFtsTable(const TableSchema& schema)
+{
+    static const QRegularExpression fts("USING\\s+fts\\d", QRegularExpression::CaseInsensitiveOption);
+    return schema.isVirtual && schema.sql.contains(fts);
+}
+
+} // namespace
+
+GlobalSearch::GlobalSearch(SqlProcessHandler* handler, SchemaCache* schema, const ConnectionProfile& profile,
+                           QObject *parent)
+    : QObject(parent), primaryHandler(handler), schemaCache(schema), profile(profile),
+      parallelism(4), serverCancelEnabled(false), connectsInFlight(0), exact(false),
+      running(false), waitingForSchema(false), timeBudgetMs(0), totalTasks(0), doneTasks(0),
+      failedTasks(0), hits(0)
+{
+    // 会话本身的连接始终是第一个工作连接
+    Worker primary;
+    primary.handler = handler;
+    workers << primary;
+    connect(handler, &SqlProcessHandler::responseReceived, this, &GlobalSearch::onResponseReceived);
+
+    budgetTimer = new QTimer(this);
+    budgetTimer->setSingleShot(true);
+    connect(budgetTimer, &QTimer::timeout, this, &GlobalSearch::onTimeBudgetExpired);
+
+    connect(schemaCache, &SchemaCache::schemaLoaded, this, [this]() {
+        if (running && waitingForSchema) {
+            waitingForSchema = false;
+            buildTasks();
+            dispatch();
+        }
+    });
+    connect(schemaCache, &SchemaCache::schemaLoadFailed, this, [this](const QString& msg) {
+        if (running && waitingForSchema) {
+            finish(false, "读取表结构失败：" + msg);
+        }
+    });
+}
+
+GlobalSearch::~GlobalSearch()
+{
+    cancel();
+    // 额外的连接随搜索一起关闭
+    for (Worker& worker : workers) {
+        if (worker.sockets) {
+            worker.handler->setSocket(nullptr);
+            worker.sockets->closeSocket();
+        }
+    }
+}
+
+void GlobalSearch::start(const QString& term, bool exact, int timeBudgetMs)
+{
+    cancel();
+    this->term = term;
+    this->exact = exact;
+    this->timeBudgetMs = timeBudgetMs;
+    tasks.clear();
+    totalTasks = 0;
+    doneTasks = 0;
+    failedTasks = 0;
+    hits = 0;
+    running = true;
+    elapsed.start();
+    if (timeBudgetMs > 0) {
+        budgetTimer->start(timeBudgetMs);
+    }
+
+    openConnections();
+
+    // 表结构尚未加载时等加载完成再生成查询
+    if (!schemaCache->isLoaded()) {
+        waitingForSchema = true;
+        if (!schemaCache->isLoading()) {
+            schemaCache->refresh();
+        }
+        return;
+    }
+    buildTasks();
+    dispatch();
+}
+
+void GlobalSearch::cancel()
+{
+    for (Worker& worker : workers) {
+        if (worker.requestId != 0) {
+            worker.handler->cancelRequest(worker.requestId);
+            worker.requestId = 0;
+        }
+    }
+    tasks.clear();
+    budgetTimer->stop();
+    waitingForSchema = false;
+    running = false;
+}
+
+void GlobalSearch::finish(bool complete, const QString& message)
+{
+    cancel();
+    emit finished(complete, message);
+}
+
+void GlobalSearch::onTimeBudgetExpired()
+{
+    if (!running) {
+        return;
+    }
+    int skipped = tasks.size();
+    for (const Worker& worker : workers) {
+        if (worker.requestId != 0) {
+            ++skipped;
+        }
+    }
+    finish(false, QString("超出时间预算，%1 条查询未执行完，命中 %2 条").arg(skipped).arg(hits));
+}
+
+void GlobalSearch::openConnections()
+{
+    if (!profile.isValid()) {
+        return;
+    }
+    // 握手是阻塞的，放到线程池中进行，完成后把socket移回本线程
+    QThread* home = thread();
+    const ConnectionProfile target = profile;
+    QPointer<GlobalSearch> self(this);
+    while (workers.size() + connectsInFlight < parallelism) {
+        ++connectsInFlight;
+        auto* watcher = new QFutureWatcher<QTcpSocket*>();
+        connect(watcher, &QFutureWatcher<QTcpSocket*>::finished, watcher, [self, watcher]() {
+            QTcpSocket* socket = watcher->result();
+            if (self) {
+                self->addWorker(socket);
+            } else {
+                delete socket;
+            }
+            watcher->deleteLater();
+        });
+        watcher->setFuture(QtConcurrent::run([target, home]() -> QTcpSocket* {
+            QTcpSocket* socket = SocketManager::openConnection(target.ip, target.port, target.dbPath, connectTimeoutMs);
+            if (socket) {
+                socket->moveToThread(home);
+            }
+            return socket;
+        }));
+    }
+}
+
+void GlobalSearch::addWorker(QTcpSocket* socket)
+{
+    --connectsInFlight;
+    if (!socket) {
+        return;     // 连接失败时用已有的连接继续
+    }
+
+    Worker worker;
+    worker.sockets = new SocketManager(this);
+    worker.sockets->setSocket(socket);
+    worker.handler = new SqlProcessHandler(worker.sockets, this);
+    worker.handler->setSocket(socket);
+    worker.handler->setServerCancelEnabled(serverCancelEnabled);
+    connect(worker.handler, &SqlProcessHandler::responseReceived, this, &GlobalSearch::onResponseReceived);
+    workers << worker;
+
+    if (running && !waitingForSchema) {
+        dispatch();
+    }
+}
+
+void GlobalSearch::buildTasks()
+{
+    // 数字搜索词同时在数值列中等值匹配，只接受普通的十进制写法，直接写入SQL
+    static const QRegularExpression number("^[-+]?\\d+(\\.\\d+)?$");
+    const QString numericTerm = term.trimmed();
+    const bool isNumber = number.match(numericTerm).hasMatch();
+
+    QVector<Task> indexed;
+    QVector<Task> fts;
+    QVector<Task> scans;
+
+    QStringList names = schemaCache->tableNames();
+    QSet<QString> ftsTables;
+    for (const QString& name : names) {
+        TableSchema schema = schemaCache->table(name);
+        if (isFtsTable(schema)) {
+            ftsTables.insert(schema.name.toLower());
+        }
+    }
+
+    for (const QString& name : names) {
+        TableSchema schema = schemaCache->table(name);
+        const QString lower = schema.name.toLower();
+        if (schema.isView || lower.startsWith("sqlite_")) {
+            continue;
+        }
+
+        // FTS表用一条MATCH查询覆盖全部列，其影子表(名字以"FTS表名_"开头)不再单独搜索
+        bool shadow = false;
+        for (const QString& ftsName : ftsTables) {
+            if (lower.startsWith(ftsName + "_")) {
+                shadow = true;
+                break;
+            }
+        }
+        if (shadow) {
+            continue;
+        }
+        const QString table = IndexAdvisor::quoteIdentifier(schema.name);
+        if (ftsTables.contains(lower)) {
+            QString phrase = "\"" + QString(term).replace('"', "\"\"") + "\"";
+            Task task;
+            task.table = schema.name;
+            task.sql = QString("SELECT rowid AS _rowid_, * FROM %1 WHERE %1 MATCH %2 LIMIT %3;")
+                    .arg(table, TableData::sqlLiteral(phrase)).arg(hitsPerQuery);
+            fts << task;
+            continue;
+        }
+        if (schema.isVirtual) {
+            continue;
+        }
+
+        QSet<QString> indexedColumns;
+        for (const IndexInfo& index : schema.indexes) {
+            if (!index.columns.isEmpty()) {
+                indexedColumns.insert(index.columns.first().toLower());
+            }
+        }
+        for (const ColumnInfo& column : schema.columns) {
+            if (column.pk == 1) {
+                indexedColumns.insert(column.name.toLower());
+            }
+        }
+
+        static const QRegularExpression withoutRowidClause("WITHOUT\\s+ROWID", QRegularExpression::CaseInsensitiveOption);
+        const bool withoutRowid = schema.sql.contains(withoutRowidClause);
+        const QString select = withoutRowid ? QString("SELECT *") : QString("SELECT rowid AS _rowid_, *");
+
+        for (int i = 0; i < schema.columns.size(); ++i) {
+            const ColumnInfo& column = schema.columns[i];
+            const bool text = schema.isTextColumn(i);
+            if (column.type.toUpper().contains("BLOB") || (!text && !isNumber)) {
+                continue;
+            }
+
+            const QString quotedColumn = IndexAdvisor::quoteIdentifier(column.name);
+            QString condition;
+            if (!text) {
+                condition = QString("%1 = %2").arg(quotedColumn, numericTerm);
+            } else if (exact) {
+                condition = QString("%1 = %2").arg(quotedColumn, TableData::sqlLiteral(term));
+            } else {
+                condition = QString("%1 LIKE %2 ESCAPE '\\'").arg(quotedColumn, likePattern(term));
+            }
+
+            Task task;
+            task.table = schema.name;
+            task.column = column.name;
+            task.sql = QString("%1 FROM %2 WHERE %3 LIMIT %4;").arg(select, table, condition).arg(hitsPerQuery);
+
+            // 等值匹配有索引的列只需一次查找，先执行以尽快给出命中
+            bool equality = exact || !text;
+            if (equality && indexedColumns.contains(column.name.toLower())) {
+                indexed << task;
+            } else {
+                scans << task;
+            }
+        }
+    }
+
+    for (const Task& task : indexed) {
+        tasks.enqueue(task);
+    }
+    for (const Task& task : fts) {
+        tasks.enqueue(task);
+    }
+    for (const Task& task : scans) {
+        tasks.enqueue(task);
+    }
+    totalTasks = tasks.size();
+    emit progress(0, totalTasks);
+}
+
+void GlobalSearch::dispatch()
+{
+    if (!running) {
+        return;
+    }
+    for (Worker& worker : workers) {
+        if (tasks.isEmpty()) {
+            break;
+        }
+        if (worker.requestId != 0) {
+            continue;
+        }
+        worker.task = tasks.dequeue();
+        worker.requestId = worker.handler->execSql(worker.task.sql);
+    }
+
+    // 没有查询在途也没有待执行的查询时结束
+    if (tasks.isEmpty()) {
+        for (const Worker& worker : workers) {
+            if (worker.requestId != 0) {
+                return;
+            }
+        }
+        QString message = QString("搜索完成，%1 条查询，命中 %2 条，用时 %3 ms")
+                .arg(totalTasks).arg(hits).arg(elapsed.elapsed());
+        if (failedTasks > 0) {
+            message += QString("，%1 条查询失败").arg(failedTasks);
+        }
+        finish(true, message);
+    }
+}
+
+void GlobalSearch::onResponseReceived(quint64 requestId, const QByteArray& data)
+{
+    SqlProcessHandler* handler = qobject_cast<SqlProcessHandler*>(sender());
+    Worker* worker = nullptr;
+    for (Worker& candidate : workers) {
+        if (candidate.handler == handler && candidate.requestId == requestId && requestId != 0) {
+            worker = &candidate;
+            break;
+        }
+    }
+    if (!worker) {
+        return;
+    }
+    worker->requestId = 0;
+    const Task task = worker->task;
+    ++doneTasks;
+
+    bool ok = false;
+    QJsonObject jsonObj = TableData::parseResponse(data, &ok);
+    if (!ok || jsonObj["status"].toInt() != 0) {
+        ++failedTasks;
+    } else {
+        handleRows(task, jsonObj["rows"].toArray());
+    }
+    if (!running) {
+        return;     // 命中达到上限时已结束
+    }
+    emit progress(doneTasks, totalTasks);
+    dispatch();
+}
+
+void GlobalSearch::handleRows(const Task& task, const QJsonArray& rows)
+{
+    // 预览按建表时的列顺序拼接
+    const TableSchema schema = schemaCache->table(task.table);
+    for (const auto& value : rows) {
+        const QJsonObject row = value.toObject();
+        SearchHit hit;
+        hit.table = task.table;
+        hit.column = task.column;
+        hit.rowid = TableData::cellText(row["_rowid_"]);
+        hit.value = task.column.isEmpty() ? QString() : TableData::cellText(row[task.column]);
+
+        QStringList parts;
+        for (const ColumnInfo& column : schema.columns) {
+            parts << column.name + "=" + TableData::cellText(row[column.name]);
+        }
+        hit.preview = parts.join(", ");
+        if (hit.preview.size() > previewLength) {
+            hit.preview = hit.preview.left(previewLength) + "...";
+        }
+
+        emit hitFound(hit);
+        if (++hits >= maxHits) {
+            finish(false, QString("命中超过 %1 条，已停止搜索，请缩小搜索词").arg(maxHits));
+            return;
+        }
+    }
+}
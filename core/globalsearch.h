@@ -0,0 +1,119 @@
+#ifndef GLOBALSEARCH_H
+#define GLOBALSEARCH_H
+
+#include <QObject>
+#include <QQueue>
+#include <QVector>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include "connectionprofile.h"
+#include "schemacache.h"
+#include "socketmanager.h"
+#include "sqlprocesshandler.h"
+
+// 一条命中
+struct SearchHit {
+    QString table;
+    QString column;         // FTS表整表匹配时为空
+    QString rowid;
+    QString value;          // 命中列的值
+    QString preview;        // 整行的简短预览
+};
+
+/**
+ * @brief 跨表的值搜索
+ * 按表结构为每张表的每个文本列(数字搜索词还包括数值列)生成一条查询，FTS表整表用MATCH一条查询，
+ * 精确匹配时有索引的列排在最前。查询分发到若干条连接上并发执行，每条连接同时只有一条在途，
+ * 命中随查询完成陆续发出；可随时取消，超出时间预算时放弃其余查询。
+ * 除会话本身的连接外，额外的连接在后台线程中握手，搜索结束后保留供下次复用。
+ */
+class GlobalSearch : public QObject
+{
+    Q_OBJECT
+
+public:
+    GlobalSearch(SqlProcessHandler* handler, SchemaCache* schema, const ConnectionProfile& profile,
+                 QObject *parent = nullptr);
+    ~GlobalSearch();
+
+    /**
+     * @brief 并发的连接数(含会话本身的连接)
+     */
+    void setParallelism(int connections) { parallelism = qMax(1, connections); }
+    void setServerCancelEnabled(bool enabled) { serverCancelEnabled = enabled; }
+
+    /**
+     * @brief 开始搜索，进行中的搜索被取消
+     * @param term 搜索词
+     * @param exact 精确匹配(可使用索引)，否则按子串LIKE匹配
+     * @param timeBudgetMs 时间预算，0表示不限制
+     */
+    void start(const QString& term, bool exact, int timeBudgetMs);
+    void cancel();
+    bool isRunning() const { return running; }
+
+signals:
+    void hitFound(const SearchHit& hit);
+    void progress(int done, int total);
+
+    /**
+     * @brief 搜索结束
+     * @param complete 全部查询都已完成(未取消、未超时)
+     * @param message 结束说明
+     */
+    void finished(bool complete, const QString& message);
+
+private slots:
+    void onResponseReceived(quint64 requestId, const QByteArray& data);
+    void onTimeBudgetExpired();
+
+private:
+    // 一条待执行的查询
+    struct Task {
+        QString table;
+        QString column;
+        QString sql;
+    };
+
+    // 一条执行查询的连接
+    struct Worker {
+        SocketManager* sockets = nullptr;   // 额外连接的持有者，会话本身的连接为空
+        SqlProcessHandler* handler = nullptr;
+        quint64 requestId = 0;              // 在途的查询，0表示空闲
+        Task task;
+    };
+
+    static const int hitsPerQuery = 50;
+    static const int maxHits = 1000;
+
+    SqlProcessHandler* primaryHandler;
+    SchemaCache* schemaCache;
+    ConnectionProfile profile;
+    int parallelism;
+    bool serverCancelEnabled;
+
+    QVector<Worker> workers;
+    int connectsInFlight;
+    QQueue<Task> tasks;
+    QString term;
+    bool exact;
+    bool running;
+    bool waitingForSchema;
+    int timeBudgetMs;
+    int totalTasks;
+    int doneTasks;
+    int failedTasks;
+    int hits;
+    QTimer* budgetTimer;
+    QElapsedTimer elapsed;
+
+    void buildTasks();
+    void openConnections();
+    void addWorker(QTcpSocket* socket);
+    void dispatch();
+    void finish(bool complete, const QString& message);
+    void handleRows(const Task& task, const QJsonArray& rows);
+};
+
+#endif // GLOBALSEARCH_H
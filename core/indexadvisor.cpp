@@ -0,0 +1,266 @@
+#include "indexadvisor.h"
+#include "tabledata.h"
+#include <QJsonArray>
+#include <QRegularExpression>
+#include <QMap>
+
+namespace {
+
+QString unquote(QString name)
+{
+    if (name.size() >= 2 && (name.startsWith('"') || name.startsWith('[') || name.startsWith('`'))) {
+        name = name.mid(1, name.size() - 2);
+    }
+    return name;
+}
+
+// 不会作为表别名出现的关键字
+bool isKeyword(const QString& word)
+{
+    static const QStringList keywords = {
+        "WHERE", "JOIN", "ON", "LEFT", "RIGHT", "INNER", "OUTER", "CROSS", "NATURAL", "FULL",
+        "GROUP", "ORDER", "LIMIT", "USING", "HAVING", "WINDOW", "UNION", "EXCEPT", "INTERSECT",
+        "SET", "VALUES", "INDEXED", "NOT"
+    };
+    return keywords.contains(word.toUpper());
+}
+
+// 一个表在语句中的条件列
+struct TableUsage {
+    QString table;
+    QStringList equalityColumns;
+    QStringList rangeColumns;
+    QStringList orderColumns;
+};
+
+} // namespace
+
+QVector<PlanNode> IndexAdvisor::parsePlan(const QJsonObject& response)
+{
+    QVector<PlanNode> plan;
+    for (const auto& row : response["rows"].toArray()) {
+        QJsonObject rowObj = row.toObject();
+        PlanNode node;
+        node.id = TableData::cellText(rowObj["id"]).toInt();
+        node.parent = TableData::cellText(rowObj["parent"]).toInt();
+        node.detail = TableData::cellText(rowObj["detail"]);
+        plan << node;
+    }
+    return plan;
+}
+
+bool IndexAdvisor::isFullScan(const QString& detail)
+{
+    // 3.36之前为"SCAN TABLE t"，之后为"SCAN t"；带USING INDEX的是索引扫描
+    return detail.startsWith("SCAN ") && !detail.contains("USING") && !detail.contains("CONSTANT ROW")
+            && !detail.startsWith("SCAN SUBQUERY") && !detail.startsWith("SCAN CTE");
+}
+
+bool IndexAdvisor::isTempBTree(const QString& detail)
+{
+    return detail.contains("TEMP B-TREE");
+}
+
+QString IndexAdvisor::quoteIdentifier(const QString& name)
+{
+    static const QRegularExpression plain("^[A-Za-z_][A-Za-z0-9_]*$");
+    if (plain.match(name).hasMatch()) {
+        return name;
+    }
+    QString escaped = name;
+    escaped.replace("\"", "\"\"");
+    return "\"" + escaped + "\"";
+}
+
+QString IndexAdvisor::createIndexSql(const QString& name, const QString& table, const QStringList& columns)
+{
+    QStringList quoted;
+    for (const QString& column : columns) {
+        quoted << quoteIdentifier(column);
+    }
+    return QString("CREATE INDEX %1 ON %2(%3);")
+            .arg(quoteIdentifier(name), quoteIdentifier(table), quoted.join(", "));
+}
+
+QVector<IndexSuggestion> IndexAdvisor::suggest(const QString& statement, const QVector<PlanNode>& plan,
+                                               const SchemaCache& schema)
+{
+    QVector<IndexSuggestion> suggestions;
+
+    // 1. FROM/JOIN中的表与别名
+    QMap<QString, QString> aliasToTable;   // 小写别名或表名 -> 表名
+    QStringList statementTables;
+    static const QRegularExpression fromRe(
+        "\\b(?:FROM|JOIN|UPDATE|INTO)\\s+([\\w\"\\[\\]`.]+)(?:\\s+(?:AS\\s+)?(\\w+))?",
+        QRegularExpression::CaseInsensitiveOption);
+    auto fromIt = fromRe.globalMatch(statement);
+    while (fromIt.hasNext()) {
+        QRegularExpressionMatch match = fromIt.next();
+        QString table = unquote(match.captured(1).section('.', -1));
+        if (!schema.hasTable(table)) {
+            continue;
+        }
+        table = schema.table(table).name;
+        statementTables << table;
+        aliasToTable[table.toLower()] = table;
+        QString alias = match.captured(2);
+        if (!alias.isEmpty() && !isKeyword(alias)) {
+            aliasToTable[alias.toLower()] = table;
+        }
+    }
+
+    // 2. 计划中需要优化的表
+    QStringList targetTables;
+    bool needsOrderIndex = false;
+    static const QRegularExpression scanRe("^SCAN (?:TABLE )?([\\w\"\\[\\]`]+)(?: AS (\\w+))?");
+    for (const PlanNode& node : plan) {
+        if (isFullScan(node.detail)) {
+            QRegularExpressionMatch match = scanRe.match(node.detail);
+            QString name = match.hasMatch() ? unquote(match.captured(1)).toLower() : QString();
+            QString table = aliasToTable.value(name);
+            if (!table.isEmpty() && !targetTables.contains(table)) {
+                targetTables << table;
+            }
+        }
+        if (isTempBTree(node.detail) && node.detail.contains("ORDER BY")) {
+            needsOrderIndex = true;
+        }
+    }
+    // 单表查询只是排序用了临时B树时，也可以用索引消除排序
+    statementTables.removeDuplicates();
+    if (targetTables.isEmpty() && needsOrderIndex && statementTables.size() == 1) {
+        targetTables << statementTables.first();
+    }
+    if (targetTables.isEmpty()) {
+        return suggestions;
+    }
+
+    QMap<QString, TableUsage> usages;
+    for (const QString& table : targetTables) {
+        usages[table].table = table;
+    }
+
+    // 把列引用归属到目标表：有限定名按别名，无限定名按列是否存在
+    auto resolve = [&](const QString& qualifier, const QString& column) -> QString {
+        if (!qualifier.isEmpty()) {
+            QString table = aliasToTable.value(unquote(qualifier).toLower());
+            return usages.contains(table) && schema.table(table).columnIndex(column) >= 0 ? table : QString();
+        }
+        for (const QString& table : targetTables) {
+            if (schema.table(table).columnIndex(column) >= 0) {
+                return table;
+            }
+        }
+        return QString();
+    };
+
+    // 3. WHERE/ON中的条件列
+    static const QRegularExpression clauseStart("\\b(?:WHERE|ON)\\b", QRegularExpression::CaseInsensitiveOption);
+    static const QRegularExpression clauseEnd("\\b(?:GROUP\\s+BY|ORDER\\s+BY|LIMIT|HAVING|WINDOW)\\b",
+                                              QRegularExpression::CaseInsensitiveOption);
+    QRegularExpressionMatch startMatch = clauseStart.match(statement);
+    if (startMatch.hasMatch()) {
+        int begin = startMatch.capturedEnd();
+        QRegularExpressionMatch endMatch = clauseEnd.match(statement, begin);
+        QString predicates = statement.mid(begin, endMatch.hasMatch() ? endMatch.capturedStart() - begin : -1);
+
+        static const QRegularExpression predicateRe(
+            "(?:([\\w\"`\\[\\]]+)\\.)?([\\w\"`\\[\\]]+)\\s*(==|=|<=|>=|<|>|\\bIN\\b|\\bIS\\b|\\bBETWEEN\\b|\\bLIKE\\b)",
+            QRegularExpression::CaseInsensitiveOption);
+        auto it = predicateRe.globalMatch(predicates);
+        while (it.hasNext()) {
+            QRegularExpressionMatch match = it.next();
+            QString column = unquote(match.captured(2));
+            QString table = resolve(match.captured(1), column);
+            if (table.isEmpty()) {
+                continue;
+            }
+            column = schema.table(table).columns[schema.table(table).columnIndex(column)].name;
+            const QString op = match.captured(3).toUpper();
+            TableUsage& usage = usages[table];
+            if (op == "=" || op == "==" || op == "IN" || op == "IS") {
+                if (!usage.equalityColumns.contains(column)) {
+                    usage.equalityColumns << column;
+                }
+            } else if (!usage.rangeColumns.contains(column)) {
+                usage.rangeColumns << column;
+            }
+        }
+    }
+
+    // 4. ORDER BY列
+    static const QRegularExpression orderRe("\\bORDER\\s+BY\\s+(.+?)(?:\\bLIMIT\\b|;|$)",
+                                            QRegularExpression::CaseInsensitiveOption
+                                            | QRegularExpression::DotMatchesEverythingOption);
+    QRegularExpressionMatch orderMatch = orderRe.match(statement);
+    if (needsOrderIndex && orderMatch.hasMatch()) {
+        static const QRegularExpression termRe("^(?:([\\w\"`\\[\\]]+)\\.)?([\\w\"`\\[\\]]+)");
+        for (const QString& term : orderMatch.captured(1).split(',')) {
+            QRegularExpressionMatch match = termRe.match(term.trimmed());
+            if (!match.hasMatch()) {
+                continue;
+            }
+            QString column = unquote(match.captured(2));
+            QString table = resolve(match.captured(1), column);
+            if (!table.isEmpty()) {
+                column = schema.table(table).columns[schema.table(table).columnIndex(column)].name;
+                usages[table].orderColumns << column;
+            }
+        }
+    }
+
+    // 5. 等值列在前，其后接一个范围列；没有范围列时接排序列
+    for (const TableUsage& usage : usages) {
+        QStringList columns = usage.equalityColumns;
+        QString reason;
+        if (!usage.rangeColumns.isEmpty()) {
+            columns << usage.rangeColumns.first();
+        } else {
+            for (const QString& column : usage.orderColumns) {
+                if (!columns.contains(column)) {
+                    columns << column;
+                }
+            }
+        }
+        if (columns.isEmpty()) {
+            continue;
+        }
+
+        // 已有索引的前缀覆盖这些列时不再建议
+        bool covered = false;
+        for (const IndexInfo& index : schema.table(usage.table).indexes) {
+            if (index.columns.mid(0, columns.size()) == columns) {
+                covered = true;
+                break;
+            }
+        }
+        if (covered) {
+            continue;
+        }
+
+        QStringList parts;
+        if (!usage.equalityColumns.isEmpty()) {
+            parts << "等值条件 " + usage.equalityColumns.join(", ");
+        }
+        if (!usage.rangeColumns.isEmpty()) {
+            parts << "范围条件 " + usage.rangeColumns.first();
+        }
+        if (usage.rangeColumns.isEmpty() && !usage.orderColumns.isEmpty()) {
+            parts << "排序 " + usage.orderColumns.join(", ");
+        }
+
+        QStringList nameParts;
+        for (const QString& column : columns) {
+            nameParts << QString(column).replace(QRegularExpression("\\W"), "_");
+        }
+
+        IndexSuggestion suggestion;
+        suggestion.table = usage.table;
+        suggestion.columns = columns;
+        suggestion.createSql = createIndexSql(QString("idx_%1_%2").arg(usage.table, nameParts.join("_")),
+                                              usage.table, columns);
+        suggestion.reason = parts.join("；");
+        suggestions << suggestion;
+    }
+    return suggestions;
+}
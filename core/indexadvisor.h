@@ -0,0 +1,67 @@
+#ifndef INDEXADVISOR_H
+#define INDEXADVISOR_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QJsonObject>
+#include "schemacache.h"
+
+// EXPLAIN QUERY PLAN返回的一个节点
+struct PlanNode {
+    int id = 0;
+    int parent = 0;
+    QString detail;
+};
+
+// 一条候选索引
+struct IndexSuggestion {
+    QString table;
+    QStringList columns;
+    QString createSql;
+    QString reason;
+};
+
+/**
+ * @brief 查询计划分析与索引建议
+ * 根据EXPLAIN QUERY PLAN中的全表扫描和临时B树，结合语句中的WHERE/ON/ORDER BY列
+ * 与缓存的表结构，给出候选的CREATE INDEX语句。只做启发式判断，结果需实测验证。
+ */
+class IndexAdvisor {
+public:
+    /**
+     * @brief 从EXPLAIN QUERY PLAN的响应中解析计划节点
+     */
+    static QVector<PlanNode> parsePlan(const QJsonObject& response);
+
+    /**
+     * @brief 是否为未使用索引的全表扫描
+     */
+    static bool isFullScan(const QString& detail);
+
+    /**
+     * @brief 是否使用了临时B树(ORDER BY/GROUP BY/DISTINCT排序)
+     */
+    static bool isTempBTree(const QString& detail);
+
+    /**
+     * @brief 生成候选索引
+     * @param statement 被分析的语句
+     * @param plan 查询计划
+     * @param schema 表结构缓存
+     */
+    static QVector<IndexSuggestion> suggest(const QString& statement, const QVector<PlanNode>& plan,
+                                            const SchemaCache& schema);
+
+    /**
+     * @brief 必要时为标识符加双引号
+     */
+    static QString quoteIdentifier(const QString& name);
+
+    /**
+     * @brief 按索引名、表名和列名生成CREATE INDEX语句，标识符按需加引号
+     */
+    static QString createIndexSql(const QString& name, const QString& table, const QStringList& columns);
+};
+
+#endif // INDEXADVISOR_H
@@ -0,0 +1,140 @@
+#include "jsonstreamwriter.h"
+
+JsonStreamWriter::JsonStreamWriter(QIODevice* device)
+    : device(device), afterKey(false), failed(false)
+{
+    buffer.reserve(bufferLimit + 4096);
+}
+
+JsonStreamWriter::~JsonStreamWriter()
+{
+    flush();
+}
+
+void JsonStreamWriter::beginValue()
+{
+    // 键之后的值不需要逗号，其余成员之间以逗号分隔
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    if (!scopeHasItems.isEmpty()) {
+        if (scopeHasItems.last()) {
+            buffer.append(',');
+        }
+        scopeHasItems.last() = true;
+    }
+}
+
+void JsonStreamWriter::beginObject()
+{
+    beginValue();
+    buffer.append('{');
+    scopeHasItems.append(false);
+}
+
+void JsonStreamWriter::endObject()
+{
+    buffer.append('}');
+    scopeHasItems.removeLast();
+    maybeFlush();
+}
+
+void JsonStreamWriter::beginArray()
+{
+    beginValue();
+    buffer.append('[');
+    scopeHasItems.append(false);
+}
+
+void JsonStreamWriter::endArray()
+{
+    buffer.append(']');
+    scopeHasItems.removeLast();
+    maybeFlush();
+}
+
+void JsonStreamWriter::writeKey(const QString& key)
+{
+    beginValue();
+    appendEscaped(key);
+    buffer.append(':');
+    afterKey = true;
+}
+
+void JsonStreamWriter::writeString(const QString& value)
+{
+    beginValue();
+    appendEscaped(value);
+    maybeFlush();
+}
+
+void JsonStreamWriter::writeInt(qint64 value)
+{
+    beginValue();
+    buffer.append(QByteArray::number(value));
+}
+
+void JsonStreamWriter::writeBool(bool value)
+{
+    beginValue();
+    buffer.append(value ? "true" : "false");
+}
+
+void JsonStreamWriter::writeNull()
+{
+    beginValue();
+    buffer.append("null");
+}
+
+void JsonStreamWriter::appendEscaped(const QString& text)
+{
+    static const char hex[] = "0123456789abcdef";
+    const QByteArray utf8 = text.toUtf8();
+    buffer.append('"');
+
+    // 逐段复制无需转义的字节，多字节UTF-8原样输出
+    const char* begin = utf8.constData();
+    const char* end = begin + utf8.size();
+    const char* run = begin;
+    for (const char* pos = begin; pos < end; ++pos) {
+        const uchar c = uchar(*pos);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        buffer.append(run, int(pos - run));
+        run = pos + 1;
+        switch (c) {
+        case '"': buffer.append("\\\""); break;
+        case '\\': buffer.append("\\\\"); break;
+        case '\b': buffer.append("\\b"); break;
+        case '\f': buffer.append("\\f"); break;
+        case '\n': buffer.append("\\n"); break;
+        case '\r': buffer.append("\\r"); break;
+        case '\t': buffer.append("\\t"); break;
+        default:
+            buffer.append("\\u00");
+            buffer.append(hex[c >> 4]);
+            buffer.append(hex[c & 0xf]);
+            break;
+        }
+    }
+    buffer.append(run, int(end - run));
+    buffer.append('"');
+}
+
+void JsonStreamWriter::maybeFlush()
+{
+    if (buffer.size() >= bufferLimit) {
+        flush();
+    }
+}
+
+bool JsonStreamWriter::flush()
+{
+    if (!failed && !buffer.isEmpty()) {
+        failed = !device || device->write(buffer) != buffer.size();
+    }
+    buffer.resize(0);   // 保留reserve过的容量
+    return !failed;
+}
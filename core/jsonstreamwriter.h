@@ -0,0 +1,56 @@
+#ifndef JSONSTREAMWRITER_H
+#define JSONSTREAMWRITER_H
+
+#include <QIODevice>
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief 流式JSON写入器
+ * 直接把紧凑格式的JSON写入QIODevice，不构造QJsonObject/QJsonArray，
+ * 内部只有一个定长的写缓冲。输出与QJsonDocument::toJson(Compact)的转义规则一致。
+ */
+class JsonStreamWriter {
+public:
+    explicit JsonStreamWriter(QIODevice* device);
+    ~JsonStreamWriter();
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+
+    /**
+     * @brief 写出对象的键，之后必须紧跟一个值
+     */
+    void writeKey(const QString& key);
+    void writeString(const QString& value);
+    void writeInt(qint64 value);
+    void writeBool(bool value);
+    void writeNull();
+
+    void writeMember(const QString& key, const QString& value) { writeKey(key); writeString(value); }
+    void writeMember(const QString& key, qint64 value) { writeKey(key); writeInt(value); }
+
+    /**
+     * @brief 把缓冲写入设备，返回至今是否全部写入成功
+     */
+    bool flush();
+    bool hasError() const { return failed; }
+
+private:
+    static const int bufferLimit = 64 * 1024;
+
+    QIODevice* device;
+    QByteArray buffer;
+    QVector<bool> scopeHasItems;    // 每层对象/数组是否已写过成员
+    bool afterKey;
+    bool failed;
+
+    void beginValue();
+    void appendEscaped(const QString& text);
+    void maybeFlush();
+};
+
+#endif // JSONSTREAMWRITER_H
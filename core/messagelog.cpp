@@ -0,0 +1,128 @@
+#include "messagelog.h"
+#include <QDateTime>
+#include <QMutexLocker>
+
+Q_LOGGING_CATEGORY(lcRequest, "rsql.request", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcResponse, "rsql.response", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcConnection, "rsql.connection", QtInfoMsg)
+
+namespace {
+
+const int defaultCapacity = 256;
+const int defaultPreviewBytes = 160;
+
+const char* directionMark(MessageLog::Direction direction)
+{
+    switch (direction) {
+    case MessageLog::Sent:     return ">>";
+    case MessageLog::Received: return "<<";
+    case MessageLog::Pushed:   return "<*";
+    case MessageLog::Failed:   return "!!";
+    }
+    return "??";
+}
+
+} // namespace
+
+MessageLog* MessageLog::instance = nullptr;
+
+MessageLog* MessageLog::getInstance()
+{
+    if (!instance) {
+        instance = new MessageLog();
+    }
+    return instance;
+}
+
+MessageLog::MessageLog()
+    : ring(defaultCapacity), head(0), count(0), previewBytes(defaultPreviewBytes)
+{
+}
+
+void MessageLog::setCapacity(int capacity)
+{
+    QMutexLocker locker(&mutex);
+    ring = QVector<Entry>(qMax(0, capacity));
+    head = 0;
+    count = 0;
+}
+
+int MessageLog::capacity() const
+{
+    QMutexLocker locker(&mutex);
+    return ring.size();
+}
+
+void MessageLog::setPreviewBytes(int bytes)
+{
+    QMutexLocker locker(&mutex);
+    previewBytes = qMax(0, bytes);
+}
+
+bool MessageLog::isEnabled() const
+{
+    QMutexLocker locker(&mutex);
+    return !ring.isEmpty();
+}
+
+void MessageLog::record(Direction direction, const QString& funcid, quint64 requestId,
+                        const QByteArray& data, qint64 elapsedMs)
+{
+    QMutexLocker locker(&mutex);
+    if (ring.isEmpty()) {
+        return;
+    }
+
+    // 覆盖最旧的记录，复用其preview的缓冲区
+    Entry& entry = ring[head];
+    entry.timestampMs = QDateTime::currentMSecsSinceEpoch();
+    entry.direction = direction;
+    entry.funcid = funcid;
+    entry.requestId = requestId;
+    entry.bytes = data.size();
+    entry.elapsedMs = elapsedMs;
+    entry.preview.resize(0);
+    entry.preview.append(data.constData(), qMin(data.size(), previewBytes));
+
+    head = (head + 1) % ring.size();
+    count = qMin(count + 1, ring.size());
+}
+
+void MessageLog::clear()
+{
+    QMutexLocker locker(&mutex);
+    head = 0;
+    count = 0;
+}
+
+QVector<MessageLog::Entry> MessageLog::entries() const
+{
+    QMutexLocker locker(&mutex);
+    QVector<Entry> result;
+    result.reserve(count);
+    int start = (head - count + ring.size()) % qMax(1, ring.size());
+    for (int i = 0; i < count; ++i) {
+        result << ring[(start + i) % ring.size()];
+    }
+    return result;
+}
+
+QString MessageLog::dump() const
+{
+    QString text;
+    for (const Entry& entry : entries()) {
+        QString preview = QString::fromUtf8(entry.preview).simplified();
+        if (entry.bytes > entry.preview.size()) {
+            preview += "...";
+        }
+        text += QString("%1 %2 #%3 %4 %5 B%6  %7\n")
+                .arg(QDateTime::fromMSecsSinceEpoch(entry.timestampMs).toString("yyyy-MM-dd HH:mm:ss.zzz"))
+                .arg(directionMark(entry.direction))
+                .arg(entry.requestId)
+                .arg(entry.funcid)
+                .arg(entry.bytes)
+                .arg(entry.elapsedMs >= 0 ? QString(" %1 ms").arg(entry.elapsedMs) : QString())
+                .arg(preview);
+    }
+    return text;
+}
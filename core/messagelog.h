@@ -0,0 +1,77 @@
+#ifndef MESSAGELOG_H
+#define MESSAGELOG_H
+
+#include <QByteArray>
+#include <QLoggingCategory>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+// 日志分类，默认只输出info及以上；调试时可用QT_LOGGING_RULES或配置项log/filterRules打开，
+// 如"rsql.response.debug=true"。qCDebug在分类未启用时不会格式化参数
+Q_DECLARE_LOGGING_CATEGORY(lcRequest)
+Q_DECLARE_LOGGING_CATEGORY(lcResponse)
+Q_DECLARE_LOGGING_CATEGORY(lcConnection)
+
+/**
+ * @brief 最近请求/应答摘要的环形缓冲
+ * 只记录方向、功能号、请求ID、字节数、耗时和开头的一小段内容，不保留完整载荷，
+ * 容量固定，写满后覆盖最旧的记录，可随时导出。线程安全。
+ */
+class MessageLog
+{
+public:
+    enum Direction {
+        Sent,       // 发出的请求
+        Received,   // 收到的应答
+        Pushed,     // 服务端推送
+        Failed      // 客户端生成的失败应答(未连接、断线等)
+    };
+
+    struct Entry {
+        qint64 timestampMs;     // 记录时间(自纪元起的毫秒)
+        Direction direction;
+        QString funcid;
+        quint64 requestId;
+        qint64 bytes;
+        qint64 elapsedMs;       // 应答相对请求发出的耗时，-1表示不适用
+        QByteArray preview;     // 截断后的开头部分
+    };
+
+    static MessageLog* getInstance();
+
+    /**
+     * @brief 设置环形缓冲的容量，0表示不记录；会清空已有记录
+     */
+    void setCapacity(int capacity);
+    int capacity() const;
+    void setPreviewBytes(int bytes);
+    bool isEnabled() const;
+
+    void record(Direction direction, const QString& funcid, quint64 requestId,
+                const QByteArray& data, qint64 elapsedMs = -1);
+    void clear();
+
+    /**
+     * @brief 按时间顺序返回当前保留的记录
+     */
+    QVector<Entry> entries() const;
+
+    /**
+     * @brief 每条记录一行的文本形式
+     */
+    QString dump() const;
+
+private:
+    MessageLog();
+
+    mutable QMutex mutex;
+    QVector<Entry> ring;
+    int head;           // 下一条记录写入的位置
+    int count;
+    int previewBytes;
+
+    static MessageLog* instance;
+};
+
+#endif // MESSAGELOG_H
@@ -0,0 +1,630 @@
+#include "resultproxymodel.h"
+#include <QtConcurrent>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+// 单个分块的最小行数，行数太少时并行调度的开销大于收益
+const int MIN_CHUNK_ROWS = 16384;
+
+// 把[0, count)切分为连续区间，交给线程池并行处理
+QVector<QPair<int, int>> makeChunks(int count)
+{
+    QVector<QPair<int, int>> chunks;
+    const int threads = qMax(1, QThread::idealThreadCount());
+    const int chunkSize = qMax(MIN_CHUNK_ROWS, (count + threads - 1) / threads);
+    for (int begin = 0; begin < count; begin += chunkSize) {
+        chunks << qMakePair(begin, qMin(count, begin + chunkSize));
+    }
+    return chunks;
+}
+
+inline int compareKeys(double a, double b)
+{
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+inline int compareKeys(int a, int b)
+{
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+inline int compareKeys(const QString& a, const QString& b)
+{
+    return QString::compare(a, b);
+}
+
+struct MergeTask {
+    int begin;
+    int middle;
+    int end;
+};
+
+/**
+ * 并行排序：各分块先在线程池中分别排序，再逐轮两两归并。
+ * 相同键按源行号排序，保证结果稳定且与分块方式无关。
+ */
+template <typename Key>
+void parallelSort(QVector<QPair<Key, int>>& items, Qt::SortOrder order, const QAtomicInt& cancel)
+{
+    typedef QPair<Key, int> Item;
+    auto less = [order](const Item& a, const Item& b) {
+        const int cmp = compareKeys(a.first, b.first);
+        if (cmp != 0) {
+            return order == Qt::AscendingOrder ? cmp < 0 : cmp > 0;
+        }
+        return a.second < b.second;
+    };
+
+    // 提前取得数据指针，避免多个线程同时触发QVector的写时复制
+    Item* data = items.data();
+    QVector<QPair<int, int>> chunks = makeChunks(items.size());
+    QtConcurrent::blockingMap(chunks, [data, &less](const QPair<int, int>& chunk) {
+        std::sort(data + chunk.first, data + chunk.second, less);
+    });
+
+    QVector<int> bounds;
+    for (const auto& chunk : chunks) {
+        bounds << chunk.first;
+    }
+    bounds << items.size();
+
+    while (bounds.size() > 2) {
+        if (cancel.loadAcquire()) {
+            return;
+        }
+        QVector<MergeTask> tasks;
+        for (int i = 0; i + 2 < bounds.size(); i += 2) {
+            tasks << MergeTask{bounds[i], bounds[i + 1], bounds[i + 2]};
+        }
+        QtConcurrent::blockingMap(tasks, [data, &less](const MergeTask& task) {
+            std::inplace_merge(data + task.begin, data + task.middle, data + task.end, less);
+        });
+
+        QVector<int> next;
+        for (int i = 0; i < bounds.size(); i += 2) {
+            next << bounds[i];
+        }
+        if (next.last() != bounds.last()) {
+            next << bounds.last();
+        }
+        bounds = next;
+    }
+}
+
+// 空值与非数字排在最前
+inline double numericKey(const QString& text)
+{
+    bool ok = false;
+    double key = text.toDouble(&ok);
+    return ok ? key : -std::numeric_limits<double>::infinity();
+}
+
+/**
+ * 字典编码列的排序键：对字典排一次序，相等的值得到相同的名次，
+ * 之后每行只比较整数名次
+ */
+QVector<int> dictionaryRanks(const QVector<QString>& dictionary, bool numeric)
+{
+    QVector<double> numbers;
+    if (numeric) {
+        numbers.reserve(dictionary.size());
+        for (const QString& text : dictionary) {
+            numbers << numericKey(text);
+        }
+    }
+    auto compare = [&](int a, int b) {
+        return numeric ? compareKeys(numbers[a], numbers[b]) : compareKeys(dictionary[a], dictionary[b]);
+    };
+
+    QVector<int> order(dictionary.size());
+    for (int i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return compare(a, b) < 0; });
+
+    QVector<int> ranks(dictionary.size());
+    int rank = 0;
+    for (int i = 0; i < order.size(); ++i) {
+        if (i > 0 && compare(order[i - 1], order[i]) != 0) {
+            ++rank;
+        }
+        ranks[order[i]] = rank;
+    }
+    return ranks;
+}
+
+struct FilterChunk {
+    int begin;
+    int end;
+    QVector<int> rows;
+};
+
+} // namespace
+
+ResultProxyModel::ResultProxyModel(QObject *parent)
+    : QAbstractProxyModel(parent), source(nullptr), identity(true),
+      sortColumn(-1), sortOrder(Qt::AscendingOrder), filterRegex(false), filterColumn(-1),
+      pendingRowSetChange(false), restartAfterChange(false), removingWithReset(false)
+{
+    watcher = new QFutureWatcher<QSharedPointer<Job>>(this);
+    connect(watcher, &QFutureWatcher<QSharedPointer<Job>>::finished,
+            this, &ResultProxyModel::onJobFinished);
+}
+
+ResultProxyModel::~ResultProxyModel()
+{
+    cancelJob();
+    watcher->waitForFinished();
+}
+
+void ResultProxyModel::setSourceModel(QAbstractItemModel* sourceModel)
+{
+    cancelJob();
+    beginResetModel();
+
+    if (source) {
+        disconnect(source, nullptr, this, nullptr);
+    }
+    QAbstractProxyModel::setSourceModel(sourceModel);
+    source = qobject_cast<ResultTableModel*>(sourceModel);
+    identity = true;
+    proxyToSource.clear();
+    sourceToProxy.clear();
+
+    if (source) {
+        connect(source, &QAbstractItemModel::modelAboutToBeReset, this, &ResultProxyModel::onSourceAboutToBeReset);
+        connect(source, &QAbstractItemModel::modelReset, this, &ResultProxyModel::onSourceReset);
+        connect(source, &QAbstractItemModel::dataChanged, this, &ResultProxyModel::onSourceDataChanged);
+        connect(source, &QAbstractItemModel::rowsAboutToBeInserted, this, &ResultProxyModel::onSourceRowsAboutToBeInserted);
+        connect(source, &QAbstractItemModel::rowsInserted, this, &ResultProxyModel::onSourceRowsInserted);
+        connect(source, &QAbstractItemModel::rowsAboutToBeRemoved, this, &ResultProxyModel::onSourceRowsAboutToBeRemoved);
+        connect(source, &QAbstractItemModel::rowsRemoved, this, &ResultProxyModel::onSourceRowsRemoved);
+    }
+
+    endResetModel();
+}
+
+void ResultProxyModel::setFilter(const QString& pattern, bool regex, int column)
+{
+    if (pattern == filterPattern && regex == filterRegex && column == filterColumn) {
+        return;
+    }
+    filterPattern = pattern;
+    filterRegex = regex;
+    filterColumn = column;
+    startJob(true);
+}
+
+void ResultProxyModel::sort(int column, Qt::SortOrder order)
+{
+    sortColumn = column;
+    sortOrder = order;
+    startJob(false);
+}
+
+void ResultProxyModel::cancelJob()
+{
+    if (cancelFlag) {
+        cancelFlag->storeRelease(1);
+        cancelFlag.reset();
+    }
+}
+
+void ResultProxyModel::startJob(bool rowSetChanges)
+{
+    cancelJob();
+    pendingRowSetChange = pendingRowSetChange || rowSetChanges;
+
+    // 无排序无筛选，直接恢复原始顺序
+    if (!source || (sortColumn < 0 && filterPattern.isEmpty())) {
+        const bool changed = pendingRowSetChange;
+        pendingRowSetChange = false;
+        if (!identity) {
+            applyMapping(true, QVector<int>(), changed);
+        }
+        emit mappingApplied(rowCount(), 0);
+        return;
+    }
+
+    QSharedPointer<Job> job(new Job);
+    job->store = source->store();
+    job->sortColumn = sortColumn;
+    job->sortOrder = sortOrder;
+    job->filterPattern = filterPattern;
+    job->filterRegex = filterRegex;
+    job->filterColumn = filterColumn;
+    job->rowSetChanges = pendingRowSetChange;
+    job->cancel = QSharedPointer<QAtomicInt>(new QAtomicInt(0));
+    job->elapsedMs = 0;
+    cancelFlag = job->cancel;
+
+    watcher->setFuture(QtConcurrent::run(&ResultProxyModel::runJob, job));
+}
+
+QSharedPointer<ResultProxyModel::Job> ResultProxyModel::runJob(QSharedPointer<Job> job)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const ResultStore& store = job->store;
+    const QAtomicInt& cancel = *job->cancel;
+    const int rowCount = store.rowCount();
+    QVector<int> rows;
+
+    // 1. 筛选：各分块独立匹配，再按顺序拼接
+    if (!job->filterPattern.isEmpty()) {
+        QRegularExpression re(job->filterPattern, QRegularExpression::CaseInsensitiveOption);
+        const bool useRegex = job->filterRegex && re.isValid();
+        if (useRegex) {
+            re.optimize();
+        }
+        const QString pattern = job->filterPattern;
+        const int firstColumn = job->filterColumn >= 0 ? job->filterColumn : 0;
+        const int lastColumn = job->filterColumn >= 0 ? job->filterColumn : store.columnCount() - 1;
+        auto matches = [&](const QString& value) {
+            return useRegex ? re.match(value).hasMatch() : value.contains(pattern, Qt::CaseInsensitive);
+        };
+
+        // 字典编码列的每个不同值只匹配一次，各行按编号查表
+        QVector<QVector<char>> dictionaryMatches(store.columnCount());
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            if (!store.isDictionaryEncoded(column)) {
+                continue;
+            }
+            const QVector<QString>& dictionary = store.dictionary(column);
+            QVector<char>& matched = dictionaryMatches[column];
+            matched.resize(dictionary.size());
+            for (int code = 0; code < dictionary.size(); ++code) {
+                matched[code] = matches(dictionary[code]);
+            }
+        }
+        const QVector<QVector<char>>& dictionaryLookup = dictionaryMatches;
+
+        QVector<FilterChunk> chunks;
+        for (const auto& range : makeChunks(rowCount)) {
+            chunks << FilterChunk{range.first, range.second, QVector<int>()};
+        }
+        QtConcurrent::blockingMap(chunks, [&](FilterChunk& chunk) {
+            for (int row = chunk.begin; row < chunk.end; ++row) {
+                if ((row & 0xFFF) == 0 && cancel.loadAcquire()) {
+                    return;
+                }
+                bool matched = false;
+                for (int column = firstColumn; column <= lastColumn && !matched; ++column) {
+                    const int code = store.dictionaryCode(row, column);
+                    matched = code >= 0 ? dictionaryLookup[column][code] != 0 : matches(store.value(row, column));
+                }
+                if (matched) {
+                    chunk.rows.append(row);
+                }
+            }
+        });
+        for (const auto& chunk : chunks) {
+            rows += chunk.rows;
+        }
+    } else {
+        rows.resize(rowCount);
+        for (int row = 0; row < rowCount; ++row) {
+            rows[row] = row;
+        }
+    }
+
+    if (cancel.loadAcquire()) {
+        return job;
+    }
+
+    // 2. 排序：数值列按数值比较，其余按字符串比较；字典编码列按字典名次比较
+    if (job->sortColumn >= 0 && job->sortColumn < store.columnCount()) {
+        const int column = job->sortColumn;
+        const int count = rows.size();
+        const int* rowData = rows.constData();
+
+        QVector<QPair<int, int>> chunks = makeChunks(count);
+
+        if (store.isDictionaryEncoded(column) && store.allRowsInMemory()) {
+            const QVector<int> ranks = dictionaryRanks(store.dictionary(column), store.isNumericColumn(column));
+            QVector<QPair<int, int>> items(count);
+            QPair<int, int>* itemData = items.data();
+            QtConcurrent::blockingMap(chunks, [&](const QPair<int, int>& chunk) {
+                for (int i = chunk.first; i < chunk.second; ++i) {
+                    itemData[i] = qMakePair(ranks[store.dictionaryCode(rowData[i], column)], rowData[i]);
+                }
+            });
+            parallelSort(items, job->sortOrder, cancel);
+            for (int i = 0; i < count; ++i) {
+                rows[i] = items[i].second;
+            }
+        } else if (store.isNumericColumn(column)) {
+            QVector<QPair<double, int>> items(count);
+            QPair<double, int>* itemData = items.data();
+            QtConcurrent::blockingMap(chunks, [&](const QPair<int, int>& chunk) {
+                for (int i = chunk.first; i < chunk.second; ++i) {
+                    itemData[i] = qMakePair(numericKey(store.value(rowData[i], column)), rowData[i]);
+                }
+            });
+            parallelSort(items, job->sortOrder, cancel);
+            for (int i = 0; i < count; ++i) {
+                rows[i] = items[i].second;
+            }
+        } else {
+            QVector<QPair<QString, int>> items(count);
+            QPair<QString, int>* itemData = items.data();
+            QtConcurrent::blockingMap(chunks, [&](const QPair<int, int>& chunk) {
+                for (int i = chunk.first; i < chunk.second; ++i) {
+                    itemData[i] = qMakePair(store.value(rowData[i], column), rowData[i]);
+                }
+            });
+            parallelSort(items, job->sortOrder, cancel);
+            for (int i = 0; i < count; ++i) {
+                rows[i] = items[i].second;
+            }
+        }
+    }
+
+    job->mapping = rows;
+    job->elapsedMs = timer.elapsed();
+    return job;
+}
+
+void ResultProxyModel::onJobFinished()
+{
+    QSharedPointer<Job> job = watcher->result();
+    // 已被新的请求取代
+    if (!job || job->cancel != cancelFlag || job->cancel->loadAcquire()) {
+        return;
+    }
+    cancelFlag.reset();
+    pendingRowSetChange = false;
+    applyMapping(false, job->mapping, job->rowSetChanges);
+    emit mappingApplied(rowCount(), job->elapsedMs);
+}
+
+void ResultProxyModel::applyMapping(bool toIdentity, const QVector<int>& mapping, bool rowSetChanged)
+{
+    const int newRowCount = toIdentity ? (source ? source->rowCount() : 0) : mapping.size();
+
+    // 可见行集合变化时重置模型，仅顺序变化时保持选中与编辑状态
+    if (rowSetChanged || newRowCount != rowCount()) {
+        beginResetModel();
+        identity = toIdentity;
+        proxyToSource = toIdentity ? QVector<int>() : mapping;
+        rebuildSourceToProxy();
+        endResetModel();
+        return;
+    }
+
+    emit layoutAboutToBeChanged();
+    const QModelIndexList oldList = persistentIndexList();
+    QModelIndexList sourceList;
+    for (const QModelIndex& proxyIndex : oldList) {
+        sourceList << mapToSource(proxyIndex);
+    }
+
+    identity = toIdentity;
+    proxyToSource = toIdentity ? QVector<int>() : mapping;
+    rebuildSourceToProxy();
+
+    QModelIndexList newList;
+    for (const QModelIndex& sourceIndex : sourceList) {
+        newList << mapFromSource(sourceIndex);
+    }
+    changePersistentIndexList(oldList, newList);
+    emit layoutChanged();
+}
+
+void ResultProxyModel::rebuildSourceToProxy()
+{
+    if (identity || !source) {
+        sourceToProxy.clear();
+        return;
+    }
+    sourceToProxy.fill(-1, source->rowCount());
+    for (int i = 0; i < proxyToSource.size(); ++i) {
+        sourceToProxy[proxyToSource[i]] = i;
+    }
+}
+
+QModelIndex ResultProxyModel::index(int row, int column, const QModelIndex& parent) const
+{
+    if (parent.isValid() || row < 0 || row >= rowCount() || column < 0 || column >= columnCount()) {
+        return QModelIndex();
+    }
+    return createIndex(row, column);
+}
+
+QModelIndex ResultProxyModel::parent(const QModelIndex& child) const
+{
+    Q_UNUSED(child);
+    return QModelIndex();
+}
+
+int ResultProxyModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid() || !source) {
+        return 0;
+    }
+    return identity ? source->rowCount() : proxyToSource.size();
+}
+
+int ResultProxyModel::columnCount(const QModelIndex& parent) const
+{
+    if (parent.isValid() || !source) {
+        return 0;
+    }
+    return source->columnCount();
+}
+
+QModelIndex ResultProxyModel::mapToSource(const QModelIndex& proxyIndex) const
+{
+    if (!proxyIndex.isValid() || !source) {
+        return QModelIndex();
+    }
+    const int row = identity ? proxyIndex.row() : proxyToSource.value(proxyIndex.row(), -1);
+    return source->index(row, proxyIndex.column());
+}
+
+QModelIndex ResultProxyModel::mapFromSource(const QModelIndex& sourceIndex) const
+{
+    if (!sourceIndex.isValid()) {
+        return QModelIndex();
+    }
+    const int row = identity ? sourceIndex.row() : sourceToProxy.value(sourceIndex.row(), -1);
+    return index(row, sourceIndex.column());
+}
+
+QVariant ResultProxyModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (!source) {
+        return QVariant();
+    }
+    if (orientation == Qt::Horizontal) {
+        return source->headerData(section, orientation, role);
+    }
+    return QAbstractProxyModel::headerData(section, orientation, role);
+}
+
+void ResultProxyModel::onSourceAboutToBeReset()
+{
+    cancelJob();
+    beginResetModel();
+}
+
+void ResultProxyModel::onSourceReset()
+{
+    identity = true;
+    proxyToSource.clear();
+    sourceToProxy.clear();
+    pendingRowSetChange = false;
+    endResetModel();
+
+    // 新数据沿用当前的排序与筛选条件
+    if (sortColumn >= 0 || !filterPattern.isEmpty()) {
+        startJob(true);
+    } else {
+        emit mappingApplied(rowCount(), 0);
+    }
+}
+
+void ResultProxyModel::onSourceDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles)
+{
+    if (identity) {
+        emit dataChanged(index(topLeft.row(), topLeft.column()),
+                         index(bottomRight.row(), bottomRight.column()), roles);
+        return;
+    }
+    for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+        const int proxyRow = sourceToProxy.value(row, -1);
+        if (proxyRow >= 0) {
+            emit dataChanged(index(proxyRow, topLeft.column()),
+                             index(proxyRow, bottomRight.column()), roles);
+        }
+    }
+}
+
+void ResultProxyModel::onSourceRowsAboutToBeInserted(const QModelIndex& parent, int first, int last)
+{
+    Q_UNUSED(parent);
+    if (identity) {
+        beginInsertRows(QModelIndex(), first, last);
+        return;
+    }
+    restartAfterChange = restartAfterChange || watcher->isRunning();
+    cancelJob();
+}
+
+void ResultProxyModel::onSourceRowsInserted(const QModelIndex& parent, int first, int last)
+{
+    Q_UNUSED(parent);
+    if (identity) {
+        endInsertRows();
+        return;
+    }
+
+    // 已有映射中插入点之后的源行号整体后移，新行先追加到末尾
+    const int count = last - first + 1;
+    for (int& row : proxyToSource) {
+        if (row >= first) {
+            row += count;
+        }
+    }
+    const int proxyFirst = proxyToSource.size();
+    beginInsertRows(QModelIndex(), proxyFirst, proxyFirst + count - 1);
+    for (int row = first; row <= last; ++row) {
+        proxyToSource << row;
+    }
+    rebuildSourceToProxy();
+    endInsertRows();
+
+    // 新行需要重新参与排序与筛选
+    restartAfterChange = false;
+    startJob(!filterPattern.isEmpty());
+}
+
+void ResultProxyModel::onSourceRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last)
+{
+    Q_UNUSED(parent);
+    if (identity) {
+        beginRemoveRows(QModelIndex(), first, last);
+        return;
+    }
+
+    restartAfterChange = restartAfterChange || watcher->isRunning();
+    cancelJob();
+
+    QVector<int> proxyRows;
+    for (int row = first; row <= last; ++row) {
+        const int proxyRow = sourceToProxy.value(row, -1);
+        if (proxyRow >= 0) {
+            proxyRows << proxyRow;
+        }
+    }
+
+    // 单行删除精确通知视图，保持滚动位置与选中状态；批量删除直接重置
+    removingWithReset = proxyRows.size() > 1;
+    if (removingWithReset) {
+        beginResetModel();
+    } else if (proxyRows.size() == 1) {
+        beginRemoveRows(QModelIndex(), proxyRows.first(), proxyRows.first());
+        proxyToSource.remove(proxyRows.first());
+        endRemoveRows();
+    }
+    if (removingWithReset) {
+        for (int i = proxyToSource.size() - 1; i >= 0; --i) {
+            if (proxyToSource[i] >= first && proxyToSource[i] <= last) {
+                proxyToSource.remove(i);
+            }
+        }
+    }
+}
+
+void ResultProxyModel::onSourceRowsRemoved(const QModelIndex& parent, int first, int last)
+{
+    Q_UNUSED(parent);
+    if (identity) {
+        endRemoveRows();
+        return;
+    }
+
+    const int count = last - first + 1;
+    for (int& row : proxyToSource) {
+        if (row > last) {
+            row -= count;
+        }
+    }
+    rebuildSourceToProxy();
+
+    if (removingWithReset) {
+        removingWithReset = false;
+        endResetModel();
+    }
+
+    if (restartAfterChange) {
+        restartAfterChange = false;
+        startJob(pendingRowSetChange);
+    }
+}
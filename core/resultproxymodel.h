@@ -0,0 +1,110 @@
+#ifndef RESULTPROXYMODEL_H
+#define RESULTPROXYMODEL_H
+
+#include <QAbstractProxyModel>
+#include <QFutureWatcher>
+#include <QSharedPointer>
+#include <QAtomicInt>
+#include <QVector>
+#include "resulttablemodel.h"
+
+/**
+ * @brief 已加载结果的客户端排序/筛选代理
+ * 通过行号置换表映射到ResultTableModel，排序和筛选在线程池中并行计算，
+ * 新的排序/筛选请求会取消尚未完成的旧任务。
+ */
+class ResultProxyModel : public QAbstractProxyModel
+{
+    Q_OBJECT
+
+public:
+    explicit ResultProxyModel(QObject *parent = nullptr);
+    ~ResultProxyModel();
+
+    /**
+     * @brief 设置源模型，必须为ResultTableModel
+     */
+    void setSourceModel(QAbstractItemModel* sourceModel) override;
+    ResultTableModel* resultModel() const { return source; }
+
+    /**
+     * @brief 设置筛选条件，pattern为空表示不筛选
+     * @param pattern 子串(不区分大小写)或正则表达式
+     * @param regex pattern是否为正则表达式
+     * @param column 只在该列中匹配，-1表示任意列
+     */
+    void setFilter(const QString& pattern, bool regex, int column = -1);
+
+    /**
+     * @brief 按列排序，column为-1时恢复原始顺序
+     */
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    bool isBusy() const { return watcher->isRunning(); }
+
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& child) const override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex mapToSource(const QModelIndex& proxyIndex) const override;
+    QModelIndex mapFromSource(const QModelIndex& sourceIndex) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+signals:
+    /**
+     * @brief 一次排序/筛选计算完成并生效
+     * @param visibleRows 筛选后的行数
+     * @param elapsedMs 计算耗时
+     */
+    void mappingApplied(int visibleRows, qint64 elapsedMs);
+
+private slots:
+    void onJobFinished();
+    void onSourceAboutToBeReset();
+    void onSourceReset();
+    void onSourceDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles);
+    void onSourceRowsAboutToBeInserted(const QModelIndex& parent, int first, int last);
+    void onSourceRowsInserted(const QModelIndex& parent, int first, int last);
+    void onSourceRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last);
+    void onSourceRowsRemoved(const QModelIndex& parent, int first, int last);
+
+private:
+    // 一次后台计算的参数与结果
+    struct Job {
+        ResultStore store;      // 数据快照
+        int sortColumn;
+        Qt::SortOrder sortOrder;
+        QString filterPattern;
+        bool filterRegex;
+        int filterColumn;
+        bool rowSetChanges;     // 结果是否可能改变可见行集合(筛选变化)
+        QSharedPointer<QAtomicInt> cancel;
+        QVector<int> mapping;   // 计算结果：代理行 -> 源行
+        qint64 elapsedMs;
+    };
+
+    ResultTableModel* source;
+    bool identity;                  // 无排序无筛选时直接透传，不占用映射表
+    QVector<int> proxyToSource;
+    QVector<int> sourceToProxy;     // 被筛掉的行为-1
+
+    int sortColumn;
+    Qt::SortOrder sortOrder;
+    QString filterPattern;
+    bool filterRegex;
+    int filterColumn;
+
+    QFutureWatcher<QSharedPointer<Job>>* watcher;
+    QSharedPointer<QAtomicInt> cancelFlag;
+    bool pendingRowSetChange;       // 被取消的任务是否包含筛选变化，重启时需继承
+    bool restartAfterChange;        // 源模型变化打断了计算，变化完成后重新计算
+    bool removingWithReset;         // 本次删除行以重置模型的方式通知视图
+
+    void startJob(bool rowSetChanges);
+    void cancelJob();
+    void applyMapping(bool toIdentity, const QVector<int>& mapping, bool rowSetChanged);
+    void rebuildSourceToProxy();
+    static QSharedPointer<Job> runJob(QSharedPointer<Job> job);
+};
+
+#endif // RESULTPROXYMODEL_H
@@ -0,0 +1,270 @@
+#include "resultsnapshot.h"
+#include "resultstore.h"
+#include <QSaveFile>
+#include <QtEndian>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+// 文件布局(小端)：
+//   头部   magic[8] | version u32 | columns u32 | rows u64
+//   每列   UTF-8文本 | 补齐到8字节 | (rows+1)个u64偏移
+//   目录   每列 nameLen u32 | name | typeLen u32 | type | dataOffset u64 | indexOffset u64
+//   尾部   directoryOffset u64 | magic[8]
+const char magic[8] = {'R', 'S', 'Q', 'L', 'S', 'N', 'A', 'P'};
+const quint32 formatVersion = 1;
+const qint64 headerSize = 24;
+const qint64 trailerSize = 16;
+const int writeBufferLimit = 1 << 20;
+
+void appendU32(QByteArray& out, quint32 value)
+{
+    char bytes[4];
+    qToLittleEndian(value, reinterpret_cast<uchar*>(bytes));
+    out.append(bytes, 4);
+}
+
+void appendU64(QByteArray& out, quint64 value)
+{
+    char bytes[8];
+    qToLittleEndian(value, reinterpret_cast<uchar*>(bytes));
+    out.append(bytes, 8);
+}
+
+void appendText(QByteArray& out, const QString& text)
+{
+    const QByteArray utf8 = text.toUtf8();
+    appendU32(out, quint32(utf8.size()));
+    out.append(utf8);
+}
+
+/**
+ * @brief 带缓冲的顺序写入，记录当前文件位置
+ */
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(QSaveFile& file) : file(file), position(0), failed(false) {}
+
+    QByteArray buffer;
+    QSaveFile& file;
+    qint64 position;
+    bool failed;
+
+    qint64 pos() const { return position + buffer.size(); }
+
+    void maybeFlush()
+    {
+        if (buffer.size() >= writeBufferLimit) {
+            flush();
+        }
+    }
+
+    bool flush()
+    {
+        if (!failed && !buffer.isEmpty()) {
+            failed = file.write(buffer) != buffer.size();
+            position += buffer.size();
+        }
+        buffer.clear();
+        return !failed;
+    }
+};
+
+bool readU32(const uchar*& pos, const uchar* end, quint32* value)
+{
+    if (end - pos < 4) {
+        return false;
+    }
+    *value = qFromLittleEndian<quint32>(pos);
+    pos += 4;
+    return true;
+}
+
+bool readU64(const uchar*& pos, const uchar* end, quint64* value)
+{
+    if (end - pos < 8) {
+        return false;
+    }
+    *value = qFromLittleEndian<quint64>(pos);
+    pos += 8;
+    return true;
+}
+
+bool readText(const uchar*& pos, const uchar* end, QString* text)
+{
+    quint32 length = 0;
+    if (!readU32(pos, end, &length) || quint64(end - pos) < length) {
+        return false;
+    }
+    *text = QString::fromUtf8(reinterpret_cast<const char*>(pos), int(length));
+    pos += length;
+    return true;
+}
+
+} // namespace
+
+ResultSnapshot::ResultSnapshot() : base(nullptr), size(0), rows(0) {}
+
+ResultSnapshot::~ResultSnapshot()
+{
+    if (base) {
+        file.unmap(const_cast<uchar*>(base));
+    }
+}
+
+bool ResultSnapshot::save(const ResultStore& store, const QString& path, QString* error)
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        if (error) {
+            *error = file.errorString();
+        }
+        return false;
+    }
+
+    const int rowCount = store.rowCount();
+    const int columnCount = store.columnCount();
+    SnapshotWriter writer(file);
+    writer.buffer.append(magic, sizeof(magic));
+    appendU32(writer.buffer, formatVersion);
+    appendU32(writer.buffer, quint32(columnCount));
+    appendU64(writer.buffer, quint64(rowCount));
+
+    // 逐列写出文本，偏移先收集在内存中，列写完后接在文本之后
+    QVector<qint64> dataOffsets(columnCount);
+    QVector<qint64> indexOffsets(columnCount);
+    QVector<quint64> offsets;
+    offsets.reserve(rowCount + 1);
+    for (int column = 0; column < columnCount && !writer.failed; ++column) {
+        dataOffsets[column] = writer.pos();
+        offsets.clear();
+        quint64 offset = 0;
+        for (int row = 0; row < rowCount; ++row) {
+            offsets << offset;
+            const QByteArray text = store.value(row, column).toUtf8();
+            writer.buffer.append(text);
+            offset += quint64(text.size());
+            writer.maybeFlush();
+        }
+        offsets << offset;
+
+        while (writer.pos() % 8 != 0) {
+            writer.buffer.append('\0');
+        }
+        indexOffsets[column] = writer.pos();
+        for (quint64 value : offsets) {
+            appendU64(writer.buffer, value);
+            writer.maybeFlush();
+        }
+    }
+
+    const qint64 directoryOffset = writer.pos();
+    for (int column = 0; column < columnCount; ++column) {
+        appendText(writer.buffer, store.columnNames().value(column));
+        appendText(writer.buffer, store.columnType(column));
+        appendU64(writer.buffer, quint64(dataOffsets[column]));
+        appendU64(writer.buffer, quint64(indexOffsets[column]));
+    }
+    appendU64(writer.buffer, quint64(directoryOffset));
+    writer.buffer.append(magic, sizeof(magic));
+
+    if (!writer.flush() || !file.commit()) {
+        if (error) {
+            *error = file.errorString();
+        }
+        return false;
+    }
+    return true;
+}
+
+QSharedPointer<ResultSnapshot> ResultSnapshot::open(const QString& path, QString* error)
+{
+    QSharedPointer<ResultSnapshot> snapshot(new ResultSnapshot);
+    snapshot->file.setFileName(path);
+    auto fail = [error](const QString& reason) {
+        if (error) {
+            *error = reason;
+        }
+        return QSharedPointer<ResultSnapshot>();
+    };
+
+    if (!snapshot->file.open(QIODevice::ReadOnly)) {
+        return fail(snapshot->file.errorString());
+    }
+    snapshot->size = snapshot->file.size();
+    if (snapshot->size < headerSize + trailerSize) {
+        return fail("不是结果快照文件");
+    }
+    snapshot->base = snapshot->file.map(0, snapshot->size);
+    if (!snapshot->base) {
+        return fail("无法映射文件：" + snapshot->file.errorString());
+    }
+
+    const uchar* const begin = snapshot->base;
+    const uchar* const end = begin + snapshot->size;
+    if (memcmp(begin, magic, sizeof(magic)) != 0 || memcmp(end - sizeof(magic), magic, sizeof(magic)) != 0) {
+        return fail("不是结果快照文件");
+    }
+
+    const uchar* pos = begin + sizeof(magic);
+    quint32 version = 0;
+    quint32 columnCount = 0;
+    quint64 rowCount = 0;
+    readU32(pos, end, &version);
+    readU32(pos, end, &columnCount);
+    readU64(pos, end, &rowCount);
+    if (version != formatVersion) {
+        return fail(QString("不支持的快照版本：%1").arg(version));
+    }
+    if (rowCount > quint64(std::numeric_limits<int>::max())) {
+        return fail("快照行数超出范围");
+    }
+    snapshot->rows = int(rowCount);
+
+    // 只读列目录，并检查每列的索引都落在文件内
+    const uchar* trailer = end - trailerSize;
+    quint64 directoryOffset = 0;
+    readU64(trailer, end, &directoryOffset);
+    if (directoryOffset < quint64(headerSize) || directoryOffset > quint64(snapshot->size - trailerSize)) {
+        return fail("快照文件已损坏");
+    }
+    pos = begin + directoryOffset;
+    const uchar* const directoryEnd = end - trailerSize;
+    const quint64 indexBytes = (rowCount + 1) * 8;
+    for (quint32 i = 0; i < columnCount; ++i) {
+        QString name;
+        QString type;
+        quint64 dataOffset = 0;
+        quint64 indexOffset = 0;
+        if (!readText(pos, directoryEnd, &name) || !readText(pos, directoryEnd, &type)
+                || !readU64(pos, directoryEnd, &dataOffset) || !readU64(pos, directoryEnd, &indexOffset)
+                || dataOffset > indexOffset || indexOffset + indexBytes > directoryOffset) {
+            return fail("快照文件已损坏");
+        }
+        // 最后一个偏移即该列文本的总长度
+        const quint64 dataBytes = qFromLittleEndian<quint64>(begin + indexOffset + rowCount * 8);
+        if (dataOffset + dataBytes > indexOffset) {
+            return fail("快照文件已损坏");
+        }
+        snapshot->names << name;
+        snapshot->types << type;
+        snapshot->columns.append({qint64(dataOffset), qint64(indexOffset)});
+    }
+    return snapshot;
+}
+
+QString ResultSnapshot::value(int row, int column) const
+{
+    if (row < 0 || row >= rows || column < 0 || column >= columns.size()) {
+        return QString();
+    }
+    const Column& info = columns[column];
+    const uchar* index = base + info.indexOffset + qint64(row) * 8;
+    const quint64 begin = qFromLittleEndian<quint64>(index);
+    const quint64 end = qFromLittleEndian<quint64>(index + 8);
+    if (end < begin || qint64(end) > info.indexOffset - info.dataOffset) {
+        return QString();
+    }
+    return QString::fromUtf8(reinterpret_cast<const char*>(base + info.dataOffset + begin), int(end - begin));
+}
@@ -0,0 +1,59 @@
+#ifndef RESULTSNAPSHOT_H
+#define RESULTSNAPSHOT_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QFile>
+#include <QSharedPointer>
+
+class ResultStore;
+
+/**
+ * @brief 保存在磁盘上的结果快照
+ * 文件按列存放：每列是连续的UTF-8文本加一个(行数+1)项的偏移索引，文件末尾是列目录。
+ * 打开时只映射文件并读取列目录，单元格在访问时直接从映射中解码，不解析、不走网络，
+ * 大小只受地址空间限制。映射只读，可被后台排序/筛选线程并发访问。
+ */
+class ResultSnapshot {
+public:
+    ~ResultSnapshot();
+
+    /**
+     * @brief 把结果写成快照文件，写完后整体替换目标文件
+     * @param error 失败时输出原因
+     */
+    static bool save(const ResultStore& store, const QString& path, QString* error = nullptr);
+
+    /**
+     * @brief 映射快照文件，失败返回空指针
+     */
+    static QSharedPointer<ResultSnapshot> open(const QString& path, QString* error = nullptr);
+
+    QString filePath() const { return file.fileName(); }
+    qint64 fileSize() const { return size; }
+    int rowCount() const { return rows; }
+    int columnCount() const { return names.size(); }
+    const QStringList& columnNames() const { return names; }
+    const QStringList& columnTypes() const { return types; }
+
+    QString value(int row, int column) const;
+
+private:
+    struct Column {
+        qint64 dataOffset;      // 文本区起始位置
+        qint64 indexOffset;     // 偏移索引起始位置，每项8字节，相对dataOffset
+    };
+
+    ResultSnapshot();
+
+    QFile file;
+    const uchar* base;
+    qint64 size;
+    int rows;
+    QStringList names;
+    QStringList types;
+    QVector<Column> columns;
+};
+
+#endif // RESULTSNAPSHOT_H
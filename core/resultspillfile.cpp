@@ -0,0 +1,154 @@
+#include "resultspillfile.h"
+#include <QDir>
+
+namespace {
+
+void writeVarint(QByteArray& out, quint32 value)
+{
+    while (value >= 0x80) {
+        out.append(char((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.append(char(value));
+}
+
+quint32 readVarint(const char*& pos, const char* end)
+{
+    quint32 value = 0;
+    int shift = 0;
+    while (pos < end) {
+        quint8 byte = quint8(*pos++);
+        value |= quint32(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            break;
+        }
+        shift += 7;
+    }
+    return value;
+}
+
+} // namespace
+
+ResultSpillFile::ResultSpillFile(int columnCount)
+    : columns(columnCount), rows(0), writtenBytes(0), pageCache(pageCacheBytes)
+{
+    file.setFileTemplate(QDir::tempPath() + "/rsqlite_spill_XXXXXX.bin");
+    opened = file.open();
+}
+
+bool ResultSpillFile::appendRow(const QStringList& values)
+{
+    QMutexLocker locker(&mutex);
+    if (!opened) {
+        return false;
+    }
+    if (rows % rowsPerPage == 0) {
+        pageOffsets << writtenBytes + writeBuffer.size();
+    }
+    for (int column = 0; column < columns; ++column) {
+        const QByteArray text = values.value(column).toUtf8();
+        writeVarint(writeBuffer, quint32(text.size()));
+        writeBuffer.append(text);
+    }
+    ++rows;
+    // 已缓存的同一页是按追加前的行数解码的，作废后下次读取时重新解码
+    pageCache.remove((rows - 1) / rowsPerPage);
+
+    if (writeBuffer.size() >= writeBufferLimit) {
+        return flush();
+    }
+    return true;
+}
+
+bool ResultSpillFile::flush() const
+{
+    if (writeBuffer.isEmpty()) {
+        return true;
+    }
+    if (!file.seek(writtenBytes) || file.write(writeBuffer) != writeBuffer.size()) {
+        return false;
+    }
+    writtenBytes += writeBuffer.size();
+    writeBuffer.clear();
+    return true;
+}
+
+ResultSpillFile::Page* ResultSpillFile::loadPage(int page) const
+{
+    // 最后一页可能还在写缓冲中
+    if (!flush()) {
+        return nullptr;
+    }
+    const qint64 begin = pageOffsets[page];
+    const qint64 end = page + 1 < pageOffsets.size() ? pageOffsets[page + 1] : writtenBytes;
+    if (!file.seek(begin)) {
+        return nullptr;
+    }
+    const QByteArray bytes = file.read(end - begin);
+
+    const int pageRows = qMin(rowsPerPage, rows - page * rowsPerPage);
+    Page* cells = new Page;
+    cells->reserve(pageRows * columns);
+    const char* pos = bytes.constData();
+    const char* limit = pos + bytes.size();
+    for (int i = 0; i < pageRows * columns && pos < limit; ++i) {
+        int length = int(readVarint(pos, limit));
+        length = int(qMin<qint64>(length, limit - pos));
+        cells->append(QString::fromUtf8(pos, length));
+        pos += length;
+    }
+    cells->resize(pageRows * columns);
+    return cells;
+}
+
+QString ResultSpillFile::value(int row, int column) const
+{
+    QMutexLocker locker(&mutex);
+    if (!opened || row < 0 || row >= rows || column < 0 || column >= columns) {
+        return QString();
+    }
+
+    const int page = row / rowsPerPage;
+    const int index = (row % rowsPerPage) * columns + column;
+    if (Page* cells = pageCache.object(page)) {
+        return cells->value(index);
+    }
+
+    Page* cells = loadPage(page);
+    if (!cells) {
+        return QString();
+    }
+    const QString result = cells->value(index);
+    pageCache.insert(page, cells, pageCost(*cells));
+    return result;
+}
+
+int ResultSpillFile::pageCost(const Page& cells)
+{
+    // 按近似字节数计入缓存开销，超出上限的页会被QCache直接释放
+    int cost = 0;
+    for (const QString& text : cells) {
+        cost += 16 + text.size() * 2;
+    }
+    return qMax(1, cost);
+}
+
+void ResultSpillFile::prefetchRows(const QVector<int>& rows) const
+{
+    int lastPage = -1;
+    for (int row : rows) {
+        const int page = row / rowsPerPage;
+        if (page == lastPage) {
+            continue;
+        }
+        lastPage = page;
+        // 每页单独加锁，界面线程的读取不必等整批预取完成
+        QMutexLocker locker(&mutex);
+        if (!opened || row < 0 || row >= this->rows || pageCache.contains(page)) {
+            continue;
+        }
+        if (Page* cells = loadPage(page)) {
+            pageCache.insert(page, cells, pageCost(*cells));
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef RESULTSPILLFILE_H
+#define RESULTSPILLFILE_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QTemporaryFile>
+#include <QMutex>
+#include <QCache>
+
+/**
+ * @brief 结果集溢出到磁盘的部分
+ * 行按紧凑格式顺序写入临时文件：每个单元格为变长长度前缀加UTF-8文本。
+ * 每rowsPerPage行记录一个文件偏移，读取时按页解码并放入有上限的页缓存，
+ * 因此无论结果多大，内存中只有偏移索引和少量页。读取加锁，可被后台排序/筛选线程并发访问。
+ */
+class ResultSpillFile {
+public:
+    explicit ResultSpillFile(int columnCount);
+
+    bool isOpen() const { return opened; }
+    int rowCount() const { return rows; }
+    qint64 fileSize() const { return writtenBytes + writeBuffer.size(); }
+
+    /**
+     * @brief 追加一行，values按列顺序排列
+     */
+    bool appendRow(const QStringList& values);
+
+    /**
+     * @brief 读取单元格，所在页不在缓存中时从文件解码整页
+     */
+    QString value(int row, int column) const;
+
+    /**
+     * @brief 预先把这些行所在的页解码进缓存，供后台线程在滚动到达之前调用
+     */
+    void prefetchRows(const QVector<int>& rows) const;
+
+private:
+    typedef QVector<QString> Page;      // 一页的单元格，按行优先排列
+
+    static const int rowsPerPage = 256;
+    static const int writeBufferLimit = 1 << 20;
+    static const int pageCacheBytes = 16 << 20;
+
+    int columns;
+    int rows;
+    bool opened;
+    mutable QTemporaryFile file;
+    QVector<qint64> pageOffsets;        // 每页第一行在文件中的偏移
+    mutable QByteArray writeBuffer;     // 尚未写入文件的行
+    mutable qint64 writtenBytes;
+    mutable QMutex mutex;
+    mutable QCache<int, Page> pageCache;
+
+    bool flush() const;
+    Page* loadPage(int page) const;
+    static int pageCost(const Page& cells);
+};
+
+#endif // RESULTSPILLFILE_H
@@ -0,0 +1,591 @@
+#include "resultstore.h"
+#include "resultspillfile.h"
+#include "resultsnapshot.h"
+#include "tabledata.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+qint64 defaultBudget = 0;
+
+// 去掉响应外层的引号与转义，与TableData::parseResponse的处理一致
+QByteArray unwrapResponse(const QByteArray& data)
+{
+    QByteArray json = data.trimmed();
+    if (json.size() >= 2 && json.startsWith('"') && json.endsWith('"')) {
+        json = json.mid(1, json.size() - 2);
+        json.replace("\\\"", "\"");
+        json.replace("\\\\", "\\");
+    }
+    return json;
+}
+
+void skipSpace(const char*& pos, const char* end)
+{
+    while (pos < end && (*pos == ' ' || *pos == '\n' || *pos == '\r' || *pos == '\t')) {
+        ++pos;
+    }
+}
+
+// 读取一个JSON字符串，pos指向开头的引号，返回后指向结尾引号之后
+QString readString(const char*& pos, const char* end)
+{
+    const char* begin = ++pos;
+    while (pos < end && *pos != '"' && *pos != '\\') {
+        ++pos;
+    }
+    if (pos < end && *pos == '"') {
+        // 没有转义符的常见情况直接解码
+        QString text = QString::fromUtf8(begin, int(pos - begin));
+        ++pos;
+        return text;
+    }
+
+    QByteArray bytes(begin, int(pos - begin));
+    QString text;
+    while (pos < end && *pos != '"') {
+        if (*pos != '\\') {
+            bytes.append(*pos++);
+            continue;
+        }
+        if (++pos >= end) {
+            break;
+        }
+        char c = *pos++;
+        switch (c) {
+        case 'b': bytes.append('\b'); break;
+        case 'f': bytes.append('\f'); break;
+        case 'n': bytes.append('\n'); break;
+        case 'r': bytes.append('\r'); break;
+        case 't': bytes.append('\t'); break;
+        case 'u': {
+            ushort code = ushort(QByteArray(pos, int(qMin<qint64>(4, end - pos))).toUShort(nullptr, 16));
+            pos += qMin<qint64>(4, end - pos);
+            text += QString::fromUtf8(bytes);
+            bytes.clear();
+            text += QChar(code);    // 代理对的两半依次追加后即组成完整字符
+            break;
+        }
+        default: bytes.append(c); break;
+        }
+    }
+    if (pos < end) {
+        ++pos;
+    }
+    return text + QString::fromUtf8(bytes);
+}
+
+// 跳过一个任意JSON值，返回其原始文本
+QByteArray skipValue(const char*& pos, const char* end)
+{
+    const char* begin = pos;
+    int depth = 0;
+    bool inString = false;
+    bool escaped = false;
+    while (pos < end) {
+        char c = *pos;
+        if (inString) {
+            if (escaped) {
+                escaped = false;
+            } else if (c == '\\') {
+                escaped = true;
+            } else if (c == '"') {
+                inString = false;
+            }
+        } else if (c == '"') {
+            inString = true;
+        } else if (c == '{' || c == '[') {
+            ++depth;
+        } else if (c == '}' || c == ']') {
+            if (depth == 0) {
+                break;
+            }
+            --depth;
+        } else if (c == ',' && depth == 0) {
+            break;
+        }
+        ++pos;
+    }
+    return QByteArray(begin, int(pos - begin)).trimmed();
+}
+
+} // namespace
+
+ResultStore::ResultStore()
+    : rows(0), memoryBudget(defaultBudget), memoryBytes(0), memoryRows(0) {}
+
+void ResultStore::setDefaultMemoryBudget(qint64 bytes) {
+    defaultBudget = qMax<qint64>(0, bytes);
+}
+
+qint64 ResultStore::defaultMemoryBudget() {
+    return defaultBudget;
+}
+
+void ResultStore::setColumns(const QStringList& names, const QStringList& types) {
+    this->names = names;
+    this->types = types;
+    columns = QVector<ColumnData>(names.size());
+    rows = 0;
+    memoryBytes = 0;
+    memoryRows = 0;
+    spill.reset();
+    mapped.reset();
+    removedSpillRows.clear();
+    spillEdits.clear();
+}
+
+void ResultStore::setValue(int row, int column, const QString& value) {
+    if (row < memoryRows) {
+        ColumnData& data = columns[column];
+        const qint64 before = data.bytes;
+        setCell(data, row, value);
+        memoryBytes += data.bytes - before;
+        return;
+    }
+    spillEdits.insert(qint64(spillFileRow(row - memoryRows)) * columnCount() + column, value);
+}
+
+void ResultStore::appendRow(const QStringList& values) {
+    if (mapped) {
+        // 快照映射只读，行号已全部落在映射中，无处追加
+        return;
+    }
+    if (!spill && (memoryBudget <= 0 || memoryBytes < memoryBudget)) {
+        for (int column = 0; column < columns.size(); ++column) {
+            ColumnData& data = columns[column];
+            const qint64 before = data.bytes;
+            appendCell(data, values.value(column));
+            memoryBytes += data.bytes - before;
+        }
+        ++memoryRows;
+        ++rows;
+        return;
+    }
+
+    // 超出预算后的行全部写入磁盘，保持行序；只有界面线程持有的那份会追加
+    if (!spill) {
+        spill = QSharedPointer<ResultSpillFile>::create(columnCount());
+        if (!spill->isOpen()) {
+            // 无法创建临时文件时退回全部放在内存中
+            spill.reset();
+            memoryBudget = 0;
+            appendRow(values);
+            return;
+        }
+    }
+    spill->appendRow(values);
+    ++rows;
+}
+
+void ResultStore::removeRow(int row) {
+    if (row < memoryRows) {
+        for (auto& data : columns) {
+            const qint64 before = data.bytes;
+            removeCell(data, row);
+            memoryBytes += data.bytes - before;
+        }
+        --memoryRows;
+    } else {
+        // 文件中的行不移动，只记录被删除的文件行号
+        int fileRow = spillFileRow(row - memoryRows);
+        removedSpillRows.insert(std::lower_bound(removedSpillRows.begin(), removedSpillRows.end(), fileRow),
+                                fileRow);
+    }
+    --rows;
+}
+
+void ResultStore::removeRows(const QVector<int>& sortedRows) {
+    if (sortedRows.isEmpty()) {
+        return;
+    }
+    // 溢出行按删除前的状态换算成文件行号，换算结果同样升序
+    int memoryRemoved = 0;
+    QVector<int> fileRows;
+    for (int row : sortedRows) {
+        if (row < memoryRows) {
+            ++memoryRemoved;
+        } else {
+            fileRows << spillFileRow(row - memoryRows);
+        }
+    }
+
+    if (memoryRemoved > 0) {
+        for (auto& data : columns) {
+            const qint64 before = data.bytes;
+            removeCells(data, sortedRows, memoryRemoved);
+            memoryBytes += data.bytes - before;
+        }
+        memoryRows -= memoryRemoved;
+    }
+    if (!fileRows.isEmpty()) {
+        QVector<int> merged;
+        merged.reserve(removedSpillRows.size() + fileRows.size());
+        std::merge(removedSpillRows.begin(), removedSpillRows.end(), fileRows.begin(), fileRows.end(),
+                   std::back_inserter(merged));
+        removedSpillRows = merged;
+    }
+    rows -= sortedRows.size();
+}
+
+void ResultStore::reserve(int rowCount) {
+    // 有预算时行数不代表内存中的行数，交给QVector自行增长
+    if (spill || mapped || memoryBudget > 0) {
+        return;
+    }
+    for (auto& data : columns) {
+        if (data.encoded) {
+            data.codes.reserve(rowCount);
+        } else {
+            data.values.reserve(rowCount);
+        }
+    }
+}
+
+void ResultStore::clear() {
+    names.clear();
+    types.clear();
+    columns.clear();
+    rows = 0;
+    memoryBytes = 0;
+    memoryRows = 0;
+    spill.reset();
+    mapped.reset();
+    removedSpillRows.clear();
+    spillEdits.clear();
+}
+
+quint16 ResultStore::internValue(ColumnData& data, const QString& text) {
+    auto it = data.lookup.constFind(text);
+    if (it != data.lookup.constEnd()) {
+        return quint16(it.value());
+    }
+    const int code = data.dictionary.size();
+    data.dictionary.append(text);
+    data.lookup.insert(text, code);
+    data.bytes += cellBytes(text) * 2;  // 字典与查找表各一份
+    return quint16(code);
+}
+
+void ResultStore::appendCell(ColumnData& data, const QString& text) {
+    data.plainBytes += cellBytes(text);
+    if (!data.encoded) {
+        data.values.append(text);
+        data.bytes += cellBytes(text);
+        return;
+    }
+
+    data.codes.append(internValue(data, text));
+    data.bytes += sizeof(quint16);
+    // 不同值太多时字典不再划算
+    if (data.dictionary.size() > dictionaryLimit
+            || (data.codes.size() >= dictionaryProbeRows && data.dictionary.size() > data.codes.size() / 4)) {
+        decodeColumn(data);
+    }
+}
+
+void ResultStore::setCell(ColumnData& data, int row, const QString& text) {
+    data.plainBytes += cellBytes(text) - cellBytes(data.at(row));
+    if (!data.encoded) {
+        data.bytes += cellBytes(text) - cellBytes(data.values[row]);
+        data.values[row] = text;
+        return;
+    }
+    // 旧值留在字典中，编号不会失效
+    data.codes[row] = internValue(data, text);
+    if (data.dictionary.size() > dictionaryLimit) {
+        decodeColumn(data);
+    }
+}
+
+void ResultStore::removeCell(ColumnData& data, int row) {
+    data.plainBytes -= cellBytes(data.at(row));
+    if (data.encoded) {
+        data.codes.remove(row);
+        data.bytes -= sizeof(quint16);
+    } else {
+        data.bytes -= cellBytes(data.values[row]);
+        data.values.remove(row);
+    }
+}
+
+void ResultStore::removeCells(ColumnData& data, const QVector<int>& rows, int count) {
+    // 从第一个被删除的行开始，把保留的行依次前移
+    const int size = data.encoded ? data.codes.size() : data.values.size();
+    int next = 0;
+    int write = rows.first();
+    for (int row = rows.first(); row < size; ++row) {
+        if (next < count && row == rows[next]) {
+            ++next;
+            data.plainBytes -= cellBytes(data.at(row));
+            data.bytes -= data.encoded ? qint64(sizeof(quint16)) : cellBytes(data.values[row]);
+            continue;
+        }
+        if (data.encoded) {
+            data.codes[write] = data.codes[row];
+        } else {
+            data.values[write] = data.values[row];
+        }
+        ++write;
+    }
+    if (data.encoded) {
+        data.codes.resize(write);
+    } else {
+        data.values.resize(write);
+    }
+}
+
+void ResultStore::decodeColumn(ColumnData& data) {
+    // 逐行引用字典中的QString，文本数据仍然共享
+    data.values.resize(data.codes.size());
+    for (int row = 0; row < data.codes.size(); ++row) {
+        data.values[row] = data.dictionary[data.codes[row]];
+    }
+    data.encoded = false;
+    data.codes = QVector<quint16>();
+    data.dictionary = QVector<QString>();
+    data.lookup = QHash<QString, int>();
+    data.bytes = data.plainBytes;
+}
+
+QVector<int> ResultStore::spillFileRows(const QVector<int>& rows) const {
+    // 快照映射由操作系统按需换页，这里只处理溢出文件
+    QVector<int> fileRows;
+    if (!spill) {
+        return fileRows;
+    }
+    for (int row : rows) {
+        if (row >= memoryRows && row < this->rows) {
+            fileRows << spillFileRow(row - memoryRows);
+        }
+    }
+    std::sort(fileRows.begin(), fileRows.end());
+    return fileRows;
+}
+
+int ResultStore::spillFileRow(int spilledRow) const {
+    // 逻辑行号加上其前面已删除的文件行数，反复修正直到稳定
+    int fileRow = spilledRow;
+    int skipped = 0;
+    forever {
+        int removed = int(std::upper_bound(removedSpillRows.begin(), removedSpillRows.end(), fileRow)
+                          - removedSpillRows.begin());
+        if (removed == skipped) {
+            return fileRow;
+        }
+        skipped = removed;
+        fileRow = spilledRow + removed;
+    }
+}
+
+QString ResultStore::spilledValue(int spilledRow, int column) const {
+    const int fileRow = spillFileRow(spilledRow);
+    if (!spillEdits.isEmpty()) {
+        auto it = spillEdits.constFind(qint64(fileRow) * columnCount() + column);
+        if (it != spillEdits.constEnd()) {
+            return it.value();
+        }
+    }
+    if (spill) {
+        return spill->value(fileRow, column);
+    }
+    return mapped ? mapped->value(fileRow, column) : QString();
+}
+
+bool ResultStore::isNumericColumn(int column) const {
+    const QString type = columnType(column).toUpper();
+    if (type.contains("INT") || type.contains("REAL") || type.contains("FLOA")
+            || type.contains("DOUB") || type.contains("NUM") || type.contains("DEC")) {
+        return true;
+    }
+    if (type.contains("CHAR") || type.contains("TEXT") || type.contains("CLOB") || type.contains("BLOB")) {
+        return false;
+    }
+
+    // 类型未知时抽样：非空值全部能转换为数字才按数值比较
+    int checked = 0;
+    for (int row = 0; row < rows && checked < 100; ++row) {
+        const QString text = value(row, column);
+        if (text.isEmpty()) {
+            continue;
+        }
+        bool ok = false;
+        text.toDouble(&ok);
+        if (!ok) {
+            return false;
+        }
+        ++checked;
+    }
+    return checked > 0;
+}
+
+ResultStore ResultStore::fromJsonObject(const QJsonObject& obj) {
+    ResultStore store;
+
+    QJsonObject columnsObj = obj["columns"].toObject();
+    QStringList names;
+    QStringList types;
+    for (auto it = columnsObj.begin(); it != columnsObj.end(); ++it) {
+        names << it.key();
+        types << it.value().toString();
+    }
+    store.setColumns(names, types);
+
+    QJsonArray rowsArray = obj["rows"].toArray();
+    store.reserve(rowsArray.size());
+    QStringList values;
+    for (const auto& row : rowsArray) {
+        QJsonObject rowObj = row.toObject();
+        values.clear();
+        for (int column = 0; column < names.size(); ++column) {
+            values << TableData::cellText(rowObj[names[column]]);
+        }
+        store.appendRow(values);
+    }
+    return store;
+}
+
+ResultStore ResultStore::fromSnapshot(const QSharedPointer<const ResultSnapshot>& snapshot) {
+    ResultStore store;
+    if (!snapshot) {
+        return store;
+    }
+    store.setColumns(snapshot->columnNames(), snapshot->columnTypes());
+    store.mapped = snapshot;
+    store.rows = snapshot->rowCount();
+    return store;
+}
+
+ResultStore ResultStore::fromResponse(const QByteArray& data, QJsonObject* header, bool* ok) {
+    ResultStore store;
+    const QByteArray json = unwrapResponse(data);
+    const char* const begin = json.constData();
+    const char* const end = begin + json.size();
+
+    // 1. 在顶层对象中找到rows数组的范围
+    const char* rowsBegin = nullptr;
+    const char* rowsEnd = nullptr;
+    const char* pos = begin;
+    skipSpace(pos, end);
+    if (pos < end && *pos == '{') {
+        ++pos;
+        while (pos < end) {
+            skipSpace(pos, end);
+            if (pos >= end || *pos == '}' || *pos != '"') {
+                break;
+            }
+            const QString key = readString(pos, end);
+            skipSpace(pos, end);
+            if (pos >= end || *pos != ':') {
+                break;
+            }
+            ++pos;
+            skipSpace(pos, end);
+            const char* valueBegin = pos;
+            skipValue(pos, end);
+            if (key == "rows") {
+                rowsBegin = valueBegin;
+                rowsEnd = pos;
+            }
+            skipSpace(pos, end);
+            if (pos < end && *pos == ',') {
+                ++pos;
+            }
+        }
+    }
+
+    // 2. 去掉rows后解析其余字段，数据量很小
+    QByteArray headerJson = json;
+    if (rowsBegin) {
+        headerJson = json.left(int(rowsBegin - begin)) + "[]" + json.mid(int(rowsEnd - begin));
+    }
+    QJsonDocument doc = QJsonDocument::fromJson(headerJson);
+    if (ok) {
+        *ok = doc.isObject();
+    }
+    if (header) {
+        *header = doc.object();
+    }
+    if (!doc.isObject()) {
+        return store;
+    }
+
+    QJsonObject columnsObj = doc.object()["columns"].toObject();
+    QStringList names;
+    QStringList types;
+    QHash<QString, int> columnOf;
+    for (auto it = columnsObj.begin(); it != columnsObj.end(); ++it) {
+        columnOf.insert(it.key(), names.size());
+        names << it.key();
+        types << it.value().toString();
+    }
+    store.setColumns(names, types);
+    if (!rowsBegin || names.isEmpty()) {
+        return store;
+    }
+
+    // 3. 逐行解码，行对象只有一层，字符串值直接取出，其他值保留原文
+    pos = rowsBegin;
+    if (pos < rowsEnd && *pos == '[') {
+        ++pos;
+    }
+    QStringList values;
+    while (pos < rowsEnd) {
+        skipSpace(pos, rowsEnd);
+        if (pos >= rowsEnd || *pos == ']') {
+            break;
+        }
+        if (*pos == ',') {
+            ++pos;
+            continue;
+        }
+        if (*pos != '{') {
+            skipValue(pos, rowsEnd);
+            continue;
+        }
+
+        ++pos;
+        values = QStringList();
+        values.reserve(names.size());
+        for (int i = 0; i < names.size(); ++i) {
+            values << QString();
+        }
+        while (pos < rowsEnd) {
+            skipSpace(pos, rowsEnd);
+            if (pos >= rowsEnd || *pos == '}') {
+                ++pos;
+                break;
+            }
+            if (*pos == ',') {
+                ++pos;
+                continue;
+            }
+            if (*pos != '"') {
+                skipValue(pos, rowsEnd);
+                continue;
+            }
+            const QString key = readString(pos, rowsEnd);
+            skipSpace(pos, rowsEnd);
+            if (pos < rowsEnd && *pos == ':') {
+                ++pos;
+            }
+            skipSpace(pos, rowsEnd);
+            QString text;
+            if (pos < rowsEnd && *pos == '"') {
+                text = readString(pos, rowsEnd);
+            } else {
+                QByteArray raw = skipValue(pos, rowsEnd);
+                text = raw == "null" ? QString() : QString::fromUtf8(raw);
+            }
+            int column = columnOf.value(key, -1);
+            if (column >= 0) {
+                values[column] = text;
+            }
+        }
+        store.appendRow(values);
+    }
+    return store;
+}
@@ -0,0 +1,176 @@
+#ifndef RESULTSTORE_H
+#define RESULTSTORE_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QJsonObject>
+#include <QHash>
+#include <QSharedPointer>
+
+class ResultSpillFile;
+class ResultSnapshot;
+
+/**
+ * @brief 查询结果的按列存储
+ * 每列一份数据，拷贝整个ResultStore只增加引用计数，
+ * 后台排序/筛选任务可以持有一份快照，不受界面线程后续修改的影响。
+ * 设置了内存预算时，超出预算的行写入临时文件(ResultSpillFile)，按页读回，
+ * 溢出部分的修改和删除记录在内存中的覆盖表里。
+ * 由快照(ResultSnapshot)打开的结果全部行都从文件映射中读取，同样支持修改和删除，但不能追加。
+ * 内存中的列默认按字典编码：不同值只存一份，每行存一个16位编号；
+ * 不同值过多(超过dictionaryLimit，或超过行数的1/4)时自动改为逐行存放
+ */
+class ResultStore {
+public:
+    ResultStore();
+
+    /**
+     * @brief 设置列名和对应的数据类型，会清空已有数据
+     */
+    void setColumns(const QStringList& names, const QStringList& types);
+
+    const QStringList& columnNames() const { return names; }
+    QString columnType(int column) const { return types.value(column); }
+    int columnIndex(const QString& name) const { return names.indexOf(name); }
+
+    int rowCount() const { return rows; }
+    int columnCount() const { return names.size(); }
+    bool isEmpty() const { return rows == 0; }
+
+    QString value(int row, int column) const
+    {
+        return row < memoryRows ? columns[column].at(row) : spilledValue(row - memoryRows, column);
+    }
+    void setValue(int row, int column, const QString& value);
+
+    /**
+     * @brief 设置内存预算(字节)，超出后追加的行写入磁盘，0表示不限制
+     */
+    void setMemoryBudget(qint64 bytes) { memoryBudget = bytes; }
+    bool isSpilled() const { return !spill.isNull(); }
+    bool isMapped() const { return !mapped.isNull(); }
+    int spilledRowCount() const { return rows - memoryRows; }
+    qint64 memoryUsage() const { return memoryBytes; }
+
+    /**
+     * @brief 列是否按字典编码
+     */
+    bool isDictionaryEncoded(int column) const { return columns[column].encoded; }
+
+    /**
+     * @brief 行的字典编号，列未编码或该行不在内存中时返回-1
+     * 编号可作为dictionary()的下标；字典中可能残留已无行引用的值
+     */
+    int dictionaryCode(int row, int column) const
+    {
+        const ColumnData& data = columns[column];
+        return data.encoded && row < memoryRows ? data.codes[row] : -1;
+    }
+    const QVector<QString>& dictionary(int column) const { return columns[column].dictionary; }
+
+    /**
+     * @brief 即将显示的溢出行在溢出文件中的行号(升序)，内存中与快照映射的行不在其中。
+     * 在界面线程换算后，把文件行号与spillFile()交给后台调用ResultSpillFile::prefetchRows，
+     * 不必复制整个结果
+     */
+    QVector<int> spillFileRows(const QVector<int>& rows) const;
+    QSharedPointer<ResultSpillFile> spillFile() const { return spill; }
+
+    /**
+     * @brief 全部行都在内存中(没有溢出或映射的行)
+     */
+    bool allRowsInMemory() const { return memoryRows == rows; }
+
+    /**
+     * @brief 列在内存中的估算占用，以及不做字典编码时的估算占用(字节)
+     */
+    qint64 columnMemoryUsage(int column) const { return columns[column].bytes; }
+    qint64 columnPlainBytes(int column) const { return columns[column].plainBytes; }
+
+    /**
+     * @brief 新建结果使用的默认内存预算，0表示不限制
+     */
+    static void setDefaultMemoryBudget(qint64 bytes);
+    static qint64 defaultMemoryBudget();
+
+    /**
+     * @brief 追加一行，values按列顺序排列
+     */
+    void appendRow(const QStringList& values);
+    void removeRow(int row);
+
+    /**
+     * @brief 删除多行，sortedRows按升序排列且不重复；内存中的每列只移动一遍
+     */
+    void removeRows(const QVector<int>& sortedRows);
+    void reserve(int rowCount);
+    void clear();
+
+    /**
+     * @brief 判断某列是否应按数值比较
+     * 优先使用服务端返回的列类型，类型未知时抽样判断
+     */
+    bool isNumericColumn(int column) const;
+
+    /**
+     * @brief 由响应JSON对象构造结果存储，列按columns中的键顺序排列
+     */
+    static ResultStore fromJsonObject(const QJsonObject& obj);
+
+    /**
+     * @brief 直接从原始响应流式解码，不构造整个QJsonDocument，超出默认预算的行溢出到磁盘
+     * @param data 原始响应，可以是被引号包裹并转义的形式
+     * @param header 输出除rows外的响应字段(status、msg、columns)
+     * @param ok 输出响应是否为合法的JSON对象
+     */
+    static ResultStore fromResponse(const QByteArray& data, QJsonObject* header = nullptr, bool* ok = nullptr);
+
+    /**
+     * @brief 以已映射的快照作为数据，不复制任何单元格
+     */
+    static ResultStore fromSnapshot(const QSharedPointer<const ResultSnapshot>& snapshot);
+
+private:
+    // 一列在内存中的数据
+    struct ColumnData {
+        bool encoded = true;
+        QVector<QString> values;        // 未编码时每行一个值
+        QVector<quint16> codes;         // 编码时每行一个字典编号
+        QVector<QString> dictionary;    // 编号 -> 值
+        QHash<QString, int> lookup;     // 值 -> 编号
+        qint64 bytes = 0;               // 估算占用
+        qint64 plainBytes = 0;          // 逐行存放时的估算占用
+
+        QString at(int row) const { return encoded ? dictionary[codes[row]] : values[row]; }
+    };
+
+    static const int dictionaryLimit = 4096;    // 不同值超过该数量时改为逐行存放
+    static const int dictionaryProbeRows = 1024;// 行数达到该值后检查不同值的比例
+
+    QStringList names;                  // 列名
+    QStringList types;                  // 列类型
+    QVector<ColumnData> columns;        // 按列存储的数据(内存中的前memoryRows行)
+    int rows;                           // 行数
+
+    // 内存预算与溢出
+    qint64 memoryBudget;
+    qint64 memoryBytes;                 // 内存中单元格的估算字节数
+    int memoryRows;                     // 内存中的行数，其后的行在spill中
+    QSharedPointer<ResultSpillFile> spill;
+    QSharedPointer<const ResultSnapshot> mapped;   // 快照映射，存在时memoryRows为0
+    QVector<int> removedSpillRows;      // 已删除的溢出/快照行(文件中的行号，升序)
+    QHash<qint64, QString> spillEdits;  // 溢出行的修改，键为文件行号*列数+列
+
+    int spillFileRow(int spilledRow) const;
+    QString spilledValue(int spilledRow, int column) const;
+    static qint64 cellBytes(const QString& text) { return 24 + text.size() * 2; }
+    static quint16 internValue(ColumnData& data, const QString& text);
+    static void appendCell(ColumnData& data, const QString& text);
+    static void setCell(ColumnData& data, int row, const QString& text);
+    static void removeCell(ColumnData& data, int row);
+    static void removeCells(ColumnData& data, const QVector<int>& rows, int count);
+    static void decodeColumn(ColumnData& data);
+};
+
+#endif // RESULTSTORE_H
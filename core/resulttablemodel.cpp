@@ -0,0 +1,292 @@
+#include "resulttablemodel.h"
+#include <algorithm>
+
+namespace {
+
+// 行数过多时视图的像素坐标会溢出，占位行补到这个总数为止
+const qint64 maxEstimatedRows = 50000000;
+
+// 一次删除的连续区段超过该数量时整体重置，不再逐段通知
+const int removeResetRanges = 16;
+
+} // namespace
+
+ResultTableModel::ResultTableModel(QObject *parent)
+    : QAbstractTableModel(parent), editable(false), placeholderRows(0), keyColumn(-1)
+{
+}
+
+void ResultTableModel::setStore(const ResultStore& store)
+{
+    beginResetModel();
+    resultStore = store;
+    placeholderRows = 0;
+    resetKeyIndex();
+    endResetModel();
+}
+
+void ResultTableModel::clear()
+{
+    setStore(ResultStore());
+}
+
+void ResultTableModel::setActionColumnTitle(const QString& title)
+{
+    beginResetModel();
+    actionTitle = title;
+    endResetModel();
+}
+
+void ResultTableModel::setEditable(bool editable)
+{
+    if (this->editable == editable) {
+        return;
+    }
+    this->editable = editable;
+    // 操作列的按钮随之出现或消失
+    const int column = actionColumn();
+    if (column >= 0 && rowCount() > 0) {
+        emit dataChanged(index(0, column), index(rowCount() - 1, column), {ActionRole});
+    }
+}
+
+int ResultTableModel::actionColumn() const
+{
+    return actionTitle.isEmpty() ? -1 : resultStore.columnCount();
+}
+
+void ResultTableModel::setEstimatedRowCount(qint64 rows)
+{
+    // 逐行插入或移除末尾的占位行，已显示的数据行保持滚动位置与选中状态
+    const int dataRows = resultStore.rowCount();
+    const int target = int(qBound<qint64>(0, qMin(rows, maxEstimatedRows) - dataRows, maxEstimatedRows));
+    if (target > placeholderRows) {
+        beginInsertRows(QModelIndex(), dataRows + placeholderRows, dataRows + target - 1);
+        placeholderRows = target;
+        endInsertRows();
+    } else if (target < placeholderRows) {
+        beginRemoveRows(QModelIndex(), dataRows + target, dataRows + placeholderRows - 1);
+        placeholderRows = target;
+        endRemoveRows();
+    }
+}
+
+void ResultTableModel::setValue(int row, int column, const QString& value)
+{
+    updateKeyIndex(row, column, resultStore.value(row, column), value);
+    resultStore.setValue(row, column, value);
+    QModelIndex changed = index(row, column);
+    emit dataChanged(changed, changed);
+}
+
+void ResultTableModel::removeStoreRow(int row)
+{
+    removeStoreRows(QVector<int>() << row);
+}
+
+void ResultTableModel::removeStoreRows(QVector<int> rows)
+{
+    if (rows.isEmpty()) {
+        return;
+    }
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    if (keyColumn >= 0) {
+        for (int row : rows) {
+            auto it = keyRows.find(resultStore.value(row, keyColumn));
+            if (it != keyRows.end() && it.value() == row) {
+                keyRows.erase(it);
+            }
+        }
+    }
+
+    // 按连续区段拆分，每段一次通知；区段过多时逐段通知的代价超过重置
+    QVector<QPair<int, int>> ranges;
+    for (int row : rows) {
+        if (!ranges.isEmpty() && ranges.last().second == row - 1) {
+            ranges.last().second = row;
+        } else {
+            ranges << qMakePair(row, row);
+        }
+    }
+    if (ranges.size() > removeResetRanges) {
+        beginResetModel();
+        resultStore.removeRows(rows);
+        endResetModel();
+    } else {
+        // 从后往前删除，前面的行号保持有效
+        for (int i = ranges.size() - 1; i >= 0; --i) {
+            QVector<int> range;
+            range.reserve(ranges[i].second - ranges[i].first + 1);
+            for (int row = ranges[i].first; row <= ranges[i].second; ++row) {
+                range << row;
+            }
+            beginRemoveRows(QModelIndex(), ranges[i].first, ranges[i].second);
+            resultStore.removeRows(range);
+            endRemoveRows();
+        }
+    }
+
+    // 其后的行号减去其前被删除的行数，只改内存中的索引，不重新读取数据
+    if (keyColumn >= 0) {
+        for (auto it = keyRows.begin(); it != keyRows.end(); ++it) {
+            it.value() -= int(std::lower_bound(rows.begin(), rows.end(), it.value()) - rows.begin());
+        }
+    }
+}
+
+void ResultTableModel::appendStoreRows(const QVector<QStringList>& rows)
+{
+    if (rows.isEmpty()) {
+        return;
+    }
+    const int first = resultStore.rowCount();
+    beginInsertRows(QModelIndex(), first, first + rows.size() - 1);
+    resultStore.reserve(first + rows.size());
+    for (const QStringList& values : rows) {
+        if (keyColumn >= 0 && !keyRows.contains(values.value(keyColumn))) {
+            keyRows.insert(values.value(keyColumn), resultStore.rowCount());
+        }
+        resultStore.appendRow(values);
+    }
+    endInsertRows();
+}
+
+int ResultTableModel::findRow(int column, const QString& value) const
+{
+    if (column < 0 || column >= resultStore.columnCount()) {
+        return -1;
+    }
+    if (column != keyColumn) {
+        // 从后往前插入，值重复时保留第一行
+        keyColumn = column;
+        keyRows.clear();
+        keyRows.reserve(resultStore.rowCount());
+        for (int row = resultStore.rowCount() - 1; row >= 0; --row) {
+            keyRows.insert(resultStore.value(row, column), row);
+        }
+    }
+    return keyRows.value(value, -1);
+}
+
+void ResultTableModel::resetKeyIndex()
+{
+    keyColumn = -1;
+    keyRows.clear();
+}
+
+void ResultTableModel::updateKeyIndex(int row, int column, const QString& oldValue, const QString& newValue)
+{
+    if (column != keyColumn || oldValue == newValue) {
+        return;
+    }
+    // 与其他行重复的值无法只靠增量维护，下次查找时重建
+    auto it = keyRows.find(oldValue);
+    if (it == keyRows.end() || it.value() != row || keyRows.contains(newValue)) {
+        resetKeyIndex();
+        return;
+    }
+    keyRows.erase(it);
+    keyRows.insert(newValue, row);
+}
+
+int ResultTableModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : resultStore.rowCount() + placeholderRows;
+}
+
+int ResultTableModel::columnCount(const QModelIndex& parent) const
+{
+    if (parent.isValid() || resultStore.columnCount() == 0) {
+        return 0;
+    }
+    return resultStore.columnCount() + (actionTitle.isEmpty() ? 0 : 1);
+}
+
+QVariant ResultTableModel::data(const QModelIndex& index, int role) const
+{
+    if (role == ActionRole) {
+        return editable && index.isValid() && index.column() == actionColumn() && !isPlaceholderRow(index.row());
+    }
+    if (!index.isValid() || index.column() >= resultStore.columnCount() || isPlaceholderRow(index.row())) {
+        return QVariant();
+    }
+    if (role == Qt::DisplayRole || role == Qt::EditRole) {
+        return resultStore.value(index.row(), index.column());
+    }
+    return QVariant();
+}
+
+QVariant ResultTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role == Qt::ToolTipRole && orientation == Qt::Horizontal && section < resultStore.columnCount()) {
+        return columnToolTip(section);
+    }
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    if (orientation == Qt::Vertical) {
+        return section + 1;
+    }
+    if (section < resultStore.columnCount()) {
+        return resultStore.columnNames().at(section);
+    }
+    return actionTitle;
+}
+
+QString ResultTableModel::columnToolTip(int column) const
+{
+    // 列类型与内存占用，字典编码列给出相对逐行存放节省的比例
+    QString tip = resultStore.columnNames().at(column);
+    const QString type = resultStore.columnType(column);
+    if (!type.isEmpty()) {
+        tip += " (" + type + ")";
+    }
+    const qint64 bytes = resultStore.columnMemoryUsage(column);
+    const qint64 plain = resultStore.columnPlainBytes(column);
+    tip += QString("\n内存：%1 KB").arg(bytes / 1024);
+    if (resultStore.isDictionaryEncoded(column)) {
+        tip += QString("\n字典编码：%1 个不同值").arg(resultStore.dictionary(column).size());
+        if (plain > 0) {
+            tip += QString("，逐行存放约 %1 KB，节省 %2%")
+                    .arg(plain / 1024)
+                    .arg(qMax<qint64>(0, (plain - bytes) * 100 / plain));
+        }
+    }
+    if (!resultStore.allRowsInMemory()) {
+        tip += QString("\n另有 %1 行在磁盘上").arg(resultStore.spilledRowCount());
+    }
+    return tip;
+}
+
+Qt::ItemFlags ResultTableModel::flags(const QModelIndex& index) const
+{
+    if (!index.isValid() || isPlaceholderRow(index.row())) {
+        return Qt::NoItemFlags;
+    }
+    Qt::ItemFlags itemFlags = Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+    if (editable && index.column() < resultStore.columnCount()) {
+        itemFlags |= Qt::ItemIsEditable;
+    }
+    return itemFlags;
+}
+
+bool ResultTableModel::setData(const QModelIndex& index, const QVariant& value, int role)
+{
+    if (!index.isValid() || role != Qt::EditRole || index.column() >= resultStore.columnCount()
+            || isPlaceholderRow(index.row())) {
+        return false;
+    }
+
+    const QString oldValue = resultStore.value(index.row(), index.column());
+    const QString newValue = value.toString();
+    if (oldValue == newValue) {
+        return false;
+    }
+
+    updateKeyIndex(index.row(), index.column(), oldValue, newValue);
+    resultStore.setValue(index.row(), index.column(), newValue);
+    emit dataChanged(index, index);
+    emit cellEdited(index.row(), index.column(), oldValue, newValue);
+    return true;
+}
@@ -0,0 +1,99 @@
+#ifndef RESULTTABLEMODEL_H
+#define RESULTTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include "resultstore.h"
+
+/**
+ * @brief 直接基于ResultStore的表格模型
+ * 不为每个单元格创建QStandardItem，可选在末尾附加一列操作列
+ */
+class ResultTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Roles {
+        ActionRole = Qt::UserRole + 1      // 操作列的单元格返回true，由视图的委托绘制按钮
+    };
+
+    explicit ResultTableModel(QObject *parent = nullptr);
+
+    /**
+     * @brief 替换全部数据，触发模型重置
+     */
+    void setStore(const ResultStore& store);
+    const ResultStore& store() const { return resultStore; }
+    void clear();
+
+    /**
+     * @brief 设置是否允许编辑单元格，编辑后发出cellEdited；不可编辑时操作列不显示按钮
+     */
+    void setEditable(bool editable);
+
+    /**
+     * @brief 在数据列之后附加一列操作列，title为空表示不附加
+     */
+    void setActionColumnTitle(const QString& title);
+    int actionColumn() const;
+
+    /**
+     * @brief 按估算的总行数在数据之后补足空白的占位行，使滚动条按整表大小显示
+     * 占位行不可选中、不可编辑，setStore时清除
+     */
+    void setEstimatedRowCount(qint64 rows);
+    bool isPlaceholderRow(int row) const { return row >= resultStore.rowCount(); }
+
+    QString value(int row, int column) const
+    {
+        return isPlaceholderRow(row) ? QString() : resultStore.value(row, column);
+    }
+    void setValue(int row, int column, const QString& value);
+    void removeStoreRow(int row);
+    void appendStoreRows(const QVector<QStringList>& rows);
+
+    /**
+     * @brief 删除多行，行号任意顺序；键索引只整体修正一次
+     */
+    void removeStoreRows(QVector<int> rows);
+
+    /**
+     * @brief 按某列的值找到行号，值重复时返回第一行，找不到返回-1
+     * 首次查找时为该列建立值到行号的索引，之后随插入、删除与修改增量维护，替换数据时作废，
+     * 反复按主键定位行时不必每次扫描整个结果集(溢出到磁盘时即读取整个文件)
+     */
+    int findRow(int column, const QString& value) const;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+
+signals:
+    /**
+     * @brief 用户编辑了单元格
+     * @param row 行号
+     * @param column 列号
+     * @param oldValue 编辑前的值
+     * @param newValue 编辑后的值
+     */
+    void cellEdited(int row, int column, const QString& oldValue, const QString& newValue);
+
+private:
+    ResultStore resultStore;
+    QString actionTitle;
+    bool editable;
+    int placeholderRows;
+    mutable int keyColumn;                  // 已建立索引的列，-1表示没有
+    mutable QHash<QString, int> keyRows;    // 值 -> 第一次出现的行号
+
+    void resetKeyIndex();
+    void updateKeyIndex(int row, int column, const QString& oldValue, const QString& newValue);
+
+    QString columnToolTip(int column) const;
+};
+
+#endif // RESULTTABLEMODEL_H
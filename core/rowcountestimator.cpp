@@ -0,0 +1,300 @@
+#include "rowcountestimator.h"
+#include "indexadvisor.h"
+#include "tabledata.h"
+#include <QtConcurrent>
+#include <QFutureWatcher>
+#include <QPointer>
+#include <QThread>
+#include <QJsonArray>
+
+namespace {
+
+// 计数连接的握手超时
+const int connectTimeoutMs = 5000;
+
+} // namespace
+
+RowCountEstimator::RowCountEstimator(SqlProcessHandler* handler, QObject *parent)
+    : QObject(parent), sqlHandler(handler), countSockets(nullptr), countHandler(nullptr),
+      connecting(false), serverCancelEnabled(false), countDelayMs(1000),
+      rowidRows(-1), statRows(-1), databaseBytes(-1), sampleCount(-1), sampleBytes(0), countId(0)
+{
+    // 连续切换表时只为停下来的那张表计数
+    countTimer = new QTimer(this);
+    countTimer->setSingleShot(true);
+    connect(countTimer, &QTimer::timeout, this, &RowCountEstimator::startExactCount);
+    connect(sqlHandler, &SqlProcessHandler::responseReceived,
+            this, &RowCountEstimator::onResponseReceived);
+}
+
+RowCountEstimator::~RowCountEstimator()
+{
+    cancelEstimate();
+    cancelCount();
+    if (countSockets) {
+        countHandler->setSocket(nullptr);
+        countSockets->closeSocket();
+    }
+}
+
+void RowCountEstimator::estimate(const QString& table)
+{
+    cancelEstimate();
+    countTimer->stop();
+    if (countId != 0 && countTable != table) {
+        cancelCount();
+    }
+    this->table = table;
+    rowidRows = -1;
+    statRows = -1;
+    databaseBytes = -1;
+    sampleCount = -1;
+    sampleBytes = 0;
+
+    if (exactCounts.contains(table)) {
+        RowCountEstimate result;
+        result.table = table;
+        result.rows = exactCounts.value(table);
+        result.exact = true;
+        result.source = "COUNT(*)";
+        emit estimated(result);
+        return;
+    }
+
+    // 两条查询都只读B树的两端或统计表中的一行，与表的大小无关
+    const QString quoted = IndexAdvisor::quoteIdentifier(table);
+    send(Step::RowidRange, QString("SELECT (SELECT min(rowid) FROM %1) AS lo, (SELECT max(rowid) FROM %1) AS hi;")
+                               .arg(quoted));
+    send(Step::Stat1, QString("SELECT stat FROM sqlite_stat1 WHERE tbl = %1;").arg(TableData::sqlLiteral(table)));
+}
+
+void RowCountEstimator::setExactCount(const QString& table, qint64 rows)
+{
+    exactCounts[table] = rows;
+    if (countTable == table) {
+        cancelCount();
+    }
+    if (this->table == table) {
+        countTimer->stop();
+    }
+}
+
+void RowCountEstimator::invalidate(const QString& table)
+{
+    // 进行中的计数可能已经读过变化之前的数据
+    exactCounts.remove(table);
+    if (countTable == table) {
+        cancelCount();
+    }
+}
+
+void RowCountEstimator::send(Step step, const QString& sql)
+{
+    pending[sqlHandler->execSql(sql)] = step;
+}
+
+void RowCountEstimator::cancelEstimate()
+{
+    for (auto it = pending.constBegin(); it != pending.constEnd(); ++it) {
+        sqlHandler->cancelRequest(it.key());
+    }
+    pending.clear();
+}
+
+void RowCountEstimator::cancelCount()
+{
+    if (countId != 0) {
+        countHandler->cancelRequest(countId);
+        countId = 0;
+    }
+    countTable.clear();
+}
+
+void RowCountEstimator::onResponseReceived(quint64 requestId, const QByteArray& data)
+{
+    if (!pending.contains(requestId)) {
+        return;
+    }
+    const Step step = pending.take(requestId);
+
+    bool ok = false;
+    QJsonObject jsonObj = TableData::parseResponse(data, &ok);
+    const bool success = ok && jsonObj["status"].toInt() == 0;
+    const QJsonArray rows = jsonObj["rows"].toArray();
+    const QJsonObject first = rows.isEmpty() ? QJsonObject() : rows.first().toObject();
+
+    // 出错说明没有rowid(WITHOUT ROWID表或视图)或没有统计表，都不是错误
+    switch (step) {
+    case Step::RowidRange:
+        if (success) {
+            QString low = TableData::cellText(first["lo"]);
+            QString high = TableData::cellText(first["hi"]);
+            rowidRows = low.isEmpty() || high.isEmpty() ? 0 : high.toLongLong() - low.toLongLong() + 1;
+        }
+        break;
+
+    case Step::Stat1:
+        // 每个索引一行，stat的第一个数是ANALYZE时的行数
+        for (const auto& value : rows) {
+            QString stat = TableData::cellText(value.toObject()["stat"]);
+            statRows = qMax(statRows, stat.section(' ', 0, 0, QString::SectionSkipEmpty).toLongLong());
+        }
+        break;
+
+    case Step::Pages:
+        if (success) {
+            databaseBytes = TableData::cellText(first["pages"]).toLongLong()
+                    * TableData::cellText(first["size"]).toLongLong();
+        }
+        break;
+
+    case Step::Sample:
+        if (success) {
+            sampleCount = rows.size();
+            sampleBytes = data.size();
+        }
+        break;
+    }
+
+    if (!pending.isEmpty()) {
+        return;
+    }
+    // 既没有rowid也没有统计时，才读取页数与少量样本行
+    if ((step == Step::RowidRange || step == Step::Stat1) && rowidRows < 0 && statRows < 0) {
+        send(Step::Pages, "SELECT (SELECT page_count FROM pragma_page_count()) - "
+                          "(SELECT freelist_count FROM pragma_freelist_count()) AS pages, "
+                          "(SELECT page_size FROM pragma_page_size()) AS size;");
+        send(Step::Sample, QString("SELECT * FROM %1 LIMIT %2;")
+                               .arg(IndexAdvisor::quoteIdentifier(table)).arg(sampleRows));
+        return;
+    }
+    finishEstimate();
+}
+
+void RowCountEstimator::finishEstimate()
+{
+    RowCountEstimate result;
+    result.table = table;
+
+    if (rowidRows == 0) {
+        result.rows = 0;
+        result.exact = true;
+        result.source = "空表";
+    } else if (rowidRows > 0) {
+        // 统计可能已过时：行数超过rowid范围时说明ANALYZE之后有过删除和重用，以范围为准
+        if (statRows >= 0 && statRows <= rowidRows) {
+            result.rows = statRows;
+            result.source = "sqlite_stat1";
+        } else {
+            result.rows = rowidRows;
+            result.source = "rowid范围";
+        }
+    } else if (statRows >= 0) {
+        result.rows = statRows;
+        result.source = "sqlite_stat1";
+    } else if (sampleCount >= 0 && sampleCount < sampleRows) {
+        result.rows = sampleCount;
+        result.exact = true;
+        result.source = "全部读取";
+    } else if (sampleCount > 0 && databaseBytes > 0) {
+        // 假设整个数据库都是这张表，样本按响应大小计算平均行长，只是上限
+        const qint64 rowBytes = qMax<qint64>(1, sampleBytes / sampleCount);
+        result.rows = qMax<qint64>(sampleCount, databaseBytes / rowBytes);
+        result.source = "按页数估算的上限";
+    }
+
+    if (result.exact) {
+        exactCounts[table] = result.rows;
+    } else if (countDelayMs > 0) {
+        countTimer->start(countDelayMs);
+    }
+    emit estimated(result);
+}
+
+void RowCountEstimator::startExactCount()
+{
+    if (table.isEmpty() || exactCounts.contains(table) || (countId != 0 && countTable == table)) {
+        return;
+    }
+    cancelCount();
+    if (!countHandler) {
+        openCountConnection();
+        return;
+    }
+
+    // COUNT(*)要扫描整表，放在单独的连接上，不阻塞会话连接上的其他请求
+    countTable = table;
+    countId = countHandler->execSql(QString("SELECT count(*) AS n FROM %1;")
+                                    .arg(IndexAdvisor::quoteIdentifier(table)));
+}
+
+void RowCountEstimator::openCountConnection()
+{
+    const ConnectionProfile profile = sqlHandler->connectionProfile();
+    if (connecting || !profile.isValid()) {
+        return;
+    }
+    connecting = true;
+
+    // 握手是阻塞的，放到线程池中进行，完成后把socket移回本线程
+    QThread* home = thread();
+    QPointer<RowCountEstimator> self(this);
+    auto* watcher = new QFutureWatcher<QTcpSocket*>();
+    connect(watcher, &QFutureWatcher<QTcpSocket*>::finished, watcher, [self, watcher]() {
+        QTcpSocket* socket = watcher->result();
+        if (self) {
+            self->setCountSocket(socket);
+        } else {
+            delete socket;
+        }
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run([profile, home]() -> QTcpSocket* {
+        QTcpSocket* socket = SocketManager::openConnection(profile.ip, profile.port, profile.dbPath, connectTimeoutMs);
+        if (socket) {
+            socket->moveToThread(home);
+        }
+        return socket;
+    }));
+}
+
+void RowCountEstimator::setCountSocket(QTcpSocket* socket)
+{
+    connecting = false;
+    if (!socket) {
+        return;     // 连接失败时只保留估算，下次估算后再尝试
+    }
+    countSockets = new SocketManager(this);
+    countSockets->setSocket(socket);
+    countHandler = new SqlProcessHandler(countSockets, this);
+    countHandler->setSocket(socket);
+    countHandler->setServerCancelEnabled(serverCancelEnabled);
+    connect(countHandler, &SqlProcessHandler::responseReceived,
+            this, &RowCountEstimator::onCountResponseReceived);
+    startExactCount();
+}
+
+void RowCountEstimator::onCountResponseReceived(quint64 requestId, const QByteArray& data)
+{
+    if (requestId != countId) {
+        return;
+    }
+    const QString counted = countTable;
+    countId = 0;
+    countTable.clear();
+
+    bool ok = false;
+    QJsonObject jsonObj = TableData::parseResponse(data, &ok);
+    QJsonArray rows = jsonObj["rows"].toArray();
+    if (!ok || jsonObj["status"].toInt() != 0 || rows.isEmpty()) {
+        return;
+    }
+
+    RowCountEstimate result;
+    result.table = counted;
+    result.rows = TableData::cellText(rows.first().toObject()["n"]).toLongLong();
+    result.exact = true;
+    result.source = "COUNT(*)";
+    exactCounts[counted] = result.rows;
+    emit estimated(result);
+}
@@ -0,0 +1,99 @@
+#ifndef ROWCOUNTESTIMATOR_H
+#define ROWCOUNTESTIMATOR_H
+
+#include <QObject>
+#include <QMap>
+#include <QTimer>
+#include "socketmanager.h"
+#include "sqlprocesshandler.h"
+
+// 一张表的行数
+struct RowCountEstimate {
+    QString table;
+    qint64 rows = -1;       // -1表示无法估算
+    bool exact = false;     // 来自COUNT(*)或完整读取，否则为估算
+    QString source;         // 来源说明
+};
+
+/**
+ * @brief 不做COUNT(*)的行数估算
+ * 先用几条只读B树两端或统计表的查询给出估算：rowid范围(max-min+1，删除留下空洞时偏大)，
+ * 存在sqlite_stat1且不超过rowid范围时取其行数；没有rowid也没有统计时按数据库页数与样本行的
+ * 平均大小估算上限。随后在单独的连接上低优先级地执行COUNT(*)，完成后以精确值再次发出。
+ * 精确值按表缓存，表有变更时由调用方作废。
+ */
+class RowCountEstimator : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RowCountEstimator(SqlProcessHandler* handler, QObject *parent = nullptr);
+    ~RowCountEstimator();
+
+    /**
+     * @brief 估算后延迟多久开始精确计数，0表示不做精确计数
+     */
+    void setExactCountDelay(int ms) { countDelayMs = ms; }
+    void setServerCancelEnabled(bool enabled) { serverCancelEnabled = enabled; }
+
+    /**
+     * @brief 估算一张表的行数，替换进行中的估算；已有精确值时直接发出
+     */
+    void estimate(const QString& table);
+
+    /**
+     * @brief 调用方已经得到了准确的行数(例如读完了整表)，记下并放弃该表的精确计数
+     */
+    void setExactCount(const QString& table, qint64 rows);
+
+    /**
+     * @brief 表的数据已变化，丢弃其精确值
+     */
+    void invalidate(const QString& table);
+
+signals:
+    /**
+     * @brief 得到估算或精确行数，同一张表可能先后发出两次
+     */
+    void estimated(const RowCountEstimate& estimate);
+
+private slots:
+    void onResponseReceived(quint64 requestId, const QByteArray& data);
+    void onCountResponseReceived(quint64 requestId, const QByteArray& data);
+    void startExactCount();
+
+private:
+    enum class Step { RowidRange, Stat1, Pages, Sample };
+
+    static const int sampleRows = 100;
+
+    SqlProcessHandler* sqlHandler;
+    SocketManager* countSockets;        // 精确计数专用的连接，按需建立
+    SqlProcessHandler* countHandler;
+    bool connecting;
+    bool serverCancelEnabled;
+    int countDelayMs;
+    QTimer* countTimer;
+    QMap<QString, qint64> exactCounts;  // 表 -> 精确行数
+
+    // 当前估算的中间结果
+    QString table;
+    QMap<quint64, Step> pending;
+    qint64 rowidRows;                   // -1表示没有rowid
+    qint64 statRows;                    // -1表示没有统计
+    qint64 databaseBytes;               // 已用页的总字节数，-1表示未知
+    int sampleCount;
+    qint64 sampleBytes;
+
+    quint64 countId;                    // 在途的COUNT(*)，0表示没有
+    QString countTable;
+
+    void send(Step step, const QString& sql);
+    void cancelEstimate();
+    void cancelCount();
+    void finishEstimate();
+    void openCountConnection();
+    void setCountSocket(QTcpSocket* socket);
+};
+
+#endif // ROWCOUNTESTIMATOR_H
@@ -0,0 +1,149 @@
+#include "schemacache.h"
+#include "tabledata.h"
+
+int TableSchema::columnIndex(const QString& column) const
+{
+    for (int i = 0; i < columns.size(); ++i) {
+        if (columns[i].name.compare(column, Qt::CaseInsensitive) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool TableSchema::isTextColumn(int column) const
+{
+    // SQLite类型亲和性：含CHAR/CLOB/TEXT为文本，未声明类型的列也可能存文本
+    const QString type = columns.value(column).type.toUpper();
+    return type.isEmpty() || type.contains("CHAR") || type.contains("CLOB") || type.contains("TEXT");
+}
+
+SchemaCache::SchemaCache(SqlProcessHandler* handler, QObject *parent)
+    : QObject(parent), sqlHandler(handler), loaded(false), failed(false)
+{
+    connect(sqlHandler, &SqlProcessHandler::responseReceived,
+            this, &SchemaCache::onResponseReceived);
+}
+
+void SchemaCache::refresh()
+{
+    pendingRequests.clear();
+    loadingTables.clear();
+    failed = false;
+
+    // 表值函数形式的PRAGMA需要SQLite 3.16及以上
+    pendingRequests[sqlHandler->execSql(
+        "SELECT m.name AS tbl, p.cid AS cid, p.name AS col, p.type AS type, "
+        "p.\"notnull\" AS notnull, p.dflt_value AS dflt, p.pk AS pk "
+        "FROM sqlite_master m JOIN pragma_table_info(m.name) p "
+        "WHERE m.type IN ('table', 'view') ORDER BY m.name, p.cid;")] = Part::Columns;
+    pendingRequests[sqlHandler->execSql(
+        "SELECT m.name AS tbl, il.name AS idx, il.\"unique\" AS uniq, ii.seqno AS seqno, ii.name AS col "
+        "FROM sqlite_master m JOIN pragma_index_list(m.name) il JOIN pragma_index_info(il.name) ii "
+        "WHERE m.type = 'table' ORDER BY m.name, il.name, ii.seqno;")] = Part::Indexes;
+    pendingRequests[sqlHandler->execSql(
+        "SELECT type, name, tbl_name, sql FROM sqlite_master;")] = Part::Objects;
+}
+
+bool SchemaCache::hasTable(const QString& name) const
+{
+    return tables.contains(name.toLower());
+}
+
+TableSchema SchemaCache::table(const QString& name) const
+{
+    return tables.value(name.toLower());
+}
+
+void SchemaCache::onResponseReceived(quint64 requestId, const QByteArray& data)
+{
+    if (!pendingRequests.contains(requestId)) {
+        return;
+    }
+    Part part = pendingRequests.take(requestId);
+
+    bool ok = false;
+    QJsonObject obj = TableData::parseResponse(data, &ok);
+    if (!ok || obj["status"].toInt() != 0) {
+        if (!failed) {
+            failed = true;
+            emit schemaLoadFailed(ok ? obj["msg"].toString() : "返回数据格式错误");
+        }
+        return;
+    }
+
+    QJsonArray rows = obj["rows"].toArray();
+    switch (part) {
+        case Part::Columns:
+            applyColumns(rows);
+            break;
+        case Part::Indexes:
+            applyIndexes(rows);
+            break;
+        case Part::Objects:
+            applyObjects(rows);
+            break;
+    }
+
+    // 三部分都到齐后整体替换，避免使用者看到一半的结构
+    if (pendingRequests.isEmpty() && !failed) {
+        tables = loadingTables;
+        loadingTables.clear();
+        loaded = true;
+        emit schemaLoaded();
+    }
+}
+
+void SchemaCache::applyColumns(const QJsonArray& rows)
+{
+    for (const auto& row : rows) {
+        QJsonObject rowObj = row.toObject();
+        TableSchema& schema = loadingTables[rowObj["tbl"].toString().toLower()];
+        schema.name = rowObj["tbl"].toString();
+
+        ColumnInfo column;
+        column.name = rowObj["col"].toString();
+        column.type = rowObj["type"].toString();
+        column.notNull = TableData::cellText(rowObj["notnull"]) == "1";
+        column.defaultValue = rowObj["dflt"].toString();
+        column.pk = TableData::cellText(rowObj["pk"]).toInt();
+        schema.columns << column;
+    }
+}
+
+void SchemaCache::applyIndexes(const QJsonArray& rows)
+{
+    for (const auto& row : rows) {
+        QJsonObject rowObj = row.toObject();
+        TableSchema& schema = loadingTables[rowObj["tbl"].toString().toLower()];
+        schema.name = rowObj["tbl"].toString();
+
+        const QString indexName = rowObj["idx"].toString();
+        if (schema.indexes.isEmpty() || schema.indexes.last().name != indexName) {
+            IndexInfo index;
+            index.name = indexName;
+            index.unique = TableData::cellText(rowObj["uniq"]) == "1";
+            schema.indexes << index;
+        }
+        schema.indexes.last().columns << rowObj["col"].toString();
+    }
+}
+
+void SchemaCache::applyObjects(const QJsonArray& rows)
+{
+    for (const auto& row : rows) {
+        QJsonObject rowObj = row.toObject();
+        const QString type = rowObj["type"].toString();
+        const QString tableName = rowObj["tbl_name"].toString();
+
+        if (type == "trigger") {
+            loadingTables[tableName.toLower()].triggers << rowObj["name"].toString();
+        } else if (type == "table" || type == "view") {
+            TableSchema& schema = loadingTables[tableName.toLower()];
+            schema.name = tableName;
+            schema.sql = rowObj["sql"].toString();
+            schema.isView = type == "view";
+            schema.isVirtual = schema.sql.contains("VIRTUAL TABLE", Qt::CaseInsensitive);
+        }
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef SCHEMACACHE_H
+#define SCHEMACACHE_H
+
+#include <QObject>
+#include <QMap>
+#include <QSet>
+#include <QVector>
+#include <QStringList>
+#include "sqlprocesshandler.h"
+
+// 列信息，对应PRAGMA table_info
+struct ColumnInfo {
+    QString name;
+    QString type;
+    bool notNull = false;
+    QString defaultValue;
+    int pk = 0;             // 在主键中的序号，0表示不属于主键
+};
+
+// 索引信息，对应PRAGMA index_list/index_info
+struct IndexInfo {
+    QString name;
+    QStringList columns;
+    bool unique = false;
+};
+
+// 表结构
+struct TableSchema {
+    QString name;
+    QString sql;                    // 建表语句
+    bool isView = false;
+    bool isVirtual = false;         // 虚拟表(如FTS)
+    QVector<ColumnInfo> columns;
+    QVector<IndexInfo> indexes;
+    QStringList triggers;
+
+    int columnIndex(const QString& column) const;
+    bool isTextColumn(int column) const;
+};
+
+/**
+ * @brief 远程数据库结构缓存
+ * 用少量查询一次取回全部表、列、索引和触发器，供索引建议、编辑回填等功能查询，
+ * 结构变化后调用refresh重新加载。
+ */
+class SchemaCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SchemaCache(SqlProcessHandler* handler, QObject *parent = nullptr);
+
+    /**
+     * @brief 重新从服务端加载结构
+     */
+    void refresh();
+    bool isLoaded() const { return loaded; }
+    bool isLoading() const { return !pendingRequests.isEmpty(); }
+
+    QStringList tableNames() const { return tables.keys(); }
+    bool hasTable(const QString& name) const;
+    TableSchema table(const QString& name) const;
+
+signals:
+    void schemaLoaded();
+    void schemaLoadFailed(const QString& msg);
+
+private slots:
+    void onResponseReceived(quint64 requestId, const QByteArray& data);
+
+private:
+    enum class Part { Columns, Indexes, Objects };
+
+    SqlProcessHandler* sqlHandler;
+    QMap<quint64, Part> pendingRequests;
+    QMap<QString, TableSchema> tables;      // 键为小写表名
+    QMap<QString, TableSchema> loadingTables;
+    bool loaded;
+    bool failed;
+
+    void applyColumns(const QJsonArray& rows);
+    void applyIndexes(const QJsonArray& rows);
+    void applyObjects(const QJsonArray& rows);
+};
+
+#endif // SCHEMACACHE_H
@@ -0,0 +1,241 @@
+#include "scriptfilerunner.h"
+#include <QTextCodec>
+#include <QTimer>
+#include <QRegularExpression>
+#include "tabledata.h"
+
+ScriptFileRunner::ScriptFileRunner(SqlProcessHandler* handler, QObject *parent)
+    : QObject(parent), sqlHandler(handler), fileSize(0), decoder(nullptr), statementsBytes(0),
+      batchStatements(500), batchBytes(1024 * 1024), running(false), stopRequested(false),
+      readFinished(false), readScheduled(false), scriptTransaction(false), schemaChanged(false),
+      statementsRead(0), statementsBatched(0), statementsDone(0), currentRequestId(0)
+{
+    connect(sqlHandler, &SqlProcessHandler::responseReceived, this, &ScriptFileRunner::onResponseReceived);
+}
+
+ScriptFileRunner::~ScriptFileRunner()
+{
+    delete decoder;
+}
+
+void ScriptFileRunner::setBatchLimits(int statements, int bytes)
+{
+    batchStatements = qMax(1, statements);
+    batchBytes = qMax(1, bytes);
+}
+
+bool ScriptFileRunner::start(const QString& path, QString* error)
+{
+    if (running) {
+        return false;
+    }
+    file.setFileName(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (error) {
+            *error = file.errorString();
+        }
+        return false;
+    }
+    fileSize = file.size();
+
+    // 有状态的解码器，块边界切开的多字节字符在下一块补全；UTF-8的BOM会被跳过
+    delete decoder;
+    decoder = QTextCodec::codecForName("UTF-8")->makeDecoder();
+    splitter = SqlSplitter();
+    statements.clear();
+    statementsBytes = 0;
+    running = true;
+    stopRequested = false;
+    readFinished = false;
+    scriptTransaction = false;
+    schemaChanged = false;
+    statementsRead = 0;
+    statementsBatched = 0;
+    statementsDone = 0;
+    nextBatch = Batch();
+    currentBatch = Batch();
+    currentRequestId = 0;
+    timer.start();
+    scheduleRead();
+    return true;
+}
+
+void ScriptFileRunner::stop()
+{
+    if (!running) {
+        return;
+    }
+    stopRequested = true;
+    // 没有正在执行的批次时立即结束，否则等它完成
+    if (currentRequestId == 0) {
+        finish(false, QString("已停止，成功执行 %1 条语句").arg(statementsDone));
+    }
+}
+
+void ScriptFileRunner::scheduleRead()
+{
+    if (!readScheduled && !readFinished) {
+        readScheduled = true;
+        // 每次只读一块，回到事件循环后再继续，界面保持响应
+        QTimer::singleShot(0, this, &ScriptFileRunner::readMore);
+    }
+}
+
+void ScriptFileRunner::readMore()
+{
+    readScheduled = false;
+    if (!running || stopRequested || readFinished) {
+        return;
+    }
+
+    const QByteArray chunk = file.read(readChunkBytes);
+    if (chunk.isEmpty()) {
+        readFinished = true;
+        splitter.feed(decoder->toUnicode(QByteArray()));
+        splitter.finish();
+    } else {
+        splitter.feed(decoder->toUnicode(chunk));
+    }
+
+    for (const SqlStatement& statement : splitter.takeStatements()) {
+        QString text = statement.text;
+        if (!text.endsWith(';')) {
+            text += ';';
+        }
+        statements.enqueue(text);
+        statementsBytes += text.size();
+        ++statementsRead;
+    }
+    emit progress(file.pos(), statementsDone, statementsRead);
+
+    if (!takeBatch() && readFinished && currentRequestId == 0 && nextBatch.count == 0) {
+        finish(true, QString("执行完成，共 %1 条语句，用时 %2 秒")
+               .arg(statementsDone).arg(timer.elapsed() / 1000.0, 0, 'f', 1));
+        return;
+    }
+    sendNext();
+
+    // 已有预备批次时等当前批次完成再读，缓冲的语句不超过两批
+    if (nextBatch.count == 0 || statementsBytes < batchBytes) {
+        scheduleRead();
+    }
+}
+
+void ScriptFileRunner::noteStatement(const QString& statement, bool* control)
+{
+    static const QRegularExpression firstWords("^\\s*(\\w+)(?:\\s+(?:TRANSACTION\\s+)?(\\w+))?",
+                                               QRegularExpression::CaseInsensitiveOption);
+    const QRegularExpressionMatch match = firstWords.match(statement);
+    const QString word = match.captured(1).toUpper();
+    if (word == "BEGIN") {
+        scriptTransaction = true;
+        *control = true;
+    } else if (word == "COMMIT" || word == "END") {
+        scriptTransaction = false;
+        *control = true;
+    } else if (word == "ROLLBACK") {
+        // ROLLBACK TO只回到保存点，事务仍然打开
+        if (match.captured(2).toUpper() != "TO") {
+            scriptTransaction = false;
+        }
+        *control = true;
+    } else if (word == "SAVEPOINT" || word == "RELEASE") {
+        *control = true;
+    } else if (word == "CREATE" || word == "DROP" || word == "ALTER") {
+        schemaChanged = true;
+    }
+}
+
+bool ScriptFileRunner::takeBatch()
+{
+    if (nextBatch.count > 0 || statements.isEmpty()) {
+        return nextBatch.count > 0;
+    }
+    // 批次未满且文件还没读完时继续攒
+    if (!readFinished && statements.size() < batchStatements && statementsBytes < batchBytes) {
+        return false;
+    }
+
+    Batch batch;
+    batch.firstStatement = statementsBatched + 1;
+    const bool transactionOpen = scriptTransaction;
+    bool control = false;
+    QStringList parts;
+    int bytes = 0;
+    while (!statements.isEmpty() && batch.count < batchStatements && (batch.count == 0 || bytes < batchBytes)) {
+        const QString statement = statements.dequeue();
+        statementsBytes -= statement.size();
+        bytes += statement.size();
+        noteStatement(statement, &control);
+        parts << statement;
+        ++batch.count;
+    }
+    // 脚本自己控制事务时原样发送
+    batch.wrapped = !transactionOpen && !control;
+    batch.sql = batch.wrapped ? "BEGIN;\n" + parts.join('\n') + "\nCOMMIT;" : parts.join('\n');
+    statementsBatched += batch.count;
+    nextBatch = batch;
+    return true;
+}
+
+void ScriptFileRunner::sendNext()
+{
+    if (currentRequestId != 0 || nextBatch.count == 0 || stopRequested) {
+        return;
+    }
+    currentBatch = nextBatch;
+    nextBatch = Batch();
+    currentRequestId = sqlHandler->execSql(currentBatch.sql);
+    takeBatch();
+}
+
+void ScriptFileRunner::onResponseReceived(quint64 requestId, const QByteArray& data)
+{
+    if (!running || requestId != currentRequestId) {
+        return;
+    }
+    currentRequestId = 0;
+
+    bool ok = false;
+    QJsonObject obj = TableData::parseResponse(data, &ok);
+    if (!ok || obj["status"].toInt() != 0) {
+        const QString msg = ok ? obj["msg"].toString() : "返回数据格式错误";
+        // 出错的语句之前的部分已在事务中执行，回滚后不留下半批数据
+        if (currentBatch.wrapped) {
+            sqlHandler->execSql("ROLLBACK;");
+        }
+        finish(false, QString("第 %1 - %2 条语句所在批次执行失败%3：%4\n成功执行 %5 条语句")
+               .arg(currentBatch.firstStatement)
+               .arg(currentBatch.firstStatement + currentBatch.count - 1)
+               .arg(currentBatch.wrapped ? "，该批次已回滚" : "")
+               .arg(msg)
+               .arg(statementsDone));
+        return;
+    }
+
+    statementsDone += currentBatch.count;
+    emit progress(file.pos(), statementsDone, statementsRead);
+    if (stopRequested) {
+        finish(false, QString("已停止，成功执行 %1 条语句").arg(statementsDone));
+        return;
+    }
+
+    takeBatch();
+    if (nextBatch.count == 0 && readFinished && statements.isEmpty()) {
+        finish(true, QString("执行完成，共 %1 条语句，用时 %2 秒")
+               .arg(statementsDone).arg(timer.elapsed() / 1000.0, 0, 'f', 1));
+        return;
+    }
+    sendNext();
+    scheduleRead();
+}
+
+void ScriptFileRunner::finish(bool ok, const QString& message)
+{
+    running = false;
+    file.close();
+    statements.clear();
+    statementsBytes = 0;
+    nextBatch = Batch();
+    emit finished(ok, message);
+}
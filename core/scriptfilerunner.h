@@ -0,0 +1,108 @@
+#ifndef SCRIPTFILERUNNER_H
+#define SCRIPTFILERUNNER_H
+
+#include <QObject>
+#include <QFile>
+#include <QTextDecoder>
+#include <QQueue>
+#include <QElapsedTimer>
+#include "sqlsplitter.h"
+#include "sqlprocesshandler.h"
+
+/**
+ * @brief 流式执行SQL脚本文件
+ * 文件按块读取、增量拆分语句，不整体载入内存；语句按批次(条数或字节数上限)合成一次请求，
+ * 脚本自身没有控制事务时每批包在BEGIN/COMMIT中。当前批次在服务端执行时预先读取并拆好下一批，
+ * 只有上一批成功后才发送下一批，出错时回滚当前批次并停止，不会执行出错位置之后的语句。
+ */
+class ScriptFileRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ScriptFileRunner(SqlProcessHandler* handler, QObject *parent = nullptr);
+    ~ScriptFileRunner();
+
+    /**
+     * @brief 每批的最大语句数与最大字节数
+     */
+    void setBatchLimits(int statements, int bytes);
+
+    /**
+     * @brief 打开文件并开始执行，失败时返回false并输出原因
+     */
+    bool start(const QString& path, QString* error = nullptr);
+
+    /**
+     * @brief 请求停止，正在执行的批次完成后结束
+     */
+    void stop();
+
+    bool isRunning() const { return running; }
+    qint64 totalBytes() const { return fileSize; }
+    bool changesSchema() const { return schemaChanged; }
+
+signals:
+    /**
+     * @brief 执行进度
+     * @param bytesRead 已读取并拆分的字节数
+     * @param statementsDone 已成功执行的语句数
+     * @param statementsRead 已拆分出的语句数
+     */
+    void progress(qint64 bytesRead, int statementsDone, int statementsRead);
+
+    /**
+     * @brief 执行结束
+     * @param ok 全部语句执行成功
+     * @param message 结果说明，出错时包含出错批次的语句范围与服务端消息
+     */
+    void finished(bool ok, const QString& message);
+
+private slots:
+    void readMore();
+    void onResponseReceived(quint64 requestId, const QByteArray& data);
+
+private:
+    // 一次发送的一批语句
+    struct Batch {
+        QString sql;
+        int firstStatement = 0; // 批次中第一条语句的序号(从1开始)
+        int count = 0;
+        bool wrapped = false;   // 是否包在BEGIN/COMMIT中
+    };
+
+    static const int readChunkBytes = 256 * 1024;
+
+    SqlProcessHandler* sqlHandler;
+    QFile file;
+    qint64 fileSize;
+    QTextDecoder* decoder;
+    SqlSplitter splitter;
+    QQueue<QString> statements;     // 已拆分、尚未组成批次的语句
+    int statementsBytes;
+    int batchStatements;
+    int batchBytes;
+
+    bool running;
+    bool stopRequested;
+    bool readFinished;
+    bool readScheduled;
+    bool scriptTransaction;         // 脚本自身开启了事务
+    bool schemaChanged;
+    int statementsRead;
+    int statementsBatched;
+    int statementsDone;
+    QElapsedTimer timer;
+
+    Batch nextBatch;                // 预先组好的下一批，count为0表示没有
+    Batch currentBatch;             // 正在执行的批次
+    quint64 currentRequestId;
+
+    void scheduleRead();
+    bool takeBatch();
+    void sendNext();
+    void finish(bool ok, const QString& message);
+    void noteStatement(const QString& statement, bool* control);
+};
+
+#endif // SCRIPTFILERUNNER_H
@@ -0,0 +1,97 @@
+#include "socketmanager.h"
+#include <QJsonObject>
+#include <QJsonDocument>
+#include "funcid.h"
+
+SocketManager* SocketManager::instance = nullptr;
+
+SocketManager* SocketManager::getInstance()
+{
+    if (!instance) {
+        instance = new SocketManager();
+    }
+    return instance;
+}
+
+SocketManager::SocketManager(QObject *parent)
+    : QObject(parent), socket(nullptr)
+{
+}
+
+SocketManager::~SocketManager()
+{
+    closeSocket();
+}
+
+void SocketManager::setSocket(QTcpSocket* newSocket)
+{
+    if (socket) {
+        closeSocket();
+    }
+    socket = newSocket;
+}
+
+void SocketManager::closeSocket()
+{
+    if (socket) {
+        if (socket->state() == QAbstractSocket::ConnectedState) {
+            socket->disconnectFromHost();
+            socket->waitForDisconnected();
+        }
+        delete socket;
+        socket = nullptr;
+    }
+}
+
+QTcpSocket* SocketManager::openConnection(const QString& ip, quint16 port, const QString& dbPath,
+                                          int timeoutMs, ConnectError* error, QString* errorMsg)
+{
+    auto fail = [&](ConnectError err, const QString& msg) -> QTcpSocket* {
+        if (error) *error = err;
+        if (errorMsg) *errorMsg = msg;
+        return nullptr;
+    };
+
+    QTcpSocket* newSocket = new QTcpSocket();
+    newSocket->connectToHost(ip, port);
+    if (!newSocket->waitForConnected(timeoutMs)) {
+        QString msg = newSocket->errorString();
+        delete newSocket;
+        return fail(ConnectError::HostUnreachable, msg);
+    }
+
+    // TCP连接成功，发送数据库连接请求
+    QJsonObject msgObj;
+    msgObj["dbpath"] = dbPath;
+
+    QJsonObject root;
+    root["funcid"] = CONNECT_DATABASE;
+    root["appid"] = APPID;
+    root["appkey"] = APPKEY;
+    root["msg"] = msgObj;
+    newSocket->write(QJsonDocument(root).toJson());
+
+    // 等待响应
+    if (!newSocket->waitForReadyRead(timeoutMs)) {
+        newSocket->disconnectFromHost();
+        delete newSocket;
+        return fail(ConnectError::Timeout, "等待服务器响应超时");
+    }
+
+    QJsonDocument doc = QJsonDocument::fromJson(newSocket->readAll());
+    if (!doc.isObject()) {
+        newSocket->disconnectFromHost();
+        delete newSocket;
+        return fail(ConnectError::BadResponse, "服务器响应格式错误");
+    }
+
+    QJsonObject respObj = doc.object();
+    if (respObj["status"].toInt() != 0) {
+        newSocket->disconnectFromHost();
+        delete newSocket;
+        return fail(ConnectError::DatabaseRejected, respObj["msg"].toString());
+    }
+
+    if (error) *error = ConnectError::None;
+    return newSocket;
+}
@@ -0,0 +1,51 @@
+#ifndef SOCKETMANAGER_H
+#define SOCKETMANAGER_H
+
+#include <QObject>
+#include <QTcpSocket>
+
+// 建立数据库连接时的失败原因
+enum class ConnectError {
+    None,               // 成功
+    HostUnreachable,    // TCP连接失败
+    Timeout,            // 等待握手响应超时
+    BadResponse,        // 握手响应格式错误
+    DatabaseRejected    // 服务端拒绝打开数据库
+};
+
+/**
+ * @brief socket持有者
+ * getInstance为进程默认连接(命令行客户端使用)，图形界面的每个会话各自创建一个实例
+ */
+class SocketManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SocketManager(QObject *parent = nullptr);
+    ~SocketManager();
+    static SocketManager* getInstance();
+    QTcpSocket* getSocket() { return socket; }
+    void setSocket(QTcpSocket* newSocket);
+    void closeSocket();
+
+    /**
+     * @brief 建立TCP连接并完成CONNECT_DATABASE握手，阻塞直到成功或超时
+     * @param ip 服务器地址
+     * @param port 服务器端口
+     * @param dbPath 服务端数据库路径
+     * @param timeoutMs TCP连接与握手响应各自的超时时间(毫秒)
+     * @param error 失败原因，可为空
+     * @param errorMsg 失败描述，可为空
+     * @return 成功返回无父对象的已连接socket，失败返回nullptr
+     */
+    static QTcpSocket* openConnection(const QString& ip, quint16 port, const QString& dbPath,
+                                      int timeoutMs, ConnectError* error = nullptr,
+                                      QString* errorMsg = nullptr);
+
+private:
+    static SocketManager* instance;
+    QTcpSocket* socket;
+};
+
+#endif // SOCKETMANAGER_H 
@@ -0,0 +1,662 @@
+#include "sqlprocesshandler.h"
+#include "socketmanager.h"
+#include "messagelog.h"
+
+SqlProcessHandler* SqlProcessHandler::instance = nullptr;
+
+SqlProcessHandler* SqlProcessHandler::getInstance()
+{
+    if (!instance) {
+        instance = new SqlProcessHandler();
+    }
+    return instance;
+}
+
+SqlProcessHandler::SqlProcessHandler(SocketManager* sockets, QObject *parent)
+    : QObject(parent), socketManager(sockets ? sockets : SocketManager::getInstance()),
+      tcpSocket(nullptr), nextRequestId(1), serverCancelEnabled(false),
+      heartbeatOutstanding(false), heartbeatIntervalMs(0), heartbeatTimeoutMs(5000),
+      reconnectActive(false), reconnectAttempt(0), reconnectMaxAttempts(0),
+      reconnectInitialDelayMs(500), reconnectMaxDelayMs(30000), reconnectSocket(nullptr)
+{
+    resetScanner();
+
+    // 每秒检查一次空闲时间与心跳应答
+    heartbeatTimer = new QTimer(this);
+    heartbeatTimer->setInterval(1000);
+    connect(heartbeatTimer, &QTimer::timeout, this, &SqlProcessHandler::onHeartbeatTimer);
+
+    reconnectTimeoutTimer = new QTimer(this);
+    reconnectTimeoutTimer->setSingleShot(true);
+    connect(reconnectTimeoutTimer, &QTimer::timeout, this, &SqlProcessHandler::abandonReconnectAttempt);
+}
+
+SqlProcessHandler::~SqlProcessHandler()
+{
+}
+
+void SqlProcessHandler::setSocket(QTcpSocket* socket)
+{
+    // 手动切换连接时放弃正在进行的重连和未完成的请求
+    if (reconnectSocket) {
+        reconnectTimeoutTimer->stop();
+        reconnectSocket->disconnect(this);
+        reconnectSocket->deleteLater();
+        reconnectSocket = nullptr;
+    }
+    reconnectActive = false;
+    pending.clear();
+    heartbeatOutstanding = false;
+    subscribedTables.clear();
+
+    detachSocket();
+    attachSocket(socket);
+}
+
+bool SqlProcessHandler::isConnected() const
+{
+    return tcpSocket && tcpSocket->state() == QAbstractSocket::ConnectedState;
+}
+
+void SqlProcessHandler::setConnectionProfile(const ConnectionProfile& profile)
+{
+    this->profile = profile;
+}
+
+void SqlProcessHandler::setHeartbeat(int intervalMs, int timeoutMs)
+{
+    heartbeatIntervalMs = qMax(0, intervalMs);
+    heartbeatTimeoutMs = qMax(1000, timeoutMs);
+    if (tcpSocket && heartbeatIntervalMs > 0) {
+        heartbeatTimer->start();
+    } else {
+        heartbeatTimer->stop();
+    }
+}
+
+void SqlProcessHandler::setReconnectPolicy(int maxAttempts, int initialDelayMs, int maxDelayMs)
+{
+    reconnectMaxAttempts = qMax(0, maxAttempts);
+    reconnectInitialDelayMs = qMax(100, initialDelayMs);
+    reconnectMaxDelayMs = qMax(reconnectInitialDelayMs, maxDelayMs);
+}
+
+void SqlProcessHandler::attachSocket(QTcpSocket* socket)
+{
+    tcpSocket = socket;
+    if (tcpSocket) {
+        // 连接新的信号槽
+        connect(tcpSocket, &QTcpSocket::readyRead, 
+                this, &SqlProcessHandler::handleReadyRead);
+        connect(tcpSocket, &QTcpSocket::disconnected,
+                this, &SqlProcessHandler::onSocketDisconnected);
+        connect(tcpSocket, static_cast<void(QTcpSocket::*)(QAbstractSocket::SocketError)>(&QTcpSocket::error),
+                this, &SqlProcessHandler::onSocketError);
+        // 系统层保活作为心跳之外的兜底
+        tcpSocket->setSocketOption(QAbstractSocket::KeepAliveOption, 1);
+        lastActivity.start();
+        if (heartbeatIntervalMs > 0) {
+            heartbeatTimer->start();
+        }
+    } else {
+        heartbeatTimer->stop();
+    }
+    
+    // 清空缓冲区
+    buffer.clear();
+    resetScanner();
+}
+
+void SqlProcessHandler::detachSocket()
+{
+    // 安全断开之前的连接
+    if (tcpSocket) {
+        disconnect(tcpSocket, nullptr, this, nullptr);
+    }
+    tcpSocket = nullptr;
+    heartbeatTimer->stop();
+}
+
+quint64 SqlProcessHandler::execSql(const QString& sql)
+{
+    // 将sql语句转换为json格式
+    QJsonObject sqlObj;
+    sqlObj["sqlstr"] = sql;
+    return sendRequest(EXEC_SQL, sqlObj, isIdempotentSql(sql));
+}
+
+quint64 SqlProcessHandler::subscribeTable(const QString& table)
+{
+    QJsonObject msgObj;
+    msgObj["table"] = table;
+    subscribedTables.insert(table);
+    return sendRequest(SUBSCRIBE_TABLE, msgObj, true);
+}
+
+quint64 SqlProcessHandler::unsubscribeTable(const QString& table)
+{
+    QJsonObject msgObj;
+    msgObj["table"] = table;
+    subscribedTables.remove(table);
+    return sendRequest(UNSUBSCRIBE_TABLE, msgObj, true);
+}
+
+quint64 SqlProcessHandler::sendRequest(const QString& funcid, const QJsonObject& msg, bool idempotent)
+{
+    PendingRequest request;
+    request.id = nextRequestId++;
+    request.cmd = convertCmd(funcid, msg).toUtf8();
+    request.heartbeat = false;
+    request.idempotent = idempotent;
+    request.sent = false;
+    request.funcid = funcid;
+    if (funcid == SUBSCRIBE_TABLE) {
+        request.table = msg["table"].toString();
+    }
+    if (MessageLog::getInstance()->isEnabled()) {
+        // 只截取SQL开头，大脚本不必整体转换
+        request.summary = msg.contains("sqlstr")
+                ? msg["sqlstr"].toString().left(256).toUtf8()
+                : QJsonDocument(msg).toJson(QJsonDocument::Compact);
+    }
+
+    if (!isConnected() && !reconnectActive) {
+        quint64 id = request.id;
+        QTimer::singleShot(0, this, [this, id]() {
+            emitFailure(id, "未连接到数据库服务器");
+        });
+        return request.id;
+    }
+
+    // 与在途的相同只读查询合并，共享同一条应答；订阅类请求有先后语义，不合并。
+    // 从队尾向前找，遇到写操作即停止，排在写之前的查询看不到写的结果；
+    // 等待者都已取消的请求可能是调用方有意放弃的旧结果，也不合并
+    if (idempotent && funcid == EXEC_SQL) {
+        for (int i = pending.size() - 1; i >= 0; --i) {
+            PendingRequest& other = pending[i];
+            if (!other.idempotent) {
+                break;
+            }
+            if (!other.heartbeat && !other.waiting.isEmpty() && other.cmd == request.cmd) {
+                other.waiting << request.id;
+                return request.id;
+            }
+        }
+    }
+    request.waiting << request.id;
+
+    // 空闲较久的连接可能已被NAT/防火墙静默丢弃，先发心跳探测，
+    // 心跳排在本请求之前应答，超时即可快速发现半开连接
+    if (isConnected() && heartbeatIntervalMs > 0 && pending.isEmpty()
+            && lastActivity.elapsed() >= heartbeatIntervalMs) {
+        sendHeartbeat();
+    }
+
+    pending.enqueue(request);
+    if (isConnected()) {
+        writeRequest(pending.last());
+    }
+    return request.id;
+}
+
+void SqlProcessHandler::writeRequest(PendingRequest& request)
+{
+    tcpSocket->write(request.cmd);
+    request.sent = true;
+    request.sentTimer.start();
+    if (!request.heartbeat) {
+        qCDebug(lcRequest) << "request" << request.id << request.funcid << request.cmd.size() << "bytes";
+        MessageLog::getInstance()->record(MessageLog::Sent, request.funcid, request.id, request.summary);
+    }
+}
+
+void SqlProcessHandler::sendHeartbeat()
+{
+    QJsonObject sqlObj;
+    sqlObj["sqlstr"] = "SELECT 1;";
+
+    PendingRequest request;
+    request.id = nextRequestId++;
+    request.cmd = convertCmd(EXEC_SQL, sqlObj).toUtf8();
+    request.heartbeat = true;
+    request.idempotent = true;
+    request.sent = false;
+    request.funcid = EXEC_SQL;
+
+    pending.enqueue(request);
+    writeRequest(pending.last());
+    heartbeatOutstanding = true;
+    heartbeatSent.start();
+}
+
+void SqlProcessHandler::onHeartbeatTimer()
+{
+    if (!isConnected() || heartbeatIntervalMs <= 0) {
+        return;
+    }
+
+    if (heartbeatOutstanding) {
+        if (heartbeatSent.elapsed() > heartbeatTimeoutMs) {
+            handleConnectionDead("心跳超时，连接已失效");
+        }
+        return;
+    }
+
+    // 有请求在途时服务端正忙，不插入心跳
+    if (pending.isEmpty() && lastActivity.elapsed() >= heartbeatIntervalMs) {
+        sendHeartbeat();
+    }
+}
+
+void SqlProcessHandler::onSocketDisconnected()
+{
+    handleConnectionDead("连接已被服务器关闭");
+}
+
+void SqlProcessHandler::onSocketError(QAbstractSocket::SocketError error)
+{
+    Q_UNUSED(error);
+    if (tcpSocket) {
+        handleConnectionDead(tcpSocket->errorString());
+    }
+}
+
+void SqlProcessHandler::handleReadyRead()
+{
+    buffer.append(tcpSocket->readAll());
+    lastActivity.restart();
+
+    // 一次读取可能包含多条完整响应，逐条发出
+    int end;
+    while ((end = scanMessageEnd()) > 0) {
+        QByteArray data = buffer.left(end);
+        buffer.remove(0, end);
+        resetScanner();
+
+        // 推送消息不占用请求队列中的位置
+        QJsonObject message;
+        if (isPushMessage(data, &message)) {
+            handlePushMessage(message, data);
+            continue;
+        }
+
+        if (pending.isEmpty()) {
+            emit dataReceived(data);
+            continue;
+        }
+
+        PendingRequest request = pending.dequeue();
+        if (request.heartbeat) {
+            heartbeatOutstanding = false;
+            continue;
+        }
+        // 只记录大小、耗时和开头一小段，不格式化整个载荷
+        qint64 elapsed = request.sentTimer.isValid() ? request.sentTimer.elapsed() : -1;
+        qCDebug(lcResponse) << "response" << request.id << data.size() << "bytes" << elapsed << "ms"
+                            << "waiting" << request.waiting.size();
+        MessageLog::getInstance()->record(MessageLog::Received, request.funcid, request.id, data, elapsed);
+        // 订阅被拒绝时服务端不会推送，也不在重连后重新订阅
+        if (request.funcid == SUBSCRIBE_TABLE) {
+            bool ok = false;
+            QJsonObject reply = TableData::parseResponse(data, &ok);
+            if (!ok || reply["status"].toInt() != 0) {
+                subscribedTables.remove(request.table);
+            }
+        }
+        // 请求已全部被取消，丢弃应答
+        if (request.waiting.isEmpty()) {
+            continue;
+        }
+        emit dataReceived(data);
+        for (quint64 id : request.waiting) {
+            emit responseReceived(id, data);
+        }
+    }
+}
+
+bool SqlProcessHandler::isPushMessage(const QByteArray& data, QJsonObject* message)
+{
+    // 应答整体被引号包裹或带有status字段，推送消息有funcid而没有status；
+    // 键的顺序与空白由服务端的序列化决定，不能按前缀判断。先做廉价的检查，避免每个大应答都完整解析一次
+    int pos = 0;
+    while (pos < data.size() && QChar::isSpace(static_cast<uchar>(data.at(pos)))) {
+        ++pos;
+    }
+    if (pos >= data.size() || data.at(pos) != '{' || !data.contains("\"funcid\"")) {
+        return false;
+    }
+    QJsonObject obj = QJsonDocument::fromJson(data).object();
+    if (!obj.contains("funcid") || obj.contains("status")) {
+        return false;
+    }
+    *message = obj;
+    return true;
+}
+
+void SqlProcessHandler::handlePushMessage(const QJsonObject& obj, const QByteArray& data)
+{
+    if (obj["funcid"].toString() != CHANGE_NOTIFY) {
+        return;
+    }
+    MessageLog::getInstance()->record(MessageLog::Pushed, CHANGE_NOTIFY, 0, data);
+    const QString table = obj["table"].toString();
+    if (subscribedTables.contains(table)) {
+        emit changeNotified(table, obj["events"].toArray());
+    }
+}
+
+void SqlProcessHandler::emitFailure(quint64 requestId, const QString& msg)
+{
+    QJsonObject root;
+    root["status"] = -1;
+    root["msg"] = msg;
+    QByteArray data = QJsonDocument(root).toJson(QJsonDocument::Compact);
+    qCInfo(lcResponse) << "request" << requestId << "failed:" << msg;
+    MessageLog::getInstance()->record(MessageLog::Failed, QString(), requestId, data);
+    emit dataReceived(data);
+    emit responseReceived(requestId, data);
+}
+
+void SqlProcessHandler::failRequest(const PendingRequest& request, const QString& msg)
+{
+    for (quint64 id : request.waiting) {
+        emitFailure(id, msg);
+    }
+}
+
+void SqlProcessHandler::cancelRequest(quint64 requestId)
+{
+    for (int i = 0; i < pending.size(); ++i) {
+        PendingRequest& request = pending[i];
+        if (!request.waiting.removeOne(requestId)) {
+            continue;
+        }
+        if (!request.waiting.isEmpty()) {
+            return;     // 还有合并的请求在等待同一条应答
+        }
+        if (!request.sent) {
+            pending.removeAt(i);
+        } else if (i == 0 && serverCancelEnabled && isConnected()) {
+            // 队首请求正在服务端执行，中断它；CANCEL_SQL没有应答，不进入队列
+            tcpSocket->write(convertCmd(CANCEL_SQL, QJsonObject()).toUtf8());
+        }
+        return;
+    }
+}
+
+void SqlProcessHandler::failPending(const QString& msg)
+{
+    QQueue<PendingRequest> failed = pending;
+    pending.clear();
+    heartbeatOutstanding = false;
+    for (const PendingRequest& request : failed) {
+        if (!request.heartbeat) {
+            failRequest(request, msg);
+        }
+    }
+}
+
+void SqlProcessHandler::handleConnectionDead(const QString& reason)
+{
+    if (!tcpSocket || reconnectActive) {
+        return;
+    }
+
+    // 旧socket仍由socketManager持有，重连成功后替换时释放
+    QTcpSocket* deadSocket = tcpSocket;
+    detachSocket();
+    deadSocket->abort();
+    buffer.clear();
+    resetScanner();
+
+    // 丢弃未应答的心跳
+    heartbeatOutstanding = false;
+    QQueue<PendingRequest> remaining;
+    for (const PendingRequest& request : pending) {
+        if (!request.heartbeat) {
+            remaining.enqueue(request);
+        }
+    }
+    pending = remaining;
+
+    qCInfo(lcConnection) << "connection lost:" << reason << "pending" << pending.size();
+    emit connectionLost(reason);
+
+    if (!profile.isValid() || reconnectMaxAttempts == 0) {
+        failPending(reason);
+        emit reconnectFailed(reason);
+        return;
+    }
+
+    reconnectActive = true;
+    reconnectAttempt = 0;
+    scheduleReconnect();
+}
+
+void SqlProcessHandler::scheduleReconnect()
+{
+    if (reconnectAttempt >= reconnectMaxAttempts) {
+        reconnectActive = false;
+        QString reason = QString("重连%1次均失败").arg(reconnectAttempt);
+        failPending(reason);
+        emit reconnectFailed(reason);
+        return;
+    }
+
+    // 第一次立即重连，之后按指数退避
+    int delay = 0;
+    if (reconnectAttempt > 0) {
+        delay = reconnectInitialDelayMs;
+        for (int i = 1; i < reconnectAttempt && delay < reconnectMaxDelayMs; ++i) {
+            delay *= 2;
+        }
+        delay = qMin(delay, reconnectMaxDelayMs);
+    }
+    ++reconnectAttempt;
+    emit reconnecting(reconnectAttempt, delay);
+    QTimer::singleShot(delay, this, &SqlProcessHandler::tryReconnect);
+}
+
+void SqlProcessHandler::tryReconnect()
+{
+    if (!reconnectActive) {
+        return;
+    }
+
+    reconnectBuffer.clear();
+    reconnectSocket = new QTcpSocket(this);
+
+    // TCP连接成功后重放CONNECT_DATABASE握手
+    connect(reconnectSocket, &QTcpSocket::connected, this, [this]() {
+        QJsonObject msgObj;
+        msgObj["dbpath"] = profile.dbPath;
+        reconnectSocket->write(convertCmd(CONNECT_DATABASE, msgObj).toUtf8());
+    });
+    connect(reconnectSocket, &QTcpSocket::readyRead, this, [this]() {
+        reconnectBuffer.append(reconnectSocket->readAll());
+        QJsonDocument doc = QJsonDocument::fromJson(reconnectBuffer);
+        if (!doc.isObject()) {
+            return;  // 握手响应尚未收全
+        }
+        if (doc.object()["status"].toInt() == 0) {
+            finishReconnect();
+        } else {
+            abandonReconnectAttempt();
+        }
+    });
+    connect(reconnectSocket, static_cast<void(QTcpSocket::*)(QAbstractSocket::SocketError)>(&QTcpSocket::error),
+            this, &SqlProcessHandler::abandonReconnectAttempt);
+
+    reconnectTimeoutTimer->start(heartbeatTimeoutMs);
+    reconnectSocket->connectToHost(profile.ip, profile.port);
+}
+
+void SqlProcessHandler::abandonReconnectAttempt()
+{
+    if (!reconnectSocket) {
+        return;
+    }
+    reconnectTimeoutTimer->stop();
+    reconnectSocket->disconnect(this);
+    reconnectSocket->abort();
+    reconnectSocket->deleteLater();
+    reconnectSocket = nullptr;
+    scheduleReconnect();
+}
+
+void SqlProcessHandler::finishReconnect()
+{
+    reconnectTimeoutTimer->stop();
+    QTcpSocket* socket = reconnectSocket;
+    reconnectSocket = nullptr;
+    socket->disconnect(this);
+    socket->setParent(nullptr);
+    reconnectActive = false;
+
+    // 交给socketManager管理，同时释放已失效的旧socket
+    socketManager->setSocket(socket);
+    attachSocket(socket);
+
+    // 订阅随旧连接失效，先重新订阅
+    QQueue<PendingRequest> previous = pending;
+    pending.clear();
+    for (const QString& table : subscribedTables) {
+        QJsonObject msgObj;
+        msgObj["table"] = table;
+        sendRequest(SUBSCRIBE_TABLE, msgObj, true);
+    }
+
+    // 只读请求透明重发；已发出的写请求可能已执行也可能未执行，交由上层确认
+    for (PendingRequest request : previous) {
+        if (request.waiting.isEmpty()) {
+            continue;   // 已取消的请求不再重发
+        }
+        if (request.sent && !request.idempotent) {
+            failRequest(request, "连接中断，写操作结果未知，请确认后重试");
+            continue;
+        }
+        pending.enqueue(request);
+        writeRequest(pending.last());
+    }
+
+    qCInfo(lcConnection) << "reconnected to" << profile.ip << profile.port;
+    emit reconnected();
+}
+
+bool SqlProcessHandler::isIdempotentSql(const QString& sql)
+{
+    QString upper = sql.trimmed().toUpper();
+    while (upper.endsWith(';')) {
+        upper.chop(1);
+    }
+    // 多条语句的脚本不做判断，一律视为写操作
+    if (upper.contains(';')) {
+        return false;
+    }
+    if (upper.startsWith("SELECT") || upper.startsWith("EXPLAIN")) {
+        return true;
+    }
+    // 带赋值的PRAGMA会修改设置
+    if (upper.startsWith("PRAGMA")) {
+        return !upper.contains('=');
+    }
+    // WITH子句后可能跟写语句
+    if (upper.startsWith("WITH")) {
+        return !upper.contains("INSERT") && !upper.contains("UPDATE")
+                && !upper.contains("DELETE") && !upper.contains("REPLACE");
+    }
+    return false;
+}
+
+void SqlProcessHandler::resetScanner()
+{
+    scanPos = 0;
+    scanDepth = 0;
+    scanStarted = false;
+    scanInString = false;
+    scanEscaped = false;
+    scanTopString = false;
+}
+
+int SqlProcessHandler::scanMessageEnd()
+{
+    const char* p = buffer.constData();
+    const int size = buffer.size();
+
+    for (; scanPos < size; ++scanPos) {
+        const char c = p[scanPos];
+
+        if (!scanStarted) {
+            if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+                continue;
+            }
+            scanStarted = true;
+            if (c == '{') {
+                scanDepth = 1;
+            } else if (c == '"') {
+                scanInString = true;
+                scanTopString = true;
+            } else {
+                // 不是JSON格式的响应，无法分帧，按原样整体交给上层
+                scanPos = size;
+                return size;
+            }
+            continue;
+        }
+
+        if (scanInString) {
+            if (scanEscaped) {
+                scanEscaped = false;
+            } else if (c == '\\') {
+                scanEscaped = true;
+            } else if (c == '"') {
+                scanInString = false;
+                if (scanTopString) {
+                    return scanPos + 1;
+                }
+            }
+            continue;
+        }
+
+        if (c == '"') {
+            scanInString = true;
+        } else if (c == '{' || c == '[') {
+            ++scanDepth;
+        } else if (c == '}' || c == ']') {
+            if (--scanDepth == 0) {
+                return scanPos + 1;
+            }
+        }
+    }
+    return 0;
+}
+
+QString SqlProcessHandler::convertCmd(QString funcid, QJsonObject obj)
+{
+    QJsonObject root;
+    root["funcid"] = funcid;
+    root["appid"] = APPID;
+    root["appkey"] = APPKEY;
+    root["msg"] = obj;
+    return QJsonDocument(root).toJson();
+}
+
+int SqlProcessHandler::convertInsertSql(TableData *pData)
+{
+    return 0;
+}
+
+int SqlProcessHandler::convertUpdateSql(TableData *pData)
+{
+    return 0;
+}
+
+int SqlProcessHandler::convertDeleteSql(TableData *pData)
+{
+    return 0;
+}
+
+int SqlProcessHandler::convertQueryListSql(std::string tableName)
+{
+    return 0;
+}
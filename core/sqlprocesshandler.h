@@ -0,0 +1,189 @@
+#ifndef SQLPROCESSHANDLER_H
+#define SQLPROCESSHANDLER_H
+
+#include <QObject>
+#include <QTcpSocket>
+#include <QString>
+#include <QQueue>
+#include <QSet>
+#include <QJsonArray>
+#include <QVector>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <string>
+#include "tabledata.h"
+#include "funcid.h"
+#include "connectionprofile.h"
+
+class SocketManager;
+
+class SqlProcessHandler : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 每个连接一个处理器
+     * @param sockets 持有本连接socket的SocketManager，重连成功后由它替换并释放旧socket；
+     * 为空时使用进程默认的SocketManager
+     */
+    explicit SqlProcessHandler(SocketManager* sockets = nullptr, QObject *parent = nullptr);
+    virtual ~SqlProcessHandler();
+
+    /**
+     * @brief 进程默认的处理器，与SocketManager::getInstance配套
+     */
+    static SqlProcessHandler* getInstance();
+    void setSocket(QTcpSocket* socket);
+    bool isConnected() const;
+
+    /**
+     * @brief 设置当前连接信息，断线后按此信息自动重连
+     */
+    void setConnectionProfile(const ConnectionProfile& profile);
+    const ConnectionProfile& connectionProfile() const { return profile; }
+
+    /**
+     * @brief 设置心跳参数
+     * @param intervalMs 连接空闲多久后发送心跳，0表示关闭心跳
+     * @param timeoutMs 心跳多久未应答判定为连接已失效
+     */
+    void setHeartbeat(int intervalMs, int timeoutMs);
+
+    /**
+     * @brief 设置断线重连策略，重连间隔从initialDelayMs开始逐次翻倍，不超过maxDelayMs
+     * @param maxAttempts 最大重连次数，0表示不自动重连
+     */
+    void setReconnectPolicy(int maxAttempts, int initialDelayMs, int maxDelayMs);
+
+    /**
+     * @brief 发送一条SQL
+     * @return 请求ID，与responseReceived中的ID对应
+     */
+    quint64 execSql(const QString& sql);
+
+    /**
+     * @brief 订阅表的行级变更，服务端之后通过changeNotified推送该表的插入、更新与删除，
+     * 断线重连后自动重新订阅
+     * @return 请求ID
+     */
+    quint64 subscribeTable(const QString& table);
+
+    /**
+     * @brief 放弃一个请求，之后不再为它发出responseReceived。
+     * 尚未发出的请求直接移出队列；已发出的请求应答到达后丢弃，
+     * 若它正在服务端执行且服务端支持取消，则发送CANCEL_SQL中断执行
+     */
+    void cancelRequest(quint64 requestId);
+
+    /**
+     * @brief 服务端是否支持CANCEL_SQL，不支持时只在客户端丢弃应答
+     */
+    void setServerCancelEnabled(bool enabled) { serverCancelEnabled = enabled; }
+    quint64 unsubscribeTable(const QString& table);
+    QString convertCmd(QString funcid, QJsonObject obj);
+    int convertInsertSql(TableData *pData);
+    int convertUpdateSql(TableData *pData);
+    int convertDeleteSql(TableData *pData);
+    int convertQueryListSql(std::string tableName);
+
+    /**
+     * @brief 判断SQL是否可以安全地重复执行(只读语句)，断线重连后只重发这类请求
+     */
+    static bool isIdempotentSql(const QString& sql);
+
+signals:
+    void dataReceived(const QByteArray& data);
+    void responseReceived(quint64 requestId, const QByteArray& data);
+    void connectionLost(const QString& reason);
+    void reconnecting(int attempt, int delayMs);
+    void reconnected();
+    void reconnectFailed(const QString& reason);
+
+    /**
+     * @brief 服务端推送的变更通知
+     * @param table 表名
+     * @param events 变更事件，每项含op(insert/update/delete)、rowid以及变更后的row
+     */
+    void changeNotified(const QString& table, const QJsonArray& events);
+
+private slots:
+    void handleReadyRead();
+    void onHeartbeatTimer();
+    void onSocketDisconnected();
+    void onSocketError(QAbstractSocket::SocketError error);
+    void tryReconnect();
+
+private:
+    static SqlProcessHandler* instance;
+
+    SocketManager* socketManager;
+    QTcpSocket* tcpSocket;
+    QByteArray buffer;
+
+    // 响应分帧：TCP可能把一条响应拆成多段或把多条响应合并，
+    // 这里按JSON的括号/字符串嵌套扫描出完整的一条响应后再发出dataReceived
+    int scanPos;        // 已扫描到的位置，避免大响应分段到达时重复扫描
+    int scanDepth;      // 当前对象/数组嵌套深度
+    bool scanStarted;   // 是否已遇到响应的第一个有效字符
+    bool scanInString;  // 是否处于字符串内
+    bool scanEscaped;   // 上一个字符是否为转义符
+    bool scanTopString; // 响应整体是否为被引号包裹的字符串
+
+    int scanMessageEnd();
+    void resetScanner();
+    static bool isPushMessage(const QByteArray& data, QJsonObject* message);
+    void handlePushMessage(const QJsonObject& obj, const QByteArray& data);
+
+    // 服务端按请求顺序应答，用FIFO队列把响应对应回请求
+    struct PendingRequest {
+        quint64 id;
+        QByteArray cmd;
+        bool heartbeat;     // 心跳请求，应答不向上层发出
+        bool idempotent;    // 只读请求，重连后可透明重发
+        bool sent;          // 是否已写入socket
+        QVector<quint64> waiting;   // 等待该应答的请求ID，相同的只读查询合并为一条请求共享应答
+        QString funcid;
+        QString table;              // 订阅请求的表，应答失败时撤销订阅
+        QByteArray summary;         // 记入MessageLog的请求开头部分(SQL语句)，不含appkey
+        QElapsedTimer sentTimer;    // 写入socket的时间，用于统计应答耗时
+    };
+    QQueue<PendingRequest> pending;
+    quint64 nextRequestId;
+    QSet<QString> subscribedTables;     // 重连后需要重新订阅的表
+    bool serverCancelEnabled;
+
+    // 心跳
+    QTimer* heartbeatTimer;
+    QElapsedTimer lastActivity;     // 最近一次收到数据的时间
+    QElapsedTimer heartbeatSent;    // 未应答心跳的发送时间
+    bool heartbeatOutstanding;
+    int heartbeatIntervalMs;
+    int heartbeatTimeoutMs;
+
+    // 断线重连
+    ConnectionProfile profile;
+    bool reconnectActive;
+    int reconnectAttempt;
+    int reconnectMaxAttempts;
+    int reconnectInitialDelayMs;
+    int reconnectMaxDelayMs;
+    QTcpSocket* reconnectSocket;
+    QByteArray reconnectBuffer;
+    QTimer* reconnectTimeoutTimer;
+
+    quint64 sendRequest(const QString& funcid, const QJsonObject& msg, bool idempotent);
+    void attachSocket(QTcpSocket* socket);
+    void detachSocket();
+    void writeRequest(PendingRequest& request);
+    void sendHeartbeat();
+    void emitFailure(quint64 requestId, const QString& msg);
+    void failRequest(const PendingRequest& request, const QString& msg);
+    void failPending(const QString& msg);
+    void handleConnectionDead(const QString& reason);
+    void scheduleReconnect();
+    void abandonReconnectAttempt();
+    void finishReconnect();
+};
+
+#endif // SQLPROCESSHANDLER_H
@@ -0,0 +1,129 @@
+#include "sqlsplitter.h"
+
+SqlSplitter::SqlSplitter()
+    : currentBegin(0), offset(0), lineComment(false), blockComment(false),
+      inTrigger(false), blockDepth(0)
+{
+}
+
+void SqlSplitter::feed(const QString& chunk)
+{
+    for (const QChar c : chunk) {
+        if (current.isEmpty()) {
+            // 跳过语句之间的空白
+            if (c.isSpace()) {
+                ++offset;
+                continue;
+            }
+            currentBegin = static_cast<int>(offset);
+        }
+        current.append(c);
+        ++offset;
+
+        if (lineComment) {
+            if (c == '\n') {
+                lineComment = false;
+            }
+        } else if (blockComment) {
+            if (previous == '*' && c == '/') {
+                blockComment = false;
+                previous = QChar();
+                continue;
+            }
+        } else if (!quote.isNull()) {
+            // 引号内连续两个引号表示转义，退出后再次进入即可
+            if ((quote == '[' && c == ']') || c == quote) {
+                quote = QChar();
+            }
+        } else if (c.isLetterOrNumber() || c == '_') {
+            word.append(c);
+        } else {
+            endWord();
+            if (c == '\'' || c == '"' || c == '`') {
+                quote = c;
+            } else if (c == '[') {
+                quote = c;
+            } else if (previous == '-' && c == '-') {
+                lineComment = true;
+            } else if (previous == '/' && c == '*') {
+                blockComment = true;
+                previous = QChar();
+                continue;
+            } else if (c == ';' && blockDepth == 0) {
+                endStatement();
+                previous = QChar();
+                continue;
+            }
+        }
+        previous = c;
+    }
+}
+
+void SqlSplitter::endWord()
+{
+    if (word.isEmpty()) {
+        return;
+    }
+    const QString upper = word.toUpper();
+    word.clear();
+
+    if (leadingWords.size() < 4) {
+        leadingWords << upper;
+        // CREATE [TEMP|TEMPORARY] TRIGGER
+        if (upper == "TRIGGER" && leadingWords.first() == "CREATE") {
+            inTrigger = true;
+        }
+    }
+    if (!inTrigger) {
+        return;
+    }
+    if (upper == "BEGIN" || (upper == "CASE" && blockDepth > 0)) {
+        ++blockDepth;
+    } else if (upper == "END" && blockDepth > 0) {
+        --blockDepth;
+    }
+}
+
+void SqlSplitter::endStatement()
+{
+    SqlStatement statement;
+    statement.text = current.trimmed();
+    statement.begin = currentBegin;
+    statement.end = static_cast<int>(offset);
+    if (!statement.text.isEmpty() && statement.text != ";") {
+        ready << statement;
+    }
+
+    current.clear();
+    word.clear();
+    leadingWords.clear();
+    inTrigger = false;
+    blockDepth = 0;
+}
+
+void SqlSplitter::finish()
+{
+    endWord();
+    lineComment = false;
+    blockComment = false;
+    quote = QChar();
+    if (!current.trimmed().isEmpty()) {
+        endStatement();
+    }
+    current.clear();
+}
+
+QVector<SqlStatement> SqlSplitter::takeStatements()
+{
+    QVector<SqlStatement> statements = ready;
+    ready.clear();
+    return statements;
+}
+
+QVector<SqlStatement> SqlSplitter::split(const QString& script)
+{
+    SqlSplitter splitter;
+    splitter.feed(script);
+    splitter.finish();
+    return splitter.takeStatements();
+}
@@ -0,0 +1,70 @@
+#ifndef SQLSPLITTER_H
+#define SQLSPLITTER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// 拆分出的一条SQL语句及其在原文中的位置
+struct SqlStatement {
+    QString text;   // 语句文本(含结尾分号)
+    int begin;      // 在原文中的起始偏移
+    int end;        // 在原文中的结束偏移(不含)
+};
+
+/**
+ * @brief 增量式SQL语句拆分器
+ * 按分号拆分语句，正确跳过字符串、引号标识符、注释，
+ * 以及CREATE TRIGGER ... BEGIN ... END中的分号。
+ * 可以分段喂入文本，适合逐块读取的大脚本。
+ */
+class SqlSplitter {
+public:
+    SqlSplitter();
+
+    /**
+     * @brief 喂入一段文本，完整的语句可通过takeStatements取出
+     */
+    void feed(const QString& chunk);
+
+    /**
+     * @brief 输入结束，把剩余的非空文本作为最后一条语句
+     */
+    void finish();
+
+    /**
+     * @brief 取出已拆分完成的语句，偏移相对于第一次feed的文本开头
+     */
+    QVector<SqlStatement> takeStatements();
+
+    /**
+     * @brief 当前尚未结束的语句长度，用于判断缓冲是否过大
+     */
+    int pendingLength() const { return current.size(); }
+
+    /**
+     * @brief 一次性拆分整段脚本
+     */
+    static QVector<SqlStatement> split(const QString& script);
+
+private:
+    QString current;                // 当前语句已读入的文本
+    int currentBegin;               // 当前语句的起始偏移
+    qint64 offset;                  // 已处理的总字符数
+    QVector<SqlStatement> ready;    // 已完成的语句
+
+    // 词法状态
+    QChar quote;                    // 所在的引号类型，空表示不在引号内
+    bool lineComment;
+    bool blockComment;
+    QChar previous;
+    QString word;                   // 正在读取的单词
+    QStringList leadingWords;       // 语句开头的几个单词，用于识别CREATE TRIGGER
+    bool inTrigger;                 // 处于CREATE TRIGGER语句中
+    int blockDepth;                 // 触发器BEGIN/CASE与END的嵌套深度
+
+    void endWord();
+    void endStatement();
+};
+
+#endif // SQLSPLITTER_H
@@ -0,0 +1,138 @@
+#include "tabledata.h"
+#include <QBuffer>
+#include "jsonstreamwriter.h"
+
+TableData::TableData() : status(0) {}
+
+TableData::~TableData() {}
+
+void TableData::setStatus(int status) {
+    this->status = status;
+}
+
+void TableData::setMsg(const QString& msg) {
+    this->msg = msg;
+}
+
+void TableData::addColumn(const QString& column, const QString& type) {
+    columns[column] = type;
+}
+
+void TableData::addRow(const QMap<QString, QString>& rowData) {
+    rows.append(rowData);
+}
+
+QJsonObject TableData::toJsonObject() const {
+    QJsonObject root;
+    root["status"] = status;
+    root["msg"] = msg;
+    
+    // 添加列信息
+    QJsonObject columnsObj;
+    for (auto it = columns.constBegin(); it != columns.constEnd(); ++it) {
+        columnsObj[it.key()] = it.value();
+    }
+    root["columns"] = columnsObj;
+    
+    // 添加行数据
+    QJsonArray rowsArray;
+    for (const auto& row : rows) {
+        QJsonObject rowObj;
+        for (auto it = columns.constBegin(); it != columns.constEnd(); ++it) {
+            rowObj[it.key()] = row.value(it.key(), "");
+        }
+        rowsArray.append(rowObj);
+    }
+    root["rows"] = rowsArray;
+    
+    return root;
+}
+
+QString TableData::toJson() const {
+    QByteArray json;
+    QBuffer buffer(&json);
+    buffer.open(QIODevice::WriteOnly);
+    writeJson(&buffer);
+    return QString::fromUtf8(json);
+}
+
+bool TableData::writeJson(QIODevice* device) const {
+    // 键的顺序与QJsonObject一致(按字母序)：columns、msg、rows、status
+    JsonStreamWriter writer(device);
+    writer.beginObject();
+
+    writer.writeKey("columns");
+    writer.beginObject();
+    for (auto it = columns.constBegin(); it != columns.constEnd(); ++it) {
+        writer.writeMember(it.key(), it.value());
+    }
+    writer.endObject();
+
+    writer.writeMember("msg", msg);
+
+    writer.writeKey("rows");
+    writer.beginArray();
+    const QString empty;
+    for (const auto& row : rows) {
+        writer.beginObject();
+        for (auto it = columns.constBegin(); it != columns.constEnd(); ++it) {
+            auto value = row.constFind(it.key());
+            writer.writeMember(it.key(), value != row.constEnd() ? value.value() : empty);
+        }
+        writer.endObject();
+    }
+    writer.endArray();
+
+    writer.writeMember("status", qint64(status));
+    writer.endObject();
+    return writer.flush();
+}
+
+QJsonObject TableData::parseResponse(const QByteArray& data, bool* ok) {
+    // 移除可能的转义字符并解析JSON
+    QString jsonStr = QString::fromUtf8(data).trimmed();
+    // 如果数据两端有引号，移除它们
+    if (jsonStr.startsWith("\"") && jsonStr.endsWith("\"")) {
+        jsonStr = jsonStr.mid(1, jsonStr.length() - 2);
+    }
+    // 处理转义字符
+    jsonStr.replace("\\\"", "\"");
+    jsonStr.replace("\\\\", "\\");
+
+    QJsonDocument doc = QJsonDocument::fromJson(jsonStr.toUtf8());
+    if (ok) {
+        *ok = doc.isObject();
+    }
+    return doc.object();
+}
+
+QString TableData::cellText(const QJsonValue& value) {
+    return value.isString() ? value.toString() : value.toVariant().toString();
+}
+
+QString TableData::sqlLiteral(const QString& value) {
+    return "'" + QString(value).replace("'", "''") + "'";
+}
+
+TableData TableData::fromJsonObject(const QJsonObject& obj) {
+    TableData tableData;
+    tableData.setStatus(obj["status"].toInt());
+    tableData.setMsg(obj["msg"].toString());
+
+    QJsonObject columns = obj["columns"].toObject();
+    for (auto it = columns.begin(); it != columns.end(); ++it) {
+        tableData.addColumn(it.key(), it.value().toString());
+    }
+
+    // 添加行数据
+    QJsonArray rows = obj["rows"].toArray();
+    for (const auto& row : rows) {
+        QJsonObject rowObj = row.toObject();
+        QMap<QString, QString> rowData;
+        for (auto it = columns.begin(); it != columns.end(); ++it) {
+            rowData[it.key()] = rowObj[it.key()].toString();
+        }
+        tableData.addRow(rowData);
+    }
+    return tableData;
+}
@@ -7,6 +7,7 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QIODevice>
 
 /**
  * @brief 数据表结构类，用于存储数据库查询结果
@@ -48,12 +49,46 @@ public:
      */
     QString toJson() const;
 
+    /**
+     * @brief 逐行把查询结果写入设备，不构造中间的QJsonObject
+     * 输出与toJson相同(紧凑格式，键按字母序)
+     * @param device 已打开的可写设备
+     * @return 是否全部写入成功
+     */
+    bool writeJson(QIODevice* device) const;
+
     /**
      * @brief 将查询结果转换为QJsonObject
      * @return QJsonObject对象
      */
     QJsonObject toJsonObject() const;
 
+    /**
+     * @brief 解析服务端返回的一条原始响应
+     * 兼容响应整体被引号包裹且内部引号被转义的格式
+     * @param data 原始响应数据
+     * @param ok 解析成功时置为true，可为空
+     * @return 响应的JSON对象，解析失败时为空对象
+     */
+    static QJsonObject parseResponse(const QByteArray& data, bool* ok = nullptr);
+
+    /**
+     * @brief 单元格的文本：服务端通常把值都返回为字符串，这里同时兼容数字
+     */
+    static QString cellText(const QJsonValue& value);
+
+    /**
+     * @brief 转为SQL字符串字面量，单引号加倍
+     */
+    static QString sqlLiteral(const QString& value);
+
+    /**
+     * @brief 由响应JSON对象构造TableData
+     * @param obj 包含status、msg、columns、rows的JSON对象
+     * @return 填充好的TableData
+     */
+    static TableData fromJsonObject(const QJsonObject& obj);
+
     /**
      * @brief 获取查询状态
      * @return 查询状态码
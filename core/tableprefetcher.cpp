@@ -0,0 +1,112 @@
+#include "tableprefetcher.h"
+#include "indexadvisor.h"
+
+TablePrefetcher::TablePrefetcher(SqlProcessHandler* handler, QObject *parent)
+    : QObject(parent), sqlHandler(handler), pageRows(200), byteBudget(4 * 1024 * 1024),
+      cachedBytes(0), useCounter(0), inFlightId(0)
+{
+    connect(sqlHandler, &SqlProcessHandler::responseReceived,
+            this, &TablePrefetcher::onResponseReceived);
+}
+
+void TablePrefetcher::prefetch(const QStringList& tables)
+{
+    queue.clear();
+    if (byteBudget <= 0) {
+        return;
+    }
+    for (const QString& table : tables) {
+        if (!table.isEmpty() && !cache.contains(table) && table != inFlightTable) {
+            queue.enqueue(table);
+        }
+    }
+    sendNext();
+}
+
+void TablePrefetcher::sendNext()
+{
+    if (inFlightId != 0 || queue.isEmpty()) {
+        return;
+    }
+    inFlightTable = queue.dequeue();
+    inFlightId = sqlHandler->execSql(QString("SELECT * FROM %1 LIMIT %2;")
+                                     .arg(IndexAdvisor::quoteIdentifier(inFlightTable)).arg(pageRows));
+}
+
+void TablePrefetcher::cancelExcept(const QString& table)
+{
+    queue.clear();
+    if (inFlightId != 0 && inFlightTable != table) {
+        sqlHandler->cancelRequest(inFlightId);
+        inFlightId = 0;
+        inFlightTable.clear();
+    }
+}
+
+bool TablePrefetcher::cachedPage(const QString& table, ResultStore* page)
+{
+    auto it = cache.find(table);
+    if (it == cache.end()) {
+        return false;
+    }
+    if (it->age.elapsed() > maxAgeMs) {
+        invalidate(table);
+        return false;
+    }
+    it->lastUse = ++useCounter;
+    *page = it->page;
+    return true;
+}
+
+void TablePrefetcher::invalidate(const QString& table)
+{
+    auto it = cache.find(table);
+    if (it != cache.end()) {
+        cachedBytes -= it->bytes;
+        cache.erase(it);
+    }
+}
+
+void TablePrefetcher::onResponseReceived(quint64 requestId, const QByteArray& data)
+{
+    if (requestId != inFlightId) {
+        return;
+    }
+    const QString table = inFlightTable;
+    inFlightId = 0;
+    inFlightTable.clear();
+
+    // 单个结果超过预算一半时不缓存，避免一张宽表挤掉其他全部表
+    bool ok = false;
+    QJsonObject header;
+    ResultStore page = ResultStore::fromResponse(data, &header, &ok);
+    if (ok && header["status"].toInt() == 0 && data.size() <= byteBudget / 2) {
+        invalidate(table);
+        Entry entry;
+        entry.page = page;
+        entry.bytes = data.size();
+        entry.age.start();
+        entry.lastUse = ++useCounter;
+        cache.insert(table, entry);
+        cachedBytes += entry.bytes;
+        evict();
+        if (cache.contains(table)) {
+            emit pageReady(table);
+        }
+    }
+    sendNext();
+}
+
+void TablePrefetcher::evict()
+{
+    while (cachedBytes > byteBudget && !cache.isEmpty()) {
+        auto oldest = cache.begin();
+        for (auto it = cache.begin(); it != cache.end(); ++it) {
+            if (it->lastUse < oldest->lastUse) {
+                oldest = it;
+            }
+        }
+        cachedBytes -= oldest->bytes;
+        cache.erase(oldest);
+    }
+}
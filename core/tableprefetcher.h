@@ -0,0 +1,82 @@
+#ifndef TABLEPREFETCHER_H
+#define TABLEPREFETCHER_H
+
+#include <QObject>
+#include <QMap>
+#include <QQueue>
+#include <QStringList>
+#include <QElapsedTimer>
+#include "resultstore.h"
+#include "sqlprocesshandler.h"
+
+/**
+ * @brief 相邻表首屏的低优先级预取
+ * 在界面空闲时按顺序读取可能接下来打开的表的前若干行，同时只有一条预取在途，
+ * 结果按原始响应大小计入字节预算，超出时淘汰最久未用的。打开表时先显示已预取的首屏，
+ * 完整数据到达后替换；用户转向其他表时，与之无关的在途预取被取消。
+ */
+class TablePrefetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TablePrefetcher(SqlProcessHandler* handler, QObject *parent = nullptr);
+
+    /**
+     * @brief 每张表预取的行数与全部预取结果的字节预算
+     */
+    void setPageRows(int rows) { pageRows = qMax(1, rows); }
+    void setByteBudget(qint64 bytes) { byteBudget = bytes; }
+
+    /**
+     * @brief 按顺序预取这些表，替换尚未开始的预取；已缓存的表跳过
+     */
+    void prefetch(const QStringList& tables);
+
+    /**
+     * @brief 取消与该表无关的预取(包括在途的一条)
+     */
+    void cancelExcept(const QString& table);
+
+    /**
+     * @brief 取出已预取的首屏，没有或已过期时返回false
+     */
+    bool cachedPage(const QString& table, ResultStore* page);
+
+    /**
+     * @brief 表的数据已变化，丢弃其缓存
+     */
+    void invalidate(const QString& table);
+
+signals:
+    void pageReady(const QString& table);
+
+private slots:
+    void onResponseReceived(quint64 requestId, const QByteArray& data);
+
+private:
+    // 一张表已预取的首屏
+    struct Entry {
+        ResultStore page;
+        qint64 bytes = 0;
+        QElapsedTimer age;      // 预取后经过的时间，过久的不再使用
+        quint64 lastUse = 0;    // 最近使用的序号，淘汰最小的
+    };
+
+    static const int maxAgeMs = 60000;
+
+    SqlProcessHandler* sqlHandler;
+    int pageRows;
+    qint64 byteBudget;
+    qint64 cachedBytes;
+    quint64 useCounter;
+    QMap<QString, Entry> cache;
+    QQueue<QString> queue;
+    quint64 inFlightId;
+    QString inFlightTable;
+
+    void sendNext();
+    void evict();
+};
+
+#endif // TABLEPREFETCHER_H
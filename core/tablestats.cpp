@@ -0,0 +1,411 @@
+#include "tablestats.h"
+#include "indexadvisor.h"
+#include "tabledata.h"
+#include <QtConcurrent>
+#include <QRandomGenerator>
+#include <QJsonArray>
+#include <QHash>
+#include <QSet>
+#include <QtMath>
+#include <algorithm>
+
+namespace {
+
+// 统计表中以空格分隔的整数列表的第一个
+qint64 firstNumber(const QString& text)
+{
+    return text.section(' ', 0, 0, QString::SectionSkipEmpty).toLongLong();
+}
+
+// 按数值或文本比较两个单元格
+bool lessThan(const QString& a, const QString& b, bool numeric)
+{
+    if (numeric) {
+        bool okA = false;
+        bool okB = false;
+        double x = a.toDouble(&okA);
+        double y = b.toDouble(&okB);
+        if (okA && okB) {
+            return x < y;
+        }
+    }
+    return a < b;
+}
+
+} // namespace
+
+TableStatsCollector::TableStatsCollector(SqlProcessHandler* handler, SchemaCache* schema, QObject *parent)
+    : QObject(parent), sqlHandler(handler), schemaCache(schema), sampleSize(2000), topK(10),
+      running(false), sampleFullScan(false), probedRowids(0), rowidSpan(-1), statRows(-1)
+{
+    watcher = new QFutureWatcher<TableStats>(this);
+    connect(watcher, &QFutureWatcher<TableStats>::finished, this, &TableStatsCollector::onComputed);
+    connect(sqlHandler, &SqlProcessHandler::responseReceived,
+            this, &TableStatsCollector::onResponseReceived);
+}
+
+TableStatsCollector::~TableStatsCollector()
+{
+    // 面板关闭时不再需要尚未返回的查询
+    cancel();
+}
+
+void TableStatsCollector::start(const QString& table)
+{
+    cancel();
+    this->table = table;
+    sample = ResultStore();
+    sampleFullScan = false;
+    probedRowids = 0;
+    rowidSpan = -1;
+    statRows = -1;
+    statSource.clear();
+    indexDistinct.clear();
+    indexRanges.clear();
+    running = true;
+
+    const QString quoted = IndexAdvisor::quoteIdentifier(table);
+    emit progress("读取统计信息与rowid范围...");
+
+    send(Step::StatTables, "SELECT name FROM sqlite_master WHERE type = 'table' "
+                           "AND name IN ('sqlite_stat1', 'sqlite_stat4');");
+    // 两个子查询各自只读B树的一端，合在一个聚合里则会扫描全表
+    send(Step::RowidRange, QString("SELECT (SELECT min(rowid) FROM %1) AS lo, (SELECT max(rowid) FROM %1) AS hi;")
+                               .arg(quoted));
+
+    // 索引首列的两端值同样可以直接读取
+    if (schemaCache && schemaCache->isLoaded() && schemaCache->hasTable(table)) {
+        QSet<QString> requested;
+        for (const IndexInfo& index : schemaCache->table(table).indexes) {
+            if (index.columns.isEmpty() || requested.contains(index.columns.first().toLower())) {
+                continue;
+            }
+            const QString column = index.columns.first();
+            requested.insert(column.toLower());
+            const QString quotedColumn = IndexAdvisor::quoteIdentifier(column);
+            send(Step::IndexRange, QString("SELECT (SELECT min(%1) FROM %2) AS lo, (SELECT max(%1) FROM %2) AS hi;")
+                                       .arg(quotedColumn, quoted), column);
+        }
+    }
+}
+
+void TableStatsCollector::cancel()
+{
+    for (auto it = pending.constBegin(); it != pending.constEnd(); ++it) {
+        sqlHandler->cancelRequest(it.key());
+    }
+    pending.clear();
+    running = false;
+}
+
+quint64 TableStatsCollector::send(Step step, const QString& sql, const QString& column)
+{
+    Pending request;
+    request.step = step;
+    request.column = column;
+    quint64 id = sqlHandler->execSql(sql);
+    pending[id] = request;
+    return id;
+}
+
+void TableStatsCollector::sendSample(qint64 low, qint64 high)
+{
+    const QString quoted = IndexAdvisor::quoteIdentifier(table);
+    rowidSpan = high - low + 1;
+
+    // rowid范围不超过样本大小时整表也不超过样本大小，直接全部读取
+    if (rowidSpan <= sampleSize) {
+        sampleFullScan = true;
+        send(Step::Sample, QString("SELECT * FROM %1;").arg(quoted));
+        return;
+    }
+
+    // 在范围内随机取不重复的rowid，删除留下的空洞使实际命中少于抽取数
+    QSet<qint64> rowids;
+    QRandomGenerator* random = QRandomGenerator::global();
+    while (rowids.size() < sampleSize) {
+        rowids.insert(low + qint64(random->generate64() % quint64(rowidSpan)));
+    }
+    QStringList list;
+    list.reserve(rowids.size());
+    for (qint64 rowid : rowids) {
+        list << QString::number(rowid);
+    }
+    probedRowids = rowids.size();
+    send(Step::Sample, QString("SELECT * FROM %1 WHERE rowid IN (%2);").arg(quoted, list.join(',')));
+}
+
+void TableStatsCollector::onResponseReceived(quint64 requestId, const QByteArray& data)
+{
+    if (!pending.contains(requestId)) {
+        return;
+    }
+    Pending request = pending.take(requestId);
+
+    bool ok = false;
+    QJsonObject jsonObj;
+    if (request.step == Step::Sample) {
+        sample = ResultStore::fromResponse(data, &jsonObj, &ok);
+    } else {
+        jsonObj = TableData::parseResponse(data, &ok);
+    }
+    const bool success = ok && jsonObj["status"].toInt() == 0;
+    const QJsonArray rows = jsonObj["rows"].toArray();
+    const QString quoted = IndexAdvisor::quoteIdentifier(table);
+
+    switch (request.step) {
+    case Step::StatTables:
+        for (const auto& row : rows) {
+            QString name = TableData::cellText(row.toObject()["name"]);
+            if (name == "sqlite_stat1") {
+                send(Step::Stat1, QString("SELECT idx, stat FROM sqlite_stat1 WHERE tbl = %1;").arg(TableData::sqlLiteral(table)));
+            } else if (name == "sqlite_stat4") {
+                send(Step::Stat4, QString("SELECT idx, neq, nlt, ndlt FROM sqlite_stat4 WHERE tbl = %1;")
+                                      .arg(TableData::sqlLiteral(table)));
+            }
+        }
+        break;
+
+    case Step::RowidRange:
+        if (!success) {
+            // WITHOUT ROWID表或视图没有rowid，只能取前若干行
+            emit progress("没有rowid，改为读取前若干行...");
+            send(Step::Sample, QString("SELECT * FROM %1 LIMIT %2;").arg(quoted).arg(sampleSize));
+        } else {
+            QJsonObject range = rows.isEmpty() ? QJsonObject() : rows.first().toObject();
+            QString low = TableData::cellText(range["lo"]);
+            QString high = TableData::cellText(range["hi"]);
+            emit progress("抽样读取...");
+            if (low.isEmpty() || high.isEmpty()) {
+                // 空表，仍然读取一次以取得列名
+                sampleFullScan = true;
+                rowidSpan = 0;
+                send(Step::Sample, QString("SELECT * FROM %1 LIMIT 0;").arg(quoted));
+            } else {
+                sendSample(low.toLongLong(), high.toLongLong());
+            }
+        }
+        break;
+
+    case Step::Stat1:
+        if (success) {
+            applyStat1(rows);
+        }
+        break;
+
+    case Step::Stat4:
+        if (success) {
+            applyStat4(rows);
+        }
+        break;
+
+    case Step::IndexRange:
+        if (success && !rows.isEmpty()) {
+            QJsonObject range = rows.first().toObject();
+            indexRanges[request.column.toLower()] = qMakePair(TableData::cellText(range["lo"]), TableData::cellText(range["hi"]));
+        }
+        break;
+
+    case Step::Sample:
+        if (!success) {
+            QString msg = ok ? jsonObj["msg"].toString() : "返回数据格式错误";
+            cancel();
+            emit failed(msg);
+            return;
+        }
+        break;
+    }
+
+    finishIfDone();
+}
+
+QString TableStatsCollector::leadingColumn(const QString& index) const
+{
+    if (!schemaCache || !schemaCache->isLoaded() || !schemaCache->hasTable(table)) {
+        return QString();
+    }
+    for (const IndexInfo& info : schemaCache->table(table).indexes) {
+        if (info.name == index && !info.columns.isEmpty()) {
+            return info.columns.first();
+        }
+    }
+    return QString();
+}
+
+void TableStatsCollector::applyStat1(const QJsonArray& rows)
+{
+    // stat形如"N a b ..."：N为行数，a为索引首列每个值平均对应的行数
+    for (const auto& value : rows) {
+        QJsonObject row = value.toObject();
+        QStringList numbers = TableData::cellText(row["stat"]).split(' ', QString::SkipEmptyParts);
+        if (numbers.isEmpty()) {
+            continue;
+        }
+        qint64 total = numbers[0].toLongLong();
+        statRows = qMax(statRows, total);
+        statSource = "sqlite_stat1";
+
+        QString column = leadingColumn(TableData::cellText(row["idx"]));
+        qint64 perValue = numbers.value(1).toLongLong();
+        if (!column.isEmpty() && perValue > 0) {
+            indexDistinct[column.toLower()] = qMax<qint64>(1, (total + perValue - 1) / perValue);
+        }
+    }
+}
+
+void TableStatsCollector::applyStat4(const QJsonArray& rows)
+{
+    // 每个样本给出小于它的行数(nlt)、等于它的行数(neq)和小于它的不同值个数(ndlt)，
+    // 取最后一个样本即可得到行数与不同值个数的下界；sqlite_stat1已给出的不再覆盖
+    QMap<QString, qint64> distinct;
+    qint64 total = -1;
+    for (const auto& value : rows) {
+        QJsonObject row = value.toObject();
+        total = qMax(total, firstNumber(TableData::cellText(row["nlt"])) + firstNumber(TableData::cellText(row["neq"])));
+        QString column = leadingColumn(TableData::cellText(row["idx"])).toLower();
+        if (!column.isEmpty()) {
+            distinct[column] = qMax(distinct.value(column), firstNumber(TableData::cellText(row["ndlt"])) + 1);
+        }
+    }
+    if (statRows < 0 && total >= 0) {
+        statRows = total;
+        statSource = "sqlite_stat4";
+    }
+    for (auto it = distinct.constBegin(); it != distinct.constEnd(); ++it) {
+        if (!indexDistinct.contains(it.key())) {
+            indexDistinct[it.key()] = it.value();
+        }
+    }
+}
+
+void TableStatsCollector::finishIfDone()
+{
+    if (!running || !pending.isEmpty()) {
+        return;
+    }
+
+    qint64 rowCount = -1;
+    QString source;
+    if (sampleFullScan) {
+        rowCount = sample.rowCount();
+        source = "全表";
+    } else if (statRows >= 0) {
+        rowCount = statRows;
+        source = statSource + "(ANALYZE时的统计)";
+    } else if (probedRowids > 0) {
+        // rowid范围乘以随机rowid的命中率
+        rowCount = qRound64(double(rowidSpan) * sample.rowCount() / probedRowids);
+        source = "按rowid命中率估算";
+    } else {
+        source = "未知(样本为前若干行)";
+    }
+
+    emit progress("计算统计...");
+    const QString table = this->table;
+    const ResultStore sample = this->sample;
+    const int topK = this->topK;
+    const bool fullScan = sampleFullScan;
+    const QMap<QString, qint64> distinct = indexDistinct;
+    const QMap<QString, QPair<QString, QString>> ranges = indexRanges;
+    watcher->setFuture(QtConcurrent::run([=]() {
+        return compute(table, sample, topK, rowCount, source, fullScan, distinct, ranges);
+    }));
+}
+
+void TableStatsCollector::onComputed()
+{
+    if (!running) {
+        return;
+    }
+    running = false;
+    emit finished(watcher->result());
+}
+
+TableStats TableStatsCollector::compute(const QString& table, const ResultStore& sample, int topK,
+                                        qint64 rowCount, const QString& rowCountSource, bool fullScan,
+                                        const QMap<QString, qint64>& indexDistinct,
+                                        const QMap<QString, QPair<QString, QString>>& indexRanges)
+{
+    TableStats stats;
+    stats.table = table;
+    stats.rowCount = rowCount;
+    stats.rowCountSource = rowCountSource;
+    stats.sampleRows = sample.rowCount();
+    stats.fullScan = fullScan;
+
+    const int n = sample.rowCount();
+    for (int column = 0; column < sample.columnCount(); ++column) {
+        ColumnStats columnStats;
+        columnStats.name = sample.columnNames().at(column);
+        columnStats.type = sample.columnType(column);
+        const bool numeric = sample.isNumericColumn(column);
+
+        QHash<QString, int> counts;
+        int nulls = 0;
+        for (int row = 0; row < n; ++row) {
+            const QString value = sample.value(row, column);
+            if (value.isEmpty()) {
+                ++nulls;
+                continue;
+            }
+            int& count = counts[value];
+            if (++count > 1) {
+                continue;   // 已比较过的值
+            }
+            if (counts.size() == 1 || lessThan(value, columnStats.min, numeric)) {
+                columnStats.min = value;
+            }
+            if (counts.size() == 1 || lessThan(columnStats.max, value, numeric)) {
+                columnStats.max = value;
+            }
+        }
+        columnStats.nullFraction = n > 0 ? double(nulls) / n : 0;
+
+        // 不同值：样本即全表时为精确值，否则用Haas-Stokes的Duj1估算
+        // D = n*d / (n - f1 + f1*n/N)，f1为样本中只出现一次的值的个数
+        const qint64 d = counts.size();
+        const qint64 nonNull = n - nulls;
+        qint64 estimate = d;
+        if (!fullScan && rowCount > 0 && nonNull > 0) {
+            const double total = qMax<double>(nonNull, rowCount * (1.0 - columnStats.nullFraction));
+            qint64 f1 = 0;
+            for (auto it = counts.constBegin(); it != counts.constEnd(); ++it) {
+                if (it.value() == 1) {
+                    ++f1;
+                }
+            }
+            const double denominator = nonNull - f1 + f1 * double(nonNull) / total;
+            estimate = denominator > 0 ? qRound64(nonNull * double(d) / denominator) : qint64(total);
+            estimate = qBound<qint64>(d, estimate, qint64(total));
+        }
+        columnStats.distinct = estimate;
+
+        const QString key = columnStats.name.toLower();
+        if (!fullScan && indexDistinct.contains(key)) {
+            columnStats.distinct = indexDistinct.value(key);
+            columnStats.distinctFromIndex = true;
+        }
+        if (indexRanges.contains(key)) {
+            columnStats.min = indexRanges.value(key).first;
+            columnStats.max = indexRanges.value(key).second;
+            columnStats.rangeFromIndex = true;
+        }
+
+        // 高频值：按次数降序，次数相同时按值排序保证结果稳定
+        QVector<QPair<QString, int>> values;
+        values.reserve(counts.size());
+        for (auto it = counts.constBegin(); it != counts.constEnd(); ++it) {
+            values << qMakePair(it.key(), it.value());
+        }
+        const int keep = qMin(topK, values.size());
+        std::partial_sort(values.begin(), values.begin() + keep, values.end(),
+                          [](const QPair<QString, int>& a, const QPair<QString, int>& b) {
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        });
+        values.resize(keep);
+        columnStats.topValues = values;
+
+        stats.columns << columnStats;
+    }
+    return stats;
+}
@@ -0,0 +1,114 @@
+#ifndef TABLESTATS_H
+#define TABLESTATS_H
+
+#include <QObject>
+#include <QMap>
+#include <QPair>
+#include <QVector>
+#include <QStringList>
+#include <QFutureWatcher>
+#include "resultstore.h"
+#include "schemacache.h"
+#include "sqlprocesshandler.h"
+
+// 一列的抽样统计
+struct ColumnStats {
+    QString name;
+    QString type;
+    double nullFraction = 0;        // NULL或空串所占比例(样本)
+    qint64 distinct = 0;            // 不同值个数估算
+    bool distinctFromIndex = false; // 不同值来自sqlite_stat1/stat4，否则由样本估算
+    QString min;
+    QString max;
+    bool rangeFromIndex = false;    // 最小/最大值经索引精确读取，否则来自样本
+    QVector<QPair<QString, int>> topValues;     // 样本中出现最多的值及次数，按次数降序
+};
+
+// 一张表的抽样统计
+struct TableStats {
+    QString table;
+    qint64 rowCount = -1;           // 估算行数，-1表示未知
+    QString rowCountSource;         // 行数的来源说明
+    int sampleRows = 0;             // 实际抽到的行数
+    bool fullScan = false;          // 表足够小，样本即全表
+    QVector<ColumnStats> columns;
+};
+
+/**
+ * @brief 不扫描全表的列统计
+ * 按rowid范围随机抽取有限行(WHERE rowid IN (...)，每行一次B树查找)，在线程池中计算空值比例、
+ * 不同值估算、最小/最大值和高频值。存在sqlite_stat1/sqlite_stat4时行数和索引首列的不同值取自其中，
+ * 有索引的列用子查询min()/max()经索引直接读取两端的值。
+ */
+class TableStatsCollector : public QObject
+{
+    Q_OBJECT
+
+public:
+    TableStatsCollector(SqlProcessHandler* handler, SchemaCache* schema, QObject *parent = nullptr);
+    ~TableStatsCollector();
+
+    /**
+     * @brief 抽样行数上限与每列保留的高频值个数
+     */
+    void setSampleSize(int rows) { sampleSize = qMax(1, rows); }
+    void setTopK(int k) { topK = qMax(1, k); }
+
+    /**
+     * @brief 开始统计一张表，进行中的统计被放弃
+     */
+    void start(const QString& table);
+    void cancel();
+    bool isRunning() const { return running; }
+
+signals:
+    void progress(const QString& step);
+    void finished(const TableStats& stats);
+    void failed(const QString& msg);
+
+private slots:
+    void onResponseReceived(quint64 requestId, const QByteArray& data);
+    void onComputed();
+
+private:
+    enum class Step { StatTables, RowidRange, Stat1, Stat4, Sample, IndexRange };
+
+    // 已发出的请求
+    struct Pending {
+        Step step;
+        QString column;     // IndexRange对应的列
+    };
+
+    SqlProcessHandler* sqlHandler;
+    SchemaCache* schemaCache;
+    QFutureWatcher<TableStats>* watcher;
+    QMap<quint64, Pending> pending;
+    int sampleSize;
+    int topK;
+    bool running;
+
+    // 当前统计的中间结果
+    QString table;
+    ResultStore sample;
+    bool sampleFullScan;
+    qint64 probedRowids;            // 随机抽取的rowid个数，用于按命中率估算行数
+    qint64 rowidSpan;
+    qint64 statRows;                // 来自sqlite_stat1/stat4的行数，-1表示没有
+    QString statSource;
+    QMap<QString, qint64> indexDistinct;            // 小写列名 -> 统计表给出的不同值个数
+    QMap<QString, QPair<QString, QString>> indexRanges; // 小写列名 -> 经索引读取的最小/最大值
+
+    quint64 send(Step step, const QString& sql, const QString& column = QString());
+    void sendSample(qint64 low, qint64 high);
+    void applyStat1(const QJsonArray& rows);
+    void applyStat4(const QJsonArray& rows);
+    QString leadingColumn(const QString& index) const;
+    void finishIfDone();
+
+    static TableStats compute(const QString& table, const ResultStore& sample, int topK,
+                              qint64 rowCount, const QString& rowCountSource, bool fullScan,
+                              const QMap<QString, qint64>& indexDistinct,
+                              const QMap<QString, QPair<QString, QString>>& indexRanges);
+};
+
+#endif // TABLESTATS_H
@@ -1,15 +0,0 @@
-#ifndef FUNCID_H
-#define FUNCID_H
-#include <iostream>
-#include <QObject>
-
-//app应用信息
-const int APPID = 10086;
-const QString APPKEY = "test";
-
-//TCP指令功能号
-const QString CONNECT_DATABASE = "100000";
-//执行sql
-const QString EXEC_SQL = "100001";
-
-#endif // FUNCID_H
@@ -0,0 +1,107 @@
+#include "impairedlink.h"
+
+ImpairedLink::ImpairedLink(QTcpSocket* from, QTcpSocket* to, const ImpairmentProfile& profile, quint32 seed,
+                           QObject *parent)
+    : QObject(parent), from(from), to(to), profile(profile), random(seed),
+      lastDue(0), sinceStall(0), forwarded(0), sourceClosed(false)
+{
+    clock.start();
+    timer = new QTimer(this);
+    timer->setSingleShot(true);
+    timer->setTimerType(Qt::PreciseTimer);
+    connect(timer, &QTimer::timeout, this, &ImpairedLink::flushDue);
+    connect(from, &QTcpSocket::readyRead, this, &ImpairedLink::onReadyRead);
+
+    // 切段时关闭Nagle，让每一小段作为单独的TCP段发出
+    if (profile.splitBytes > 0) {
+        to->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+    }
+}
+
+void ImpairedLink::onReadyRead()
+{
+    const QByteArray data = from->readAll();
+    if (data.isEmpty()) {
+        return;
+    }
+    const double now = clock.nsecsElapsed() / 1e6;
+    if (profile.splitBytes <= 0) {
+        enqueue(data, now);
+    } else {
+        std::uniform_int_distribution<int> size(1, profile.splitBytes);
+        for (int pos = 0; pos < data.size();) {
+            int length = qMin(size(random), data.size() - pos);
+            enqueue(data.mid(pos, length), now);
+            pos += length;
+        }
+    }
+    schedule();
+}
+
+void ImpairedLink::enqueue(const QByteArray& data, double now)
+{
+    double due = now + profile.latencyMs;
+    if (profile.jitterMs > 0) {
+        due += std::uniform_int_distribution<int>(0, profile.jitterMs)(random);
+    }
+    // 限速：每段至少在上一段之后再经过其发送耗时才到期
+    double earliest = lastDue;
+    if (profile.bandwidthKBps > 0) {
+        earliest += data.size() * 1000.0 / (profile.bandwidthKBps * 1024.0);
+    }
+    due = qMax(due, earliest);
+
+    sinceStall += data.size();
+    if (profile.stallEveryKB > 0 && sinceStall >= qint64(profile.stallEveryKB) * 1024) {
+        due += profile.stallMs;
+        sinceStall = 0;
+    }
+    lastDue = due;
+    queue.enqueue({due, data});
+}
+
+void ImpairedLink::schedule()
+{
+    if (queue.isEmpty()) {
+        if (sourceClosed) {
+            emit drained();
+        }
+        return;
+    }
+    if (timer->isActive()) {
+        return;
+    }
+    // 有合并窗口时等队首到期后再多等一个窗口，期间到期的段合成一次写出
+    const double now = clock.nsecsElapsed() / 1e6;
+    const double wait = queue.head().due + profile.mergeMs - now;
+    timer->start(qMax(0, int(wait + 0.5)));
+}
+
+void ImpairedLink::flushDue()
+{
+    const double now = clock.nsecsElapsed() / 1e6;
+    QByteArray merged;
+    while (!queue.isEmpty() && queue.head().due <= now) {
+        Segment segment = queue.dequeue();
+        forwarded += segment.data.size();
+        if (profile.mergeMs > 0) {
+            merged.append(segment.data);
+        } else {
+            to->write(segment.data);
+            to->flush();
+        }
+    }
+    if (!merged.isEmpty()) {
+        to->write(merged);
+        to->flush();
+    }
+    schedule();
+}
+
+void ImpairedLink::onSourceClosed()
+{
+    // 先读出残留数据，排队的数据照常按时写出
+    onReadyRead();
+    sourceClosed = true;
+    schedule();
+}
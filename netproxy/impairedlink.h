@@ -0,0 +1,63 @@
+#ifndef IMPAIREDLINK_H
+#define IMPAIREDLINK_H
+
+#include <QObject>
+#include <QTcpSocket>
+#include <QQueue>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <random>
+#include "impairmentprofile.h"
+
+/**
+ * @brief 单方向的损伤转发
+ * 从from读出的数据按损伤参数切段、计算到期时间后排队，到期后写入to。
+ * 到期时间单调不减，抖动和限速只推迟数据，不会打乱字节顺序。
+ */
+class ImpairedLink : public QObject
+{
+    Q_OBJECT
+
+public:
+    ImpairedLink(QTcpSocket* from, QTcpSocket* to, const ImpairmentProfile& profile, quint32 seed,
+                 QObject *parent = nullptr);
+
+    qint64 bytesForwarded() const { return forwarded; }
+    bool isIdle() const { return queue.isEmpty(); }
+
+signals:
+    /**
+     * @brief 对端已关闭且排队的数据全部写出
+     */
+    void drained();
+
+public slots:
+    void onReadyRead();
+    void onSourceClosed();
+
+private slots:
+    void flushDue();
+
+private:
+    struct Segment {
+        double due;         // 到期时间(相对clock的毫秒)
+        QByteArray data;
+    };
+
+    QTcpSocket* from;
+    QTcpSocket* to;
+    ImpairmentProfile profile;
+    std::mt19937 random;
+    QQueue<Segment> queue;
+    QTimer* timer;
+    QElapsedTimer clock;
+    double lastDue;         // 上一段的到期时间
+    qint64 sinceStall;      // 距上次停顿转发的字节数
+    qint64 forwarded;
+    bool sourceClosed;
+
+    void enqueue(const QByteArray& data, double now);
+    void schedule();
+};
+
+#endif // IMPAIREDLINK_H
@@ -0,0 +1,131 @@
+#include "impairmentprofile.h"
+
+namespace {
+
+bool preset(const QString& name, ImpairmentProfile* profile)
+{
+    ImpairmentProfile result;
+    result.name = name;
+    if (name == "lan") {
+        result.latencyMs = 1;
+    } else if (name == "wifi") {
+        result.latencyMs = 5;
+        result.jitterMs = 15;
+        result.bandwidthKBps = 4096;
+        result.splitBytes = 1460;
+    } else if (name == "4g") {
+        result.latencyMs = 40;
+        result.jitterMs = 40;
+        result.bandwidthKBps = 1024;
+        result.splitBytes = 1400;
+        result.mergeMs = 10;
+    } else if (name == "satellite") {
+        result.latencyMs = 300;
+        result.jitterMs = 50;
+        result.bandwidthKBps = 256;
+        result.mergeMs = 40;
+    } else if (name == "flaky") {
+        result.latencyMs = 20;
+        result.jitterMs = 80;
+        result.bandwidthKBps = 512;
+        result.splitBytes = 7;
+        result.stallEveryKB = 64;
+        result.stallMs = 1500;
+    } else {
+        return false;
+    }
+    *profile = result;
+    return true;
+}
+
+} // namespace
+
+QStringList ImpairmentProfile::presetNames()
+{
+    return {"lan", "wifi", "4g", "satellite", "flaky"};
+}
+
+bool ImpairmentProfile::parse(const QString& spec, ImpairmentProfile* profile, QString* error)
+{
+    auto fail = [error](const QString& reason) {
+        if (error) {
+            *error = reason;
+        }
+        return false;
+    };
+
+    ImpairmentProfile result;
+    result.name = spec.trimmed();
+    const QStringList parts = spec.split(',', QString::SkipEmptyParts);
+    for (int i = 0; i < parts.size(); ++i) {
+        const QString part = parts[i].trimmed();
+        int eq = part.indexOf('=');
+        if (eq < 0) {
+            // 只有第一项可以是预置名称
+            if (i != 0 || !preset(part, &result)) {
+                return fail("未知的损伤预置：" + part);
+            }
+            result.name = spec.trimmed();
+            continue;
+        }
+
+        const QString key = part.left(eq).trimmed();
+        const QString value = part.mid(eq + 1).trimmed();
+        bool ok = false;
+        if (key == "stall") {
+            // stall=每隔KB/停顿毫秒
+            const QStringList fields = value.split('/');
+            bool everyOk = false;
+            result.stallEveryKB = fields.value(0).toInt(&everyOk);
+            result.stallMs = fields.value(1).toInt(&ok);
+            ok = ok && everyOk && fields.size() == 2;
+        } else {
+            int number = value.toInt(&ok);
+            if (key == "latency") {
+                result.latencyMs = number;
+            } else if (key == "jitter") {
+                result.jitterMs = number;
+            } else if (key == "bw") {
+                result.bandwidthKBps = number;
+            } else if (key == "split") {
+                result.splitBytes = number;
+            } else if (key == "merge") {
+                result.mergeMs = number;
+            } else {
+                return fail("未知的损伤参数：" + key);
+            }
+        }
+        if (!ok) {
+            return fail("参数值无效：" + part);
+        }
+    }
+
+    if (result.latencyMs < 0 || result.jitterMs < 0 || result.bandwidthKBps < 0 || result.splitBytes < 0
+            || result.mergeMs < 0 || result.stallEveryKB < 0 || result.stallMs < 0) {
+        return fail("参数值不能为负：" + spec);
+    }
+    *profile = result;
+    return true;
+}
+
+QString ImpairmentProfile::describe() const
+{
+    QStringList parts;
+    parts << QString("latency=%1").arg(latencyMs);
+    if (jitterMs > 0) {
+        parts << QString("jitter=%1").arg(jitterMs);
+    }
+    if (bandwidthKBps > 0) {
+        parts << QString("bw=%1").arg(bandwidthKBps);
+    }
+    if (splitBytes > 0) {
+        parts << QString("split=%1").arg(splitBytes);
+    }
+    if (mergeMs > 0) {
+        parts << QString("merge=%1").arg(mergeMs);
+    }
+    if (stallEveryKB > 0 && stallMs > 0) {
+        parts << QString("stall=%1/%2").arg(stallEveryKB).arg(stallMs);
+    }
+    return parts.join(',');
+}
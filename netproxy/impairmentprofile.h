@@ -0,0 +1,34 @@
+#ifndef IMPAIRMENTPROFILE_H
+#define IMPAIRMENTPROFILE_H
+
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief 一个方向上的网络损伤参数
+ * 可以是预置名称(lan、wifi、4g、satellite、flaky)，也可以是逗号分隔的键值，
+ * 以预置名称开头时在其基础上修改，例如 "4g,latency=120,split=7"
+ */
+struct ImpairmentProfile {
+    QString name;
+    int latencyMs = 0;      // 固定单向延迟
+    int jitterMs = 0;       // 叠加在延迟上的随机抖动[0, jitterMs]，不打乱字节顺序
+    int bandwidthKBps = 0;  // 带宽上限(KB/s)，0表示不限
+    int splitBytes = 0;     // 把数据切成1..splitBytes字节的小段分别写出，0表示不切分
+    int mergeMs = 0;        // 合并窗口，窗口内到期的数据合成一次写出
+    int stallEveryKB = 0;   // 每转发这么多KB停顿一次，0表示不停顿
+    int stallMs = 0;        // 每次停顿的时长
+
+    /**
+     * @brief 解析损伤参数，失败时返回false并输出原因
+     */
+    static bool parse(const QString& spec, ImpairmentProfile* profile, QString* error = nullptr);
+    static QStringList presetNames();
+
+    /**
+     * @brief 单行的参数描述，用于日志与报告
+     */
+    QString describe() const;
+};
+
+#endif // IMPAIRMENTPROFILE_H
@@ -0,0 +1,73 @@
+#include "impairmentproxy.h"
+#include "impairedlink.h"
+
+ImpairmentProxy::ImpairmentProxy(const QString& upstreamHost, quint16 upstreamPort,
+                                 const ImpairmentProfile& profile, QObject *parent)
+    : QObject(parent), upstreamHost(upstreamHost), upstreamPort(upstreamPort), profile(profile),
+      seed(1), nextId(1)
+{
+    server = new QTcpServer(this);
+    connect(server, &QTcpServer::newConnection, this, &ImpairmentProxy::onNewConnection);
+}
+
+bool ImpairmentProxy::listen(const QHostAddress& address, quint16 port, QString* error)
+{
+    if (!server->listen(address, port)) {
+        if (error) {
+            *error = server->errorString();
+        }
+        return false;
+    }
+    return true;
+}
+
+void ImpairmentProxy::onNewConnection()
+{
+    while (QTcpSocket* client = server->nextPendingConnection()) {
+        const int id = nextId++;
+        emit connectionOpened(id, QString("%1:%2").arg(client->peerAddress().toString()).arg(client->peerPort()));
+
+        // 上游连上之前客户端发来的数据留在客户端socket的缓冲里
+        QTcpSocket* upstream = new QTcpSocket(client);
+        connect(upstream, &QTcpSocket::connected, this, [this, id, client, upstream]() {
+            startForwarding(id, client, upstream);
+        });
+        connect(upstream, static_cast<void(QAbstractSocket::*)(QAbstractSocket::SocketError)>(&QAbstractSocket::error),
+                client, [this, id, client, upstream]() {
+            if (upstream->state() != QAbstractSocket::ConnectedState) {
+                // 连不上上游时直接断开客户端
+                emit connectionClosed(id, 0, 0);
+                client->disconnectFromHost();
+                client->deleteLater();
+            }
+        });
+        upstream->connectToHost(upstreamHost, upstreamPort);
+    }
+}
+
+void ImpairmentProxy::startForwarding(int id, QTcpSocket* client, QTcpSocket* upstream)
+{
+    ImpairedLink* up = new ImpairedLink(client, upstream, profile, seed + quint32(id) * 2, client);
+    ImpairedLink* down = new ImpairedLink(upstream, client, profile, seed + quint32(id) * 2 + 1, client);
+
+    // 一端关闭后把已排队的数据送完再关闭另一端，两端都关闭后释放
+    connect(client, &QTcpSocket::disconnected, up, &ImpairedLink::onSourceClosed);
+    connect(upstream, &QTcpSocket::disconnected, down, &ImpairedLink::onSourceClosed);
+    connect(up, &ImpairedLink::drained, upstream, &QTcpSocket::disconnectFromHost);
+    connect(down, &ImpairedLink::drained, client, &QTcpSocket::disconnectFromHost);
+
+    auto finish = [this, id, client, upstream, up, down]() {
+        if (client->state() == QAbstractSocket::UnconnectedState
+                && upstream->state() == QAbstractSocket::UnconnectedState
+                && client->property("closed").isNull()) {
+            client->setProperty("closed", true);
+            emit connectionClosed(id, up->bytesForwarded(), down->bytesForwarded());
+            client->deleteLater();
+        }
+    };
+    connect(client, &QTcpSocket::disconnected, client, finish, Qt::QueuedConnection);
+    connect(upstream, &QTcpSocket::disconnected, upstream, finish, Qt::QueuedConnection);
+
+    // 连上之前已到达的客户端数据
+    up->onReadyRead();
+}
@@ -0,0 +1,48 @@
+#ifndef IMPAIRMENTPROXY_H
+#define IMPAIRMENTPROXY_H
+
+#include <QObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHostAddress>
+#include "impairmentprofile.h"
+
+/**
+ * @brief 本地TCP损伤代理
+ * 每个客户端连接对应一条到上游服务器的连接，两个方向各用一个ImpairedLink按同一组参数转发
+ */
+class ImpairmentProxy : public QObject
+{
+    Q_OBJECT
+
+public:
+    ImpairmentProxy(const QString& upstreamHost, quint16 upstreamPort, const ImpairmentProfile& profile,
+                    QObject *parent = nullptr);
+
+    bool listen(const QHostAddress& address, quint16 port, QString* error = nullptr);
+    quint16 serverPort() const { return server->serverPort(); }
+
+    /**
+     * @brief 设置随机种子，相同种子下切段与抖动可复现
+     */
+    void setSeed(quint32 seed) { this->seed = seed; }
+
+signals:
+    void connectionOpened(int id, const QString& peer);
+    void connectionClosed(int id, qint64 bytesUp, qint64 bytesDown);
+
+private slots:
+    void onNewConnection();
+
+private:
+    QTcpServer* server;
+    QString upstreamHost;
+    quint16 upstreamPort;
+    ImpairmentProfile profile;
+    quint32 seed;
+    int nextId;
+
+    void startForwarding(int id, QTcpSocket* client, QTcpSocket* upstream);
+};
+
+#endif // IMPAIRMENTPROXY_H
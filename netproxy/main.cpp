@@ -0,0 +1,130 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+#include <QDateTime>
+#include "impairmentproxy.h"
+#include "proxybenchmark.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QCoreApplication::setApplicationName("rsqlite-netproxy");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("网络损伤代理：在客户端与服务器之间注入延迟、抖动、限速、切段/合并与停顿");
+    parser.addHelpOption();
+
+    QCommandLineOption upstreamOption({"u", "upstream"}, "上游服务器，格式 ip:port", "host:port");
+    QCommandLineOption listenOption({"l", "listen"}, "代理模式下的本地监听端口", "port");
+    QCommandLineOption bindOption("bind", "代理模式下的监听地址", "ip", "127.0.0.1");
+    QCommandLineOption profileOption({"P", "profile"},
+        "损伤参数，预置名称或 key=value 列表(latency、jitter、bw、split、merge、stall=KB/ms)，"
+        "基准模式下可重复", "spec");
+    QCommandLineOption seedOption("seed", "随机种子，相同种子下切段与抖动可复现", "n", "1");
+    QCommandLineOption listOption("list-profiles", "列出预置的损伤参数");
+    QCommandLineOption benchOption("benchmark", "基准模式：对每种损伤参数测量端到端查询延迟");
+    QCommandLineOption dbOption({"d", "db"}, "基准模式：服务端数据库路径", "dbpath");
+    QCommandLineOption execOption({"e", "execute"}, "基准模式：每轮执行的SQL，可重复", "sql");
+    QCommandLineOption iterationsOption({"n", "iterations"}, "基准模式：每种损伤参数执行的轮数", "n", "20");
+    QCommandLineOption timeoutOption("timeout", "基准模式：连接与每条请求的超时时间(毫秒)", "ms", "30000");
+    QCommandLineOption jsonOption("json", "基准模式：每种损伤参数输出一行JSON");
+    parser.addOptions({upstreamOption, listenOption, bindOption, profileOption, seedOption, listOption,
+                       benchOption, dbOption, execOption, iterationsOption, timeoutOption, jsonOption});
+    parser.process(a);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    out.setCodec("UTF-8");
+    err.setCodec("UTF-8");
+
+    if (parser.isSet(listOption)) {
+        for (const QString& name : ImpairmentProfile::presetNames()) {
+            ImpairmentProfile profile;
+            ImpairmentProfile::parse(name, &profile);
+            out << QString("%1 %2\n").arg(name, -10).arg(profile.describe());
+        }
+        return ProxyExitOk;
+    }
+
+    const QString upstream = parser.value(upstreamOption);
+    const int colon = upstream.lastIndexOf(':');
+    const QString host = upstream.left(colon);
+    const quint16 port = static_cast<quint16>(upstream.mid(colon + 1).toUInt());
+    if (colon <= 0 || port == 0) {
+        err << "必须用 --upstream ip:port 指定上游服务器\n";
+        return ProxyExitUsage;
+    }
+
+    // 基准模式未指定损伤参数时测试全部预置
+    QStringList specs = parser.values(profileOption);
+    if (specs.isEmpty()) {
+        specs = parser.isSet(benchOption) ? ImpairmentProfile::presetNames() : QStringList{"lan"};
+    }
+    QList<ImpairmentProfile> profiles;
+    for (const QString& spec : specs) {
+        ImpairmentProfile profile;
+        QString error;
+        if (!ImpairmentProfile::parse(spec, &profile, &error)) {
+            err << error << "\n";
+            return ProxyExitUsage;
+        }
+        profiles << profile;
+    }
+    const quint32 seed = parser.value(seedOption).toUInt();
+
+    if (parser.isSet(benchOption)) {
+        BenchmarkOptions options;
+        options.host = host;
+        options.port = port;
+        options.dbPath = parser.value(dbOption);
+        options.statements = parser.values(execOption);
+        options.profiles = profiles;
+        options.iterations = parser.value(iterationsOption).toInt();
+        options.timeoutMs = parser.value(timeoutOption).toInt();
+        options.seed = seed;
+        options.json = parser.isSet(jsonOption);
+        if (options.dbPath.isEmpty() || options.statements.isEmpty()) {
+            err << "基准模式必须指定 --db 和至少一条 -e\n";
+            return ProxyExitUsage;
+        }
+        if (options.iterations <= 0 || options.timeoutMs <= 0) {
+            err << "轮数与超时时间必须大于0\n";
+            return ProxyExitUsage;
+        }
+        ProxyBenchmark benchmark(options);
+        return benchmark.run();
+    }
+
+    // 代理模式：一直运行，直到进程被结束
+    if (profiles.size() != 1) {
+        err << "代理模式只能指定一个 --profile\n";
+        return ProxyExitUsage;
+    }
+    const quint16 listenPort = static_cast<quint16>(parser.value(listenOption).toUInt());
+    if (listenPort == 0) {
+        err << "代理模式必须用 --listen 指定本地端口\n";
+        return ProxyExitUsage;
+    }
+
+    ImpairmentProxy proxy(host, port, profiles.first());
+    proxy.setSeed(seed);
+    QString error;
+    if (!proxy.listen(QHostAddress(parser.value(bindOption)), listenPort, &error)) {
+        err << "无法监听端口 " << listenPort << "：" << error << "\n";
+        return ProxyExitConnectFailed;
+    }
+    err << QString("%1:%2 -> %3  [%4]\n").arg(parser.value(bindOption)).arg(listenPort)
+           .arg(upstream).arg(profiles.first().describe());
+    err.flush();
+
+    QObject::connect(&proxy, &ImpairmentProxy::connectionOpened, [&err](int id, const QString& peer) {
+        err << QDateTime::currentDateTime().toString("HH:mm:ss.zzz") << " #" << id << " 打开 " << peer << "\n";
+        err.flush();
+    });
+    QObject::connect(&proxy, &ImpairmentProxy::connectionClosed, [&err](int id, qint64 bytesUp, qint64 bytesDown) {
+        err << QDateTime::currentDateTime().toString("HH:mm:ss.zzz") << " #" << id << " 关闭 上行 "
+            << bytesUp << " 字节，下行 " << bytesDown << " 字节\n";
+        err.flush();
+    });
+    return a.exec();
+}
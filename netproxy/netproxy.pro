@@ -0,0 +1,25 @@
+QT       = core network
+
+CONFIG += console c++11
+CONFIG -= app_bundle
+TARGET = rsqlite-netproxy
+
+include(../core/core.pri)
+
+SOURCES += \
+    main.cpp \
+    impairmentprofile.cpp \
+    impairedlink.cpp \
+    impairmentproxy.cpp \
+    proxybenchmark.cpp
+
+HEADERS += \
+    impairmentprofile.h \
+    impairedlink.h \
+    impairmentproxy.h \
+    proxybenchmark.h
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
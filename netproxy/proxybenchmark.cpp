@@ -0,0 +1,209 @@
+#include "proxybenchmark.h"
+#include <QThread>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <algorithm>
+#include "impairmentproxy.h"
+#include "socketmanager.h"
+#include "sqlprocesshandler.h"
+#include "tabledata.h"
+
+ProxyBenchmark::ProxyBenchmark(const BenchmarkOptions& options, QObject *parent)
+    : QObject(parent), options(options), out(stdout), err(stderr)
+{
+    out.setCodec("UTF-8");
+    err.setCodec("UTF-8");
+}
+
+int ProxyBenchmark::run()
+{
+    if (!options.json) {
+        out << QString("%1 %2 %3 %4 %5 %6 %7 %8 %9  %10\n")
+               .arg("profile", -10).arg("connect", 8).arg("ok/total", 10).arg("mismatch", 8)
+               .arg("min", 8).arg("p50", 8).arg("p95", 8).arg("max", 8).arg("mean", 8).arg("params");
+    }
+
+    // 先直连一次，响应作为对照
+    baseline = QVector<QByteArray>(options.statements.size());
+    ProfileResult direct = runProfile(nullptr);
+    report(direct);
+    if (!direct.connected) {
+        return ProxyExitConnectFailed;
+    }
+
+    int exitCode = direct.failed > 0 ? ProxyExitMismatch : ProxyExitOk;
+    for (const ImpairmentProfile& profile : options.profiles) {
+        ProfileResult result = runProfile(&profile);
+        report(result);
+        if (!result.connected) {
+            return ProxyExitConnectFailed;
+        }
+        if (result.failed > 0 || result.mismatched > 0) {
+            exitCode = ProxyExitMismatch;
+        }
+    }
+    return exitCode;
+}
+
+ProxyBenchmark::ProfileResult ProxyBenchmark::runProfile(const ImpairmentProfile* profile)
+{
+    ProfileResult result;
+    result.name = profile ? profile->name : "direct";
+    result.params = profile ? profile->describe() : "-";
+
+    // 代理放在后台线程，主线程下面的阻塞等待不会卡住转发
+    QThread thread;
+    QString host = options.host;
+    quint16 port = options.port;
+    if (profile) {
+        ImpairmentProxy* proxy = new ImpairmentProxy(options.host, options.port, *profile);
+        proxy->setSeed(options.seed);
+        if (!proxy->listen(QHostAddress::LocalHost, 0, &result.error)) {
+            delete proxy;
+            return result;
+        }
+        host = "127.0.0.1";
+        port = proxy->serverPort();
+        proxy->moveToThread(&thread);
+        connect(&thread, &QThread::finished, proxy, &QObject::deleteLater);
+        thread.start();
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QTcpSocket* socket = SocketManager::openConnection(host, port, options.dbPath, options.timeoutMs,
+                                                       nullptr, &result.error);
+    result.connectMs = timer.nsecsElapsed() / 1e6;
+    result.connected = socket != nullptr;
+
+    if (socket) {
+        SocketManager sockets;
+        SqlProcessHandler handler(&sockets);
+        sockets.setSocket(socket);
+        handler.setSocket(socket);
+
+        quint64 waitingId = 0;
+        QByteArray response;
+        bool responseReady = false;
+        connect(&handler, &SqlProcessHandler::responseReceived, this,
+                [&](quint64 requestId, const QByteArray& data) {
+            if (requestId == waitingId) {
+                response = data;
+                responseReady = true;
+            }
+        });
+
+        bool aborted = false;
+        for (int round = 0; round < options.iterations && !aborted; ++round) {
+            for (int i = 0; i < options.statements.size(); ++i) {
+                response.clear();
+                responseReady = false;
+                timer.restart();
+                waitingId = handler.execSql(options.statements[i]);
+
+                // waitForReadyRead会同步触发readyRead，由SqlProcessHandler分帧后回调
+                while (!responseReady) {
+                    int remaining = options.timeoutMs - int(timer.elapsed());
+                    if (remaining <= 0 || !socket->waitForReadyRead(remaining)) {
+                        break;
+                    }
+                }
+                const double latency = timer.nsecsElapsed() / 1e6;
+                if (!responseReady) {
+                    // 超时后连接状态不可知，放弃本组剩余的请求
+                    result.failed += options.statements.size() * (options.iterations - round) - i;
+                    result.error = "等待响应超时";
+                    aborted = true;
+                    break;
+                }
+
+                bool ok = false;
+                TableData::parseResponse(response, &ok);
+                if (!ok) {
+                    ++result.failed;
+                    result.error = "响应无法解析";
+                    continue;
+                }
+                if (baseline[i].isEmpty()) {
+                    if (!profile) {
+                        baseline[i] = response;
+                    }
+                } else if (baseline[i] != response) {
+                    ++result.mismatched;
+                }
+                ++result.ok;
+                result.latencies << latency;
+            }
+        }
+
+        handler.setSocket(nullptr);
+        sockets.closeSocket();
+    }
+
+    if (profile) {
+        thread.quit();
+        thread.wait();
+    }
+    return result;
+}
+
+double ProxyBenchmark::percentile(QVector<double> values, double p)
+{
+    if (values.isEmpty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    int index = qBound(0, int(p * (values.size() - 1) + 0.5), values.size() - 1);
+    return values[index];
+}
+
+void ProxyBenchmark::report(const ProfileResult& result)
+{
+    const int total = result.ok + result.failed;
+    double mean = 0;
+    for (double latency : result.latencies) {
+        mean += latency;
+    }
+    if (!result.latencies.isEmpty()) {
+        mean /= result.latencies.size();
+    }
+
+    if (options.json) {
+        QJsonObject obj;
+        obj["profile"] = result.name;
+        obj["params"] = result.params;
+        obj["connected"] = result.connected;
+        obj["connect_ms"] = result.connectMs;
+        obj["ok"] = result.ok;
+        obj["failed"] = result.failed;
+        obj["mismatched"] = result.mismatched;
+        obj["min_ms"] = percentile(result.latencies, 0);
+        obj["p50_ms"] = percentile(result.latencies, 0.5);
+        obj["p95_ms"] = percentile(result.latencies, 0.95);
+        obj["max_ms"] = percentile(result.latencies, 1);
+        obj["mean_ms"] = mean;
+        if (!result.error.isEmpty()) {
+            obj["error"] = result.error;
+        }
+        out << QString::fromUtf8(QJsonDocument(obj).toJson(QJsonDocument::Compact)) << "\n";
+    } else {
+        out << QString("%1 %2 %3 %4 %5 %6 %7 %8 %9  %10\n")
+               .arg(result.name, -10)
+               .arg(result.connectMs, 8, 'f', 1)
+               .arg(QString("%1/%2").arg(result.ok).arg(total), 10)
+               .arg(result.mismatched, 8)
+               .arg(percentile(result.latencies, 0), 8, 'f', 1)
+               .arg(percentile(result.latencies, 0.5), 8, 'f', 1)
+               .arg(percentile(result.latencies, 0.95), 8, 'f', 1)
+               .arg(percentile(result.latencies, 1), 8, 'f', 1)
+               .arg(mean, 8, 'f', 1)
+               .arg(result.params);
+    }
+    out.flush();
+
+    if (!result.error.isEmpty()) {
+        err << result.name << "：" << result.error << "\n";
+        err.flush();
+    }
+}
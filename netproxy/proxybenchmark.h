@@ -0,0 +1,74 @@
+#ifndef PROXYBENCHMARK_H
+#define PROXYBENCHMARK_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QList>
+#include <QTextStream>
+#include "impairmentprofile.h"
+
+// 损伤代理工具退出码
+enum NetProxyExitCode {
+    ProxyExitOk = 0,            // 正常结束/全部请求成功且与直连结果一致
+    ProxyExitUsage = 1,         // 参数错误
+    ProxyExitConnectFailed = 2, // 无法监听或无法连接服务器
+    ProxyExitMismatch = 4       // 基准测试中有请求失败、超时或响应与直连不一致
+};
+
+// 基准测试参数
+struct BenchmarkOptions {
+    QString host;
+    quint16 port = 0;
+    QString dbPath;
+    QStringList statements;             // 每轮依次执行
+    QList<ImpairmentProfile> profiles;  // 依次测试的损伤参数，之前总会先直连一次作为对照
+    int iterations = 20;                // 每种损伤参数执行的轮数
+    int timeoutMs = 30000;
+    quint32 seed = 1;
+    bool json = false;                  // 每种损伤参数输出一行JSON而不是表格
+};
+
+/**
+ * @brief 在不同网络损伤下测量端到端查询延迟
+ * 每种损伤参数在后台线程启动一个本地代理，经代理完成连接握手并重复执行SQL，
+ * 统计延迟分位数，并把每个响应与直连时的响应逐字节比较，以发现分帧与解码问题
+ */
+class ProxyBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ProxyBenchmark(const BenchmarkOptions& options, QObject *parent = nullptr);
+
+    /**
+     * @brief 执行全部测试并输出报告
+     * @return NetProxyExitCode退出码
+     */
+    int run();
+
+private:
+    struct ProfileResult {
+        QString name;
+        QString params;
+        bool connected = false;
+        double connectMs = 0;
+        int ok = 0;
+        int failed = 0;
+        int mismatched = 0;
+        QVector<double> latencies;  // 成功请求的延迟(毫秒)
+        QString error;
+    };
+
+    BenchmarkOptions options;
+    QTextStream out;
+    QTextStream err;
+    QVector<QByteArray> baseline;   // 直连时每条语句的响应
+
+    ProfileResult runProfile(const ImpairmentProfile* profile);
+    void report(const ProfileResult& result);
+    static double percentile(QVector<double> values, double p);
+};
+
+#endif // PROXYBENCHMARK_H